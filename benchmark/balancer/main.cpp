@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+
+#include <httpcpp/balanced_client.hpp>
+
+namespace po = boost::program_options;
+
+struct Config {
+    std::vector<std::string> endpoints;
+    std::string transport_type = "tcp";
+    std::string policy = "p2c";
+    size_t threads = 4;
+    uint64_t requests = 2000;
+    size_t keys = 64;
+};
+
+bool parse_args(int argc, char* argv[], Config& config) {
+    try {
+        po::options_description desc("Load-Balancing Benchmark Options");
+        desc.add_options()
+            ("help,h", "Show this help message")
+            ("endpoint", po::value<std::vector<std::string>>(&config.endpoints)->multitoken()->required(), "Replicas as host:port (tcp) or socket paths (unix); repeat or list several")
+            ("transport", po::value<std::string>(&config.transport_type)->default_value("tcp"), "Transport to use: 'tcp' or 'unix'")
+            ("policy", po::value<std::string>(&config.policy)->default_value("p2c"), "Balancing policy: 'p2c', 'hash' or 'round-robin'")
+            ("threads", po::value<size_t>(&config.threads)->default_value(4), "Threads issuing requests concurrently")
+            ("requests", po::value<uint64_t>(&config.requests)->default_value(2000), "Requests per thread")
+            ("keys", po::value<size_t>(&config.keys)->default_value(64), "Distinct request paths, cycled through by every thread");
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return false;
+        }
+        po::notify(vm);
+
+        if (config.transport_type != "tcp" && config.transport_type != "unix") {
+            std::cerr << "Error: --transport must be either 'tcp' or 'unix'." << std::endl;
+            return false;
+        }
+        if (config.policy != "p2c" && config.policy != "hash" && config.policy != "round-robin") {
+            std::cerr << "Error: --policy must be 'p2c', 'hash' or 'round-robin'." << std::endl;
+            return false;
+        }
+        if (config.threads == 0 || config.keys == 0) {
+            std::cerr << "Error: --threads and --keys must be positive." << std::endl;
+            return false;
+        }
+    } catch (const po::error& e) {
+        std::cerr << "Error parsing arguments: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::vector<httpcpp::Endpoint> parse_endpoints(const Config& config) {
+    std::vector<httpcpp::Endpoint> endpoints;
+    for (const auto& spec : config.endpoints) {
+        if (config.transport_type == "unix") {
+            endpoints.push_back({spec, 0});
+            continue;
+        }
+        const auto colon = spec.rfind(':');
+        if (colon == std::string::npos) {
+            endpoints.push_back({spec, 8080});
+        } else {
+            endpoints.push_back({spec.substr(0, colon), static_cast<uint16_t>(std::stoul(spec.substr(colon + 1)))});
+        }
+    }
+    return endpoints;
+}
+
+template <typename Transport>
+int run(const Config& config) {
+    using Clock = std::chrono::steady_clock;
+
+    const auto policy = config.policy == "hash"          ? httpcpp::BalancePolicy::ConsistentHash
+                        : config.policy == "round-robin" ? httpcpp::BalancePolicy::RoundRobin
+                                                         : httpcpp::BalancePolicy::PowerOfTwoChoices;
+    httpcpp::BalancedHttpClient<httpcpp::Http1Protocol<Transport>> client(policy);
+    const auto endpoints = parse_endpoints(config);
+    if (!client.connect(endpoints)) {
+        std::cerr << "Failed to connect to every endpoint" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<Clock::duration>> latencies(config.threads);
+    std::vector<uint64_t> failures(config.threads, 0);
+    std::vector<std::thread> workers;
+    const auto start = Clock::now();
+    for (size_t t = 0; t < config.threads; ++t) {
+        workers.emplace_back([&, t] {
+            latencies[t].reserve(config.requests);
+            for (uint64_t i = 0; i < config.requests; ++i) {
+                const std::string path = "/item/" + std::to_string((t + i) % config.keys);
+                httpcpp::HttpRequest request{};
+                request.path = path;
+                const auto request_start = Clock::now();
+                if (!client.get_safe(request)) {
+                    ++failures[t];
+                    continue;
+                }
+                latencies[t].push_back(Clock::now() - request_start);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const auto elapsed = Clock::now() - start;
+    (void)client.disconnect();
+
+    std::vector<Clock::duration> all;
+    uint64_t failed = 0;
+    for (size_t t = 0; t < config.threads; ++t) {
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+        failed += failures[t];
+    }
+    if (all.empty()) {
+        std::cerr << "No request succeeded" << std::endl;
+        return 1;
+    }
+    std::sort(all.begin(), all.end());
+    auto us = [](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+    auto percentile = [&](double p) { return us(all[std::min(all.size() - 1, static_cast<size_t>(p * all.size()))]); };
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << config.policy << ": " << all.size() << " responses in " << seconds * 1e3 << " ms ("
+              << all.size() / seconds << " req/s), " << failed << " failed" << std::endl;
+    std::cout << "  latency us: p50 " << percentile(0.50) << ", p90 " << percentile(0.90)
+              << ", p99 " << percentile(0.99) << ", max " << us(all.back()) << std::endl;
+
+    const auto stats = client.endpoint_stats();
+    for (size_t i = 0; i < stats.size(); ++i) {
+        std::cout << "  " << std::left << std::setw(24) << config.endpoints[i] << std::right
+                  << std::setw(8) << stats[i].requests << " requests ("
+                  << std::setw(5) << 100.0 * stats[i].requests / all.size() << "%), ewma "
+                  << stats[i].ewma_latency_ns / 1e3 << " us" << std::endl;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    Config config;
+    if (!parse_args(argc, argv, config)) {
+        return 1;
+    }
+
+    if (config.transport_type == "tcp") {
+        return run<httpcpp::TcpTransport>(config);
+    }
+    return run<httpcpp::UnixTransport>(config);
+}
@@ -7,6 +7,7 @@
 #include <inttypes.h>
 
 #include <httpc/httpc.h>
+#include <httpc/http1_protocol.h>
 
 typedef struct {
     char* host;
@@ -18,6 +19,9 @@ typedef struct {
     bool verify;
     bool unsafe_res;
     HttpIoPolicy io_policy;
+    size_t spill_threshold;
+    bool reconnect;
+    bool wait_all;
 } Config;
 
 typedef struct {
@@ -35,6 +39,9 @@ bool parse_args(int argc, char* argv[], Config* config) {
     config->verify = true;
     config->unsafe_res = false;
     config->io_policy = HTTP_IO_COPY_WRITE;
+    config->spill_threshold = 0;
+    config->reconnect = false;
+    config->wait_all = false;
 
     if (argc < 3) {
         fprintf(stderr, "Usage: %s <host> <port> [options]\n", argv[0]);
@@ -61,6 +68,12 @@ bool parse_args(int argc, char* argv[], Config* config) {
             if (strcmp(argv[i], "vectored") == 0) {
                 config->io_policy = HTTP_IO_VECTORED_WRITE;
             }
+        } else if (strcmp(argv[i], "--spill-threshold") == 0 && i + 1 < argc) {
+            config->spill_threshold = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--reconnect") == 0) {
+            config->reconnect = true;
+        } else if (strcmp(argv[i], "--wait-all") == 0) {
+            config->wait_all = true;
         } else if (strcmp(argv[i], "--no-verify") == 0) {
             config->verify = false;
         } else if (strcmp(argv[i], "--unsafe") == 0) {
@@ -138,6 +151,12 @@ int main(int argc, char* argv[]) {
         fprintf(stderr, "Failed to initialize http client\n");
         return 1;
     }
+    http1_protocol_set_spill(client.protocol, config.spill_threshold, NULL);
+    http1_protocol_set_reconnect(client.protocol, config.reconnect, config.reconnect);
+    http1_protocol_set_receive_strategy(client.protocol, config.wait_all ? HTTP_RECEIVE_WAIT_ALL : HTTP_RECEIVE_INCREMENTAL);
+    const Http1Protocol* http1 = (const Http1Protocol*)client.protocol->context;
+    uint64_t responses = 0;
+    uint64_t read_calls = 0;
 
     err = client.connect(&client, config.host, config.port);
     if (err.type != ErrorType.NONE) {
@@ -188,6 +207,8 @@ int main(int argc, char* argv[]) {
             fprintf(stderr, "Request failed on iteration %lu\n", (unsigned long)i);
             break;
         }
+        responses++;
+        read_calls += http1->read_calls;
 
         if (config.verify) {
             if (response.body_len < 35) {
@@ -213,6 +234,12 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    printf("httpc_client: %.2f read calls per response.\n", responses ? (double)read_calls / (double)responses : 0.0);
+    const HttpSizePredictor* predictor = &http1->size_predictor;
+    printf("httpc_client: response size predicted for %zu responses, %zu fit without regrowth (%.1f%%).\n",
+           predictor->predictions, predictor->hits,
+           predictor->predictions ? 100.0 * (double)predictor->hits / (double)predictor->predictions : 0.0);
+
     http_client_destroy(&client);
 
     FILE* out_file = fopen(config.output_file, "wb");
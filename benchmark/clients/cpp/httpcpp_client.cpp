@@ -24,6 +24,14 @@ struct Config {
     std::string output_file = "latencies_httpcpp.bin";
     bool verify = true;
     bool unsafe_res = false;
+    size_t spill_threshold = 0;
+    bool reconnect = false;
+    bool wait_all = false;
+};
+
+struct ReadCallStats {
+    uint64_t responses = 0;
+    uint64_t read_calls = 0;
 };
 
 struct BenchmarkData {
@@ -45,6 +53,9 @@ bool parse_args(int argc, char* argv[], Config& config) {
             ("output-file", po::value<std::string>(&config.output_file)->default_value("latencies_httpcpp.bin"), "File to save raw latency data to.")
             ("no-verify", po::bool_switch()->default_value(false), "Disable checksum validation.")
             ("unsafe", po::bool_switch()->default_value(false), "Use the unsafe/zero-copy response model.")
+            ("spill-threshold", po::value<size_t>(&config.spill_threshold)->default_value(0), "Spill response bodies larger than this many bytes to a memfd (0 disables).")
+            ("reconnect", po::bool_switch(&config.reconnect)->default_value(false), "Check idle connections before use and retry GETs on a dropped connection.")
+            ("wait-all", po::bool_switch(&config.wait_all)->default_value(false), "Receive the rest of a body of known length with a single MSG_WAITALL read.")
         ;
 
         po::variables_map vm;
@@ -104,8 +115,9 @@ uint64_t get_nanoseconds() {
 }
 
 template <typename Client>
-void run_benchmark(Client& client, const Config& config, const BenchmarkData& data, std::vector<int64_t>& latencies) {
+ReadCallStats run_benchmark(Client& client, const Config& config, const BenchmarkData& data, std::vector<int64_t>& latencies) {
     std::vector<std::byte> payload_buffer;
+    ReadCallStats read_stats;
 
     for (uint64_t i = 0; i < config.num_requests; ++i) {
         size_t req_size = data.sizes[i % data.sizes.size()];
@@ -137,6 +149,8 @@ void run_benchmark(Client& client, const Config& config, const BenchmarkData& da
             auto result = client.post_unsafe(request);
             client_receive_time = get_nanoseconds();
             if (!result) { std::cerr << "Request failed!" << std::endl; break; }
+            ++read_stats.responses;
+            read_stats.read_calls += client.protocol().read_calls();
 
             const auto& res = *result;
             if (config.verify) {
@@ -156,6 +170,8 @@ void run_benchmark(Client& client, const Config& config, const BenchmarkData& da
             auto result = client.post_safe(request);
             client_receive_time = get_nanoseconds();
             if (!result) { std::cerr << "Request failed!" << std::endl; break; }
+            ++read_stats.responses;
+            read_stats.read_calls += client.protocol().read_calls();
 
             const auto& res = *result;
             if (config.verify) {
@@ -174,6 +190,19 @@ void run_benchmark(Client& client, const Config& config, const BenchmarkData& da
             latencies[i] = client_receive_time - std::stoull(std::string(ts_view));
         }
     }
+    return read_stats;
+}
+
+void report_read_calls(const ReadCallStats& stats) {
+    const double per_response = stats.responses ? static_cast<double>(stats.read_calls) / static_cast<double>(stats.responses) : 0.0;
+    std::cout << "httpcpp_client: " << std::fixed << std::setprecision(2) << per_response
+              << " read calls per response." << std::endl;
+}
+
+void report_size_prediction(const SizePredictionStats& stats) {
+    const double rate = stats.predictions ? 100.0 * static_cast<double>(stats.hits) / static_cast<double>(stats.predictions) : 0.0;
+    std::cout << "httpcpp_client: response size predicted for " << stats.predictions << " responses, "
+              << stats.hits << " fit without regrowth (" << std::fixed << std::setprecision(1) << rate << "%)." << std::endl;
 }
 
 int main(int argc, char* argv[]) {
@@ -191,17 +220,25 @@ int main(int argc, char* argv[]) {
 
     if (config.transport_type == "tcp") {
         HttpClient<Http1Protocol<TcpTransport>> client;
+        client.protocol().set_spill_policy({.threshold = config.spill_threshold});
+        client.protocol().set_reconnect_policy({.check_before_use = config.reconnect, .retry_idempotent = config.reconnect});
+        client.protocol().set_receive_strategy(config.wait_all ? ReceiveStrategy::WaitAll : ReceiveStrategy::Incremental);
         if (!client.connect(config.host.c_str(), config.port)) {
              std::cerr << "Failed to connect" << std::endl; return 1;
         }
-        run_benchmark(client, config, data, latencies);
+        report_read_calls(run_benchmark(client, config, data, latencies));
+        report_size_prediction(client.protocol().size_prediction_stats());
         (void)client.disconnect();
     } else if (config.transport_type == "unix") {
         HttpClient<Http1Protocol<UnixTransport>> client;
+        client.protocol().set_spill_policy({.threshold = config.spill_threshold});
+        client.protocol().set_reconnect_policy({.check_before_use = config.reconnect, .retry_idempotent = config.reconnect});
+        client.protocol().set_receive_strategy(config.wait_all ? ReceiveStrategy::WaitAll : ReceiveStrategy::Incremental);
         if (!client.connect(config.host.c_str(), 0)) {
             std::cerr << "Failed to connect" << std::endl; return 1;
         }
-        run_benchmark(client, config, data, latencies);
+        report_read_calls(run_benchmark(client, config, data, latencies));
+        report_size_prediction(client.protocol().size_prediction_stats());
         (void)client.disconnect();
     }
 
@@ -0,0 +1,115 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <boost/program_options.hpp>
+
+#include <httpcpp/httpcpp.hpp>
+
+namespace po = boost::program_options;
+
+struct Config {
+    std::string host = "127.0.0.1";
+    uint16_t port = 8080;
+    std::string transport_type = "tcp";
+    uint64_t first_n = 10;
+    bool warm_up = false;
+    size_t warm_up_requests = 2;
+    size_t buffer_size = 2 * 1024 * 1024;
+};
+
+bool parse_args(int argc, char* argv[], Config& config) {
+    try {
+        po::options_description desc("Cold-Start Benchmark Options");
+        desc.add_options()
+            ("help,h", "Show this help message")
+            ("host", po::value<std::string>(&config.host)->default_value("127.0.0.1"), "The server host or path to Unix socket")
+            ("port", po::value<uint16_t>(&config.port)->default_value(8080), "The server port (ignored for Unix sockets)")
+            ("transport", po::value<std::string>(&config.transport_type)->default_value("tcp"), "Transport to use: 'tcp' or 'unix'")
+            ("first-n", po::value<uint64_t>(&config.first_n)->default_value(10), "Responses to time after startup")
+            ("warm-up", po::bool_switch(&config.warm_up)->default_value(false), "Call HttpClient::warm_up before the timed requests")
+            ("warm-up-requests", po::value<size_t>(&config.warm_up_requests)->default_value(2), "Throwaway requests issued by the warm-up")
+            ("buffer-size", po::value<size_t>(&config.buffer_size)->default_value(2 * 1024 * 1024), "Bytes of protocol buffer the warm-up pre-faults");
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return false;
+        }
+        if (config.transport_type != "tcp" && config.transport_type != "unix") {
+            std::cerr << "Error: --transport must be either 'tcp' or 'unix'." << std::endl;
+            return false;
+        }
+    } catch (const po::error& e) {
+        std::cerr << "Error parsing arguments: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Each run is meant to be a fresh process (e.g. under hyperfine): the interesting costs are
+// the ones a long-running client no longer pays.
+template <typename Transport>
+int run(const Config& config, const char* host, uint16_t port) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    httpcpp::HttpClient<httpcpp::Http1Protocol<Transport>> client;
+    httpcpp::HttpRequest warm_request{};
+    warm_request.path = "/";
+
+    std::expected<void, httpcpp::Error> ready;
+    if (config.warm_up) {
+        ready = client.warm_up(host, port, {.buffer_size = config.buffer_size, .request = &warm_request, .requests = config.warm_up_requests});
+    } else {
+        ready = client.connect(host, port);
+    }
+    if (!ready) {
+        std::cerr << "Failed to connect" << std::endl;
+        return 1;
+    }
+    const auto ready_at = Clock::now();
+
+    std::vector<Clock::duration> latencies;
+    latencies.reserve(config.first_n);
+    for (uint64_t i = 0; i < config.first_n; ++i) {
+        httpcpp::HttpRequest request{};
+        request.path = "/";
+        const auto request_start = Clock::now();
+        if (!client.get_unsafe(request)) {
+            std::cerr << "Request failed on iteration " << i << std::endl;
+            return 1;
+        }
+        latencies.push_back(Clock::now() - request_start);
+    }
+    const auto done_at = Clock::now();
+    (void)client.disconnect();
+
+    auto us = [](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+    std::cout << std::fixed << std::setprecision(1)
+              << (config.warm_up ? "warm-up" : "cold") << ": ready after " << us(ready_at - start) << " us, "
+              << "first " << config.first_n << " responses in " << us(done_at - ready_at) << " us "
+              << "(total " << us(done_at - start) << " us)" << std::endl;
+    std::cout << "  per-request us:";
+    for (const auto& latency : latencies) {
+        std::cout << ' ' << us(latency);
+    }
+    std::cout << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    Config config;
+    if (!parse_args(argc, argv, config)) {
+        return 1;
+    }
+
+    if (config.transport_type == "tcp") {
+        return run<httpcpp::TcpTransport>(config, config.host.c_str(), config.port);
+    }
+    return run<httpcpp::UnixTransport>(config, config.host.c_str(), 0);
+}
@@ -0,0 +1,131 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <cstring>
+#include <boost/program_options.hpp>
+
+#include <httpcpp/http1_protocol.hpp>
+
+namespace po = boost::program_options;
+using namespace httpcpp;
+
+struct Config {
+    uint64_t iterations = 1'000'000;
+    size_t body_size = 64;
+    size_t extra_headers = 8;
+};
+
+// Serves the same canned response for every request, so the benchmark measures the
+// protocol's framing and parsing work rather than the kernel.
+class ReplayTransport {
+public:
+    static inline std::string_view response;
+
+    [[nodiscard]] auto connect(const char*, uint16_t) noexcept -> std::expected<void, TransportError> { return {}; }
+    [[nodiscard]] auto close() noexcept -> std::expected<void, TransportError> { return {}; }
+
+    [[nodiscard]] auto write(std::span<const std::byte> data) noexcept -> std::expected<size_t, TransportError> {
+        pos_ = 0;
+        return data.size();
+    }
+
+    [[nodiscard]] auto read(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError> {
+        size_t n = std::min(buffer.size(), response.size() - pos_);
+        if (n == 0) {
+            return std::unexpected(TransportError::ConnectionClosed);
+        }
+        std::memcpy(buffer.data(), response.data() + pos_, n);
+        pos_ += n;
+        return n;
+    }
+
+private:
+    size_t pos_ = 0;
+};
+
+static_assert(Transport<ReplayTransport>);
+
+bool parse_args(int argc, char* argv[], Config& config) {
+    try {
+        po::options_description desc("Http1Protocol Parser Microbenchmark Options");
+        desc.add_options()
+            ("help,h", "Show this help message")
+            ("iterations", po::value<uint64_t>(&config.iterations)->default_value(1'000'000), "Requests per parser instantiation")
+            ("body-size", po::value<size_t>(&config.body_size)->default_value(64), "Response body size in bytes")
+            ("extra-headers", po::value<size_t>(&config.extra_headers)->default_value(8), "Number of non-framing response headers");
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return false;
+        }
+    } catch (const po::error& e) {
+        std::cerr << "Error parsing arguments: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string make_response(const Config& config) {
+    std::string response = "HTTP/1.1 200 OK\r\n";
+    for (size_t i = 0; i < config.extra_headers; ++i) {
+        response += "X-Benchmark-Header-" + std::to_string(i) + ": some-reasonably-sized-value\r\n";
+    }
+    response += "Content-Length: " + std::to_string(config.body_size) + "\r\n\r\n";
+    response.append(config.body_size, 'x');
+    return response;
+}
+
+template <typename Protocol>
+void run(std::string_view name, const Config& config) {
+    Protocol protocol;
+    (void)protocol.connect("replay", 0);
+    HttpRequest request{};
+    request.path = "/";
+
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < config.iterations; ++i) {
+        auto result = protocol.perform_request_unsafe(request);
+        if (!result) {
+            std::cerr << name << ": request failed" << std::endl;
+            return;
+        }
+        sink += result->status_code + result->headers.size() + result->status_message.size() + result->body.size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double ns_per_op = std::chrono::duration<double, std::nano>(elapsed).count() / config.iterations;
+
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << ns_per_op << " ns/op"
+              << "  (checksum " << sink << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    Config config;
+    if (!parse_args(argc, argv, config)) {
+        return 1;
+    }
+
+    std::string response = make_response(config);
+    ReplayTransport::response = response;
+
+    run<Http1Protocol<ReplayTransport>>("Full/Full/Lenient (default)", config);
+    run<Http1Protocol<ReplayTransport, HeadersPolicy::Full, StatusPolicy::Full, ValidationPolicy::Strict>>(
+        "Full/Full/Strict", config);
+    run<Http1Protocol<ReplayTransport, HeadersPolicy::FramingOnly, StatusPolicy::Full>>(
+        "FramingOnly/Full/Lenient", config);
+    run<Http1Protocol<ReplayTransport, HeadersPolicy::FramingOnly, StatusPolicy::CodeOnly>>(
+        "FramingOnly/CodeOnly/Lenient", config);
+    run<Http1Protocol<ReplayTransport, HeadersPolicy::None, StatusPolicy::CodeOnly>>(
+        "None/CodeOnly/Lenient", config);
+    run<Http1Protocol<ReplayTransport, HeadersPolicy::None, StatusPolicy::CodeOnly, ValidationPolicy::Strict>>(
+        "None/CodeOnly/Strict", config);
+
+    return 0;
+}
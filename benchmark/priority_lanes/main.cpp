@@ -0,0 +1,148 @@
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+
+#include <httpcpp/priority_client.hpp>
+
+namespace po = boost::program_options;
+
+struct Config {
+    std::string host = "127.0.0.1";
+    uint16_t port = 8080;
+    std::string transport_type = "tcp";
+    std::string mode = "lanes";
+    uint64_t small_requests = 2000;
+    size_t small_size = 64;
+    size_t bulk_size = 1024 * 1024;
+    uint64_t bulk_bytes_per_second = 0;
+};
+
+bool parse_args(int argc, char* argv[], Config& config) {
+    try {
+        po::options_description desc("Priority Lanes Benchmark Options");
+        desc.add_options()
+            ("help,h", "Show this help message")
+            ("host", po::value<std::string>(&config.host)->default_value("127.0.0.1"), "The server host or path to Unix socket")
+            ("port", po::value<uint16_t>(&config.port)->default_value(8080), "The server port (ignored for Unix sockets)")
+            ("transport", po::value<std::string>(&config.transport_type)->default_value("tcp"), "Transport to use: 'tcp' or 'unix'")
+            ("mode", po::value<std::string>(&config.mode)->default_value("lanes"), "'lanes' gives small requests their own connection; 'shared' sends everything over one")
+            ("small-requests", po::value<uint64_t>(&config.small_requests)->default_value(2000), "Latency-sensitive requests to time")
+            ("small-size", po::value<size_t>(&config.small_size)->default_value(64), "Body size of the small requests")
+            ("bulk-size", po::value<size_t>(&config.bulk_size)->default_value(1024 * 1024), "Body size of the bulk uploads sent meanwhile")
+            ("bulk-bytes-per-second", po::value<uint64_t>(&config.bulk_bytes_per_second)->default_value(0), "Pace the bulk lane to this rate (0 = unpaced)");
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return false;
+        }
+        if (config.transport_type != "tcp" && config.transport_type != "unix") {
+            std::cerr << "Error: --transport must be either 'tcp' or 'unix'." << std::endl;
+            return false;
+        }
+        if (config.mode != "lanes" && config.mode != "shared") {
+            std::cerr << "Error: --mode must be either 'lanes' or 'shared'." << std::endl;
+            return false;
+        }
+        if (config.small_size == 0 || config.bulk_size == 0) {
+            std::cerr << "Error: --small-size and --bulk-size must be positive." << std::endl;
+            return false;
+        }
+    } catch (const po::error& e) {
+        std::cerr << "Error parsing arguments: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void report(const char* name, const httpcpp::LatencyHistogram& latency) {
+    auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1e3; };
+    std::cout << "  " << std::left << std::setw(6) << name << std::right << std::setw(8) << latency.count()
+              << " requests, latency us: p50 " << us(latency.percentile(0.50)) << ", p90 " << us(latency.percentile(0.90))
+              << ", p99 " << us(latency.percentile(0.99)) << ", max " << us(latency.max()) << std::endl;
+}
+
+// A bulk uploader keeps one connection busy while the small requests are timed. In 'shared'
+// mode both go through the bulk lane, so each small request waits for the upload in progress.
+template <typename Transport>
+int run(const Config& config, const char* host, uint16_t port) {
+    using Clock = std::chrono::steady_clock;
+
+    const bool lanes = config.mode == "lanes";
+    httpcpp::PriorityHttpClient<httpcpp::Http1Protocol<Transport>> client({
+        .interactive_connections = 1,
+        .bulk_connections = 1,
+        .bulk_threshold = config.bulk_size,
+        .bulk_bytes_per_second = config.bulk_bytes_per_second,
+    });
+    if (!client.connect(host, port)) {
+        std::cerr << "Failed to connect" << std::endl;
+        return 1;
+    }
+    const auto small_priority = lanes ? httpcpp::Priority::Interactive : httpcpp::Priority::Bulk;
+
+    httpcpp::LatencyHistogram small_latency;
+    httpcpp::LatencyHistogram bulk_latency;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> failures{0};
+
+    std::thread bulk([&] {
+        const std::vector<std::byte> body(config.bulk_size, std::byte{'b'});
+        const std::string length = std::to_string(body.size());
+        while (!done.load(std::memory_order_relaxed)) {
+            httpcpp::HttpRequest request{};
+            request.path = "/bulk";
+            request.body = body;
+            request.headers = {{"Content-Length", length}};
+            const auto start = Clock::now();
+            if (!client.post_safe(request, httpcpp::Priority::Bulk)) {
+                failures.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            bulk_latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+    });
+
+    const std::vector<std::byte> body(config.small_size, std::byte{'s'});
+    const std::string length = std::to_string(body.size());
+    for (uint64_t i = 0; i < config.small_requests; ++i) {
+        httpcpp::HttpRequest request{};
+        request.path = "/small";
+        request.body = body;
+        request.headers = {{"Content-Length", length}};
+        const auto start = Clock::now();
+        if (!client.post_safe(request, small_priority)) {
+            failures.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        small_latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    done = true;
+    bulk.join();
+    (void)client.disconnect();
+
+    std::cout << std::fixed << std::setprecision(1) << config.mode << ": " << failures.load() << " failed" << std::endl;
+    report("small", small_latency);
+    report("bulk", bulk_latency);
+    return failures.load() == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    Config config;
+    if (!parse_args(argc, argv, config)) {
+        return 1;
+    }
+
+    if (config.transport_type == "tcp") {
+        return run<httpcpp::TcpTransport>(config, config.host.c_str(), config.port);
+    }
+    return run<httpcpp::UnixTransport>(config, config.host.c_str(), 0);
+}
@@ -0,0 +1,161 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include <optional>
+#include <boost/program_options.hpp>
+
+#include <httpcpp/tcp_transport.hpp>
+#include <httpcpp/tls_transport.hpp>
+
+namespace po = boost::program_options;
+
+struct Config {
+    std::string host = "127.0.0.1";
+    uint16_t port = 8080;
+    uint64_t connections = 1000;
+    bool fast_open = false;
+    bool tls = false;
+    bool resume = true;
+    std::string ca_file;
+    std::string output_file = "latencies_reconnect.bin";
+};
+
+bool parse_args(int argc, char* argv[], Config& config) {
+    try {
+        po::options_description desc("Reconnect (Time-To-First-Byte) Benchmark Options");
+        desc.add_options()
+            ("help,h", "Show this help message")
+            ("host", po::value<std::string>(&config.host)->default_value("127.0.0.1"), "The benchmark_server host")
+            ("port", po::value<uint16_t>(&config.port)->default_value(8080), "The benchmark_server port")
+            ("connections", po::value<uint64_t>(&config.connections)->default_value(1000),
+                "Connections to open, one request each; start benchmark_server with at least as many --connections")
+            ("fast-open", po::bool_switch(&config.fast_open)->default_value(false), "Connect with TCP Fast Open")
+            ("tls", po::bool_switch(&config.tls)->default_value(false), "Speak TLS; start benchmark_server with --tls-cert and --tls-key")
+            ("resume", po::value<bool>(&config.resume)->default_value(true), "With --tls, resume the previous connection's session instead of a full handshake")
+            ("ca-file", po::value<std::string>(&config.ca_file), "With --tls, PEM certificate to trust (e.g. the server's self-signed one); verification is off without it")
+            ("output-file", po::value<std::string>(&config.output_file)->default_value("latencies_reconnect.bin"), "File to save raw time-to-first-byte data to");
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return false;
+        }
+    } catch (const po::error& e) {
+        std::cerr << "Error parsing arguments: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Connects, sends the request and waits for the first response byte, then drains the response
+// up to the server's close. `inspect` sees the transport before it is closed.
+template<httpcpp::Transport T, typename Inspect>
+auto time_to_first_byte(T& transport, const Config& config, std::span<const std::byte> request, std::span<std::byte> buffer,
+                        Inspect inspect) -> std::optional<int64_t> {
+    const auto start = std::chrono::steady_clock::now();
+    if (!transport.connect(config.host.c_str(), config.port)) {
+        return std::nullopt;
+    }
+    if (!transport.write(request) || !transport.read(buffer)) {
+        return std::nullopt;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // The server closes after answering `Connection: close`; drain up to that point.
+    while (transport.read(buffer)) {
+    }
+    inspect(transport);
+    (void)transport.close();
+    return elapsed;
+}
+
+int main(int argc, char* argv[]) {
+    Config config;
+    if (!parse_args(argc, argv, config)) {
+        return 1;
+    }
+
+    const std::string request = "GET / HTTP/1.1\r\nHost: " + config.host + "\r\nConnection: close\r\n\r\n";
+    const std::span<const std::byte> request_bytes(reinterpret_cast<const std::byte*>(request.data()), request.size());
+    std::vector<std::byte> buffer(64 * 1024);
+    std::vector<int64_t> ttfb(config.connections);
+
+    // Each iteration pays connect + request + first response byte; with Fast Open the request
+    // rides in the SYN from the second connection on, once the kernel has the server's cookie.
+    // With TLS the handshake is added, abbreviated from the second connection on when resuming.
+    std::shared_ptr<httpcpp::TlsContext> tls_context;
+    if (config.tls) {
+        auto context = httpcpp::TlsContext::create({
+            .ca_file = config.ca_file,
+            .verify_peer = !config.ca_file.empty(),
+            .resume_sessions = config.resume,
+        });
+        if (!context) {
+            std::cerr << "Failed to set up TLS" << std::endl;
+            return 1;
+        }
+        tls_context = *context;
+    }
+    uint64_t resumed = 0;
+    uint64_t kernel_tls = 0;
+
+    const auto run_start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < config.connections; ++i) {
+        std::optional<int64_t> sample;
+        if (config.tls) {
+            httpcpp::TlsTransport<httpcpp::TcpTransport> transport;
+            transport.inner().set_fast_open(config.fast_open);
+            transport.set_context(tls_context);
+            sample = time_to_first_byte(transport, config, request_bytes, buffer, [&](const auto& connected) {
+                resumed += connected.session_reused() ? 1 : 0;
+                kernel_tls += connected.kernel_tls_send() ? 1 : 0;
+            });
+        } else {
+            httpcpp::TcpTransport transport;
+            transport.set_fast_open(config.fast_open);
+            sample = time_to_first_byte(transport, config, request_bytes, buffer, [](const auto&) {});
+        }
+        if (!sample) {
+            std::cerr << "Request failed on iteration " << i << std::endl;
+            return 1;
+        }
+        ttfb[i] = *sample;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - run_start;
+
+    std::ofstream out_file(config.output_file, std::ios::binary);
+    if (out_file) {
+        out_file.write(reinterpret_cast<const char*>(ttfb.data()), ttfb.size() * sizeof(int64_t));
+    }
+
+    std::vector<int64_t> sorted = ttfb;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) {
+        return sorted.empty() ? 0.0 : sorted[static_cast<size_t>(p * (sorted.size() - 1))] / 1000.0;
+    };
+    const double mean = sorted.empty() ? 0.0 : std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size() / 1000.0;
+
+    std::string label = config.fast_open ? "fast-open" : "handshake";
+    if (config.tls) {
+        label += config.resume ? "+tls-resume" : "+tls";
+    }
+    std::cout << std::left << std::setw(20) << label
+              << std::right << std::fixed << std::setprecision(1)
+              << " ttfb mean " << mean << " us, p50 " << percentile(0.5) << " us, p99 " << percentile(0.99) << " us"
+              << "  (" << config.connections << " connections in "
+              << std::chrono::duration<double, std::milli>(elapsed).count() << " ms)" << std::endl;
+    if (config.tls) {
+        std::cout << "  resumed " << resumed << "/" << config.connections << " handshakes, kTLS send on "
+                  << kernel_tls << "/" << config.connections << " connections" << std::endl;
+    }
+    return 0;
+}
@@ -1,10 +1,14 @@
 #include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
 #include <boost/beast.hpp>
 #include <boost/program_options.hpp>
 #include <format>
 #include <iostream>
 #include <random>
 #include <spanstream>
+#include <thread>
+
+#include <netinet/tcp.h>
 
 namespace beast = boost::beast;
 namespace http  = beast::http;
@@ -23,6 +27,12 @@ struct Config {
     unsigned short port             = 8080;
     std::string    unix_socket_path = "/tmp/httpc_benchmark.sock";
     bool           verify           = false;
+    int            connections      = 1;
+    int            fast_open_queue  = 256;
+    unsigned       delay_us         = 0;
+    bool           concurrent       = false;
+    std::string    tls_cert;
+    std::string    tls_key;
 };
 
 struct ResponseCache {
@@ -46,6 +56,12 @@ bool parse_args(int argc, char* argv[], Config& config) {
             ("host", po::value<std::string>(&config.host)->default_value("127.0.0.1"), "Host to bind for TCP transport")
             ("port", po::value<unsigned short>(&config.port)->default_value(8080), "Port to bind for TCP transport")
             ("unix-socket-path", po::value<std::string>(&config.unix_socket_path)->default_value("/tmp/httpc_benchmark.sock"), "Path for the Unix domain socket")
+            ("connections", po::value<int>(&config.connections)->default_value(1), "Number of connections to serve, one after another, before exiting")
+            ("fast-open-queue", po::value<int>(&config.fast_open_queue)->default_value(256), "TCP Fast Open queue length on the listener (0 disables; server side also needs net.ipv4.tcp_fastopen & 2)")
+            ("delay-us", po::value<unsigned>(&config.delay_us)->default_value(0), "Service time added before every response, to emulate a slower replica")
+            ("concurrent", po::bool_switch(&config.concurrent), "Serve the connections in parallel, one thread each, instead of one after another")
+            ("tls-cert", po::value<std::string>(&config.tls_cert), "PEM certificate chain; with --tls-key, serve TCP connections over TLS")
+            ("tls-key", po::value<std::string>(&config.tls_key), "PEM private key for --tls-cert")
         ;
         // clang-format on
 
@@ -63,6 +79,15 @@ bool parse_args(int argc, char* argv[], Config& config) {
             return false;
         }
 
+        if (config.tls_cert.empty() != config.tls_key.empty()) {
+            std::cerr << "Error: --tls-cert and --tls-key go together." << std::endl;
+            return false;
+        }
+        if (!config.tls_cert.empty() && config.transport_type != "tcp") {
+            std::cerr << "Error: TLS is only served over --transport tcp." << std::endl;
+            return false;
+        }
+
     } catch (po::error const& e) {
         std::cerr << "Error parsing arguments: " << e.what() << std::endl;
         return false;
@@ -129,6 +154,9 @@ ResponseCache generate_responses(Config const& config) {
     return cache;
 }
 
+template <class Stream> constexpr bool is_tls_stream = false;
+template <class Next> constexpr bool is_tls_stream<net::ssl::stream<Next>> = true;
+
 template <class Stream> void do_session(Stream& stream, ResponseCache const& cache, Config const& config) {
     // *** Use flat_buffer, like the client ***
     beast::flat_buffer buffer;
@@ -139,7 +167,9 @@ template <class Stream> void do_session(Stream& stream, ResponseCache const& cac
     // Temporary storage for potentially fragmented body
     std::vector<char> full_body_storage;
 
-    if constexpr (std::is_same_v<typename Stream::protocol_type, tcp>) { // Check if it's TCP
+    if constexpr (is_tls_stream<Stream>) {
+        // TCP_NODELAY was set on the socket before the handshake.
+    } else if constexpr (std::is_same_v<typename Stream::protocol_type, tcp>) { // Check if it's TCP
         stream.set_option(tcp::no_delay(true), ec);                      // Set the option
         if (ec) {
             // Log a warning if setting fails, but continue the session
@@ -271,6 +301,10 @@ template <class Stream> void do_session(Stream& stream, ResponseCache const& cac
             }
         }
 
+        if (config.delay_us > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(config.delay_us));
+        }
+
         // --- Response Sending Logic (Unchanged) ---
         auto const& header_template = cache.header_templates[0];
         auto const& body_view       = cache.body_views[0]; // Server's response body
@@ -326,16 +360,33 @@ template <class Stream> void do_session(Stream& stream, ResponseCache const& cac
     } // End of for(;;) loop
 
     // --- Shutdown Logic (Unchanged) ---
-    if constexpr (std::is_same_v<typename Stream::protocol_type, tcp>) {
+    if constexpr (is_tls_stream<Stream>) {
+        // close_notify; clients that simply close make the wait for theirs fail, which is fine.
+        stream.shutdown(ec);
+        stream.next_layer().shutdown(tcp::socket::shutdown_send, ec);
+    } else if constexpr (std::is_same_v<typename Stream::protocol_type, tcp>) {
         stream.shutdown(tcp::socket::shutdown_send, ec);
     } else {
         stream.shutdown(local::socket::shutdown_send, ec);
     }
 } // End of do_session
 
+// Runs the TLS handshake on an accepted socket, then the session over the encrypted stream.
+void do_tls_session(tcp::socket socket, net::ssl::context& tls, ResponseCache const& cache, Config const& config) {
+    beast::error_code ec;
+    socket.set_option(tcp::no_delay(true), ec);
+    net::ssl::stream<tcp::socket> stream(std::move(socket), tls);
+    stream.handshake(net::ssl::stream_base::server, ec);
+    if (ec) {
+        std::cerr << "TLS handshake error: " << ec.message() << std::endl;
+        return;
+    }
+    do_session(stream, cache, config);
+}
+
 template <class Acceptor, class Endpoint>
 void do_listen(net::io_context& ioc, Endpoint const& endpoint, ResponseCache const& cache,
-               Config const& config) {
+               Config const& config, net::ssl::context* tls = nullptr) {
     beast::error_code ec;
     Acceptor          acceptor(ioc);
 
@@ -351,6 +402,17 @@ void do_listen(net::io_context& ioc, Endpoint const& endpoint, ResponseCache con
         return;
     }
 
+    if constexpr (std::is_same_v<typename Acceptor::protocol_type, tcp>) {
+        if (config.fast_open_queue > 0) {
+            // Accept request bytes carried in the SYN, saving reconnecting clients a round trip.
+            acceptor.set_option(net::detail::socket_option::integer<IPPROTO_TCP, TCP_FASTOPEN>(config.fast_open_queue), ec);
+            if (ec) {
+                std::cerr << "Warning: Failed to enable TCP Fast Open: " << ec.message() << std::endl;
+                ec.clear();
+            }
+        }
+    }
+
     acceptor.bind(endpoint, ec);
     if (ec) {
         std::cerr << "Failed to bind to endpoint: " << ec.message() << std::endl;
@@ -364,14 +426,30 @@ void do_listen(net::io_context& ioc, Endpoint const& endpoint, ResponseCache con
     }
 
     std::cout << "Server listening for connections..." << std::endl;
-    for (;;) {
+    std::vector<std::thread> sessions;
+    for (int served = 0; served < config.connections; ++served) {
         auto socket = acceptor.accept(ioc, ec);
         if (ec) {
             std::cerr << "Failed to accept connection: " << ec.message() << std::endl;
             break;
         }
-        do_session(socket, cache, config);
-        break;
+        auto serve = [&cache, &config, tls](auto socket) {
+            if constexpr (std::is_same_v<typename Acceptor::protocol_type, tcp>) {
+                if (tls != nullptr) {
+                    do_tls_session(std::move(socket), *tls, cache, config);
+                    return;
+                }
+            }
+            do_session(socket, cache, config);
+        };
+        if (config.concurrent) {
+            sessions.emplace_back([socket = std::move(socket), serve]() mutable { serve(std::move(socket)); });
+        } else {
+            serve(std::move(socket));
+        }
+    }
+    for (auto& session : sessions) {
+        session.join();
     }
 }
 
@@ -390,7 +468,23 @@ int main(int argc, char* argv[]) {
 
     if (config.transport_type == "tcp") {
         auto const endpoint = tcp::endpoint{net::ip::make_address(config.host), config.port};
-        do_listen<tcp::acceptor, tcp::endpoint>(ioc, endpoint, response_cache, config);
+        if (!config.tls_cert.empty()) {
+            // One context for every connection, so session tickets it issues are accepted on
+            // reconnects and clients can resume.
+            net::ssl::context tls(net::ssl::context::tls_server);
+            beast::error_code ec;
+            tls.use_certificate_chain_file(config.tls_cert, ec);
+            if (!ec) {
+                tls.use_private_key_file(config.tls_key, net::ssl::context::pem, ec);
+            }
+            if (ec) {
+                std::cerr << "Failed to load TLS certificate or key: " << ec.message() << std::endl;
+                return 1;
+            }
+            do_listen<tcp::acceptor, tcp::endpoint>(ioc, endpoint, response_cache, config, &tls);
+        } else {
+            do_listen<tcp::acceptor, tcp::endpoint>(ioc, endpoint, response_cache, config);
+        }
     } else if (config.transport_type == "unix") {
         std::remove(config.unix_socket_path.c_str());
         auto const endpoint = local::endpoint{config.unix_socket_path};
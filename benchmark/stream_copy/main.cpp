@@ -0,0 +1,168 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <numeric>
+#include <cstring>
+#include <boost/program_options.hpp>
+
+#include <httpcpp/stream_copy.hpp>
+
+namespace po = boost::program_options;
+
+struct Config {
+    size_t body_size = 1024 * 1024;
+    size_t working_set = 1024 * 1024;
+    uint64_t iterations = 2000;
+    uint64_t probe_steps = 16384;
+    std::string co_runner = "inline";
+};
+
+// One cache line per node; `next` forms a single random cycle so the hardware prefetcher
+// cannot hide misses. Its throughput is the cache-sensitive workload we protect.
+struct alignas(64) Node {
+    size_t next;
+};
+
+class PointerChase {
+public:
+    explicit PointerChase(size_t bytes) : nodes_(std::max<size_t>(bytes / sizeof(Node), 2)) {
+        std::vector<size_t> order(nodes_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin() + 1, order.end(), std::mt19937_64{42});
+        for (size_t i = 0; i < order.size(); ++i) {
+            nodes_[order[i]].next = order[(i + 1) % order.size()];
+        }
+    }
+
+    size_t walk(uint64_t steps) noexcept {
+        for (uint64_t i = 0; i < steps; ++i) {
+            pos_ = nodes_[pos_].next;
+        }
+        return pos_;
+    }
+
+private:
+    std::vector<Node> nodes_;
+    size_t pos_ = 0;
+};
+
+bool parse_args(int argc, char* argv[], Config& config) {
+    try {
+        po::options_description desc("Non-Temporal Copy Benchmark Options");
+        desc.add_options()
+            ("help,h", "Show this help message")
+            ("body-size", po::value<size_t>(&config.body_size)->default_value(1024 * 1024), "Bytes copied per simulated safe response")
+            ("working-set", po::value<size_t>(&config.working_set)->default_value(1024 * 1024), "Bytes touched by the cache-sensitive workload")
+            ("iterations", po::value<uint64_t>(&config.iterations)->default_value(2000), "Copies per strategy")
+            ("probe-steps", po::value<uint64_t>(&config.probe_steps)->default_value(16384), "Pointer-chase steps after each copy (inline mode)")
+            ("co-runner", po::value<std::string>(&config.co_runner)->default_value("inline"),
+                "Where the workload runs: 'inline' (interleaved on the copying thread) or 'thread' (another core)");
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return false;
+        }
+        if (config.co_runner != "inline" && config.co_runner != "thread") {
+            std::cerr << "Error: --co-runner must be 'inline' or 'thread'." << std::endl;
+            return false;
+        }
+    } catch (const po::error& e) {
+        std::cerr << "Error parsing arguments: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Mirrors perform_request_safe: a fresh owning buffer per response, filled from the receive
+// buffer without being zeroed first.
+template <typename Copy>
+httpcpp::ByteBuffer copy_body(const std::vector<std::byte>& source, Copy copy) {
+    httpcpp::ByteBuffer body;
+    body.resize(source.size());
+    copy(body.data(), source.data(), source.size());
+    return body;
+}
+
+template <typename Copy>
+void run(std::string_view name, const Config& config, const std::vector<std::byte>& source, Copy copy) {
+    PointerChase chase(config.working_set);
+    chase.walk(config.working_set / sizeof(Node)); // Warm the working set.
+
+    uint64_t sink = 0;
+    std::chrono::nanoseconds copy_time{0};
+    std::chrono::nanoseconds probe_time{0};
+    uint64_t probe_steps = 0;
+
+    std::atomic<bool> stop{false};
+    std::thread co_runner;
+    if (config.co_runner == "thread") {
+        co_runner = std::thread([&] {
+            auto start = std::chrono::steady_clock::now();
+            uint64_t steps = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                sink += chase.walk(1024);
+                steps += 1024;
+            }
+            probe_time = std::chrono::steady_clock::now() - start;
+            probe_steps = steps;
+        });
+    }
+
+    for (uint64_t i = 0; i < config.iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        auto body = copy_body(source, copy);
+        copy_time += std::chrono::steady_clock::now() - start;
+        sink += static_cast<uint64_t>(body[i % body.size()]);
+
+        if (config.co_runner == "inline") {
+            start = std::chrono::steady_clock::now();
+            sink += chase.walk(config.probe_steps);
+            probe_time += std::chrono::steady_clock::now() - start;
+            probe_steps += config.probe_steps;
+        }
+    }
+
+    if (co_runner.joinable()) {
+        stop = true;
+        co_runner.join();
+    }
+
+    const double copy_gbps = static_cast<double>(source.size()) * config.iterations / std::chrono::duration<double>(copy_time).count() / 1e9;
+    const double ns_per_step = std::chrono::duration<double, std::nano>(probe_time).count() / std::max<uint64_t>(probe_steps, 1);
+
+    std::cout << std::left << std::setw(20) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << copy_gbps << " GB/s copy"
+              << std::setw(10) << ns_per_step << " ns/step workload"
+              << "  (checksum " << sink << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    Config config;
+    if (!parse_args(argc, argv, config)) {
+        return 1;
+    }
+
+    std::vector<std::byte> source(config.body_size);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<std::byte>(i * 31);
+    }
+
+    std::cout << "body " << config.body_size << " B, working set " << config.working_set
+              << " B, co-runner " << config.co_runner << std::endl;
+
+    run("memcpy", config, source, [](void* d, const void* s, size_t n) { std::memcpy(d, s, n); });
+    run("stream_copy", config, source, [](void* d, const void* s, size_t n) { httpcpp::stream_copy(d, s, n); });
+    run("copy_bytes", config, source, [](void* d, const void* s, size_t n) { httpcpp::copy_bytes(d, s, n); });
+
+    return 0;
+}
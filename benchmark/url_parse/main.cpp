@@ -0,0 +1,131 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <boost/program_options.hpp>
+
+#include <httpcpp/url.hpp>
+
+namespace po = boost::program_options;
+
+// Every heap allocation in the process is counted, so each parser's allocations per URL can be
+// reported next to its speed.
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+struct Config {
+    uint64_t iterations = 1'000'000;
+};
+
+bool parse_args(int argc, char* argv[], Config& config) {
+    try {
+        po::options_description desc("URL Parser Microbenchmark Options");
+        desc.add_options()
+            ("help,h", "Show this help message")
+            ("iterations", po::value<uint64_t>(&config.iterations)->default_value(1'000'000), "URLs parsed per parser");
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return false;
+        }
+    } catch (const po::error& e) {
+        std::cerr << "Error parsing arguments: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// What callers wrote before parse_url existed: split with find/substr into owning strings.
+struct NaiveUrl {
+    std::string scheme;
+    std::string host;
+    uint16_t port = 0;
+    std::string path;
+    std::string query;
+};
+
+bool naive_parse(const std::string& text, NaiveUrl& url) {
+    const size_t scheme_end = text.find("://");
+    if (scheme_end == std::string::npos) {
+        return false;
+    }
+    url.scheme = text.substr(0, scheme_end);
+    std::string rest = text.substr(scheme_end + 3);
+    const size_t slash = rest.find('/');
+    std::string authority = rest.substr(0, slash);
+    std::string target = slash == std::string::npos ? "/" : rest.substr(slash);
+    const size_t colon = authority.find(':');
+    url.host = authority.substr(0, colon);
+    url.port = colon == std::string::npos ? 80 : static_cast<uint16_t>(std::stoi(authority.substr(colon + 1)));
+    const size_t question = target.find('?');
+    url.path = target.substr(0, question);
+    url.query = question == std::string::npos ? "" : target.substr(question + 1);
+    return true;
+}
+
+template <typename Parse>
+void run(std::string_view name, const Config& config, const std::vector<std::string>& urls, Parse parse) {
+    uint64_t sink = 0;
+    const size_t allocations_before = allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < config.iterations; ++i) {
+        sink += parse(urls[i % urls.size()]);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const double ns_per_url = std::chrono::duration<double, std::nano>(elapsed).count() / config.iterations;
+    const double allocations_per_url = static_cast<double>(allocations - allocations_before) / config.iterations;
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+              << std::setw(10) << std::setprecision(1) << ns_per_url << " ns/url"
+              << std::setw(8) << std::setprecision(2) << allocations_per_url << " allocs/url"
+              << "  (checksum " << sink << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    Config config;
+    if (!parse_args(argc, argv, config)) {
+        return 1;
+    }
+
+    const std::vector<std::string> urls = {
+        "http://127.0.0.1:8080/",
+        "http://localhost/index.html",
+        "http://api.example.com:8443/v1/users/12345/orders?limit=50&offset=100",
+        "http://cdn.example.net/static/assets/images/a-rather-long-file-name-for-an-image.png",
+        "http://10.0.0.7:9000/metrics?format=prometheus",
+    };
+
+    run("httpcpp::parse_url", config, urls, [](const std::string& text) -> uint64_t {
+        auto url = httpcpp::parse_url(text);
+        return url ? url->port + url->host.size() + url->path.size() + url->query.size() : 0;
+    });
+    NaiveUrl naive;
+    run("naive std::string split", config, urls, [&naive](const std::string& text) -> uint64_t {
+        return naive_parse(text, naive) ? naive.port + naive.host.size() + naive.path.size() + naive.query.size() : 0;
+    });
+
+    return 0;
+}
@@ -43,10 +43,14 @@ static const struct {
     const int HTTP_PARSE_FAILURE;
     const int INVALID_REQUEST_SYNTAX;
     const int INIT_FAILURE;
+    const int INTEGRITY_FAILURE;
+    const int SPILL_FAILURE;
 } HttpClientErrorCode = {
     .NONE = 0,
     .URL_PARSE_FAILURE = 1,
     .HTTP_PARSE_FAILURE = 2,
     .INVALID_REQUEST_SYNTAX = 3,
     .INIT_FAILURE = 4,
+    .INTEGRITY_FAILURE = 5,
+    .SPILL_FAILURE = 6,
 };
@@ -3,6 +3,17 @@
 #include <httpc/http_protocol.h>
 #include <httpc/growable_buffer.h>
 
+// Running estimate of the response size on a connection: exponentially weighted moving averages
+// of recent sizes and of their mean deviation. `predictions` counts responses read into a buffer
+// presized from the estimate and `hits` those that fit without regrowing it.
+typedef struct {
+    size_t mean;
+    size_t deviation;
+    size_t samples;
+    size_t predictions;
+    size_t hits;
+} HttpSizePredictor;
+
 typedef struct {
     HttpProtocolInterface interface;
     TransportInterface* transport;
@@ -10,6 +21,22 @@ typedef struct {
     const HttpcSyscalls* syscalls;
     HttpResponseMemoryPolicy policy;
     HttpIoPolicy io_policy;
+    size_t body_padding;
+    size_t body_alignment;
+    HttpIntegrityPolicy integrity_policy;
+    size_t spill_threshold;
+    const char* spill_directory;
+    void* spill_mapping;
+    size_t spill_mapping_len;
+    char reconnect_host[256];
+    int reconnect_port;
+    bool reconnect_check;
+    bool reconnect_retry;
+    size_t reconnect_count;
+    size_t response_bytes;
+    HttpSizePredictor size_predictor;
+    HttpReceiveStrategy receive_strategy;
+    size_t read_calls;
     Error (*parse_response)(void* context, HttpResponse* response);
 } Http1Protocol;
 
@@ -20,3 +47,37 @@ HttpProtocolInterface* http1_protocol_new(
     HttpResponseMemoryPolicy policy,
     HttpIoPolicy io_policy
 );
+
+// Switches between zero-copy responses that borrow the protocol buffer and responses that own
+// their buffer, e.g. for bindings that mix both on one connection.
+Error http1_protocol_set_memory_policy(HttpProtocolInterface* protocol, HttpResponseMemoryPolicy policy);
+
+// Guarantees `padding` zeroed bytes readable after `response->body` and, for a non-zero
+// power-of-two `alignment`, an aligned body start. Without a layout the body is NUL-terminated.
+Error http1_protocol_set_body_layout(HttpProtocolInterface* protocol, size_t padding, size_t alignment);
+
+// With HTTP_INTEGRITY_CRC32C the body is checksummed chunk by chunk as it is received and checked
+// against a `Content-Digest: crc32c=:<base64>:` response header; a mismatch fails with INTEGRITY_FAILURE.
+Error http1_protocol_set_integrity(HttpProtocolInterface* protocol, HttpIntegrityPolicy integrity_policy);
+
+// Bodies larger than `threshold` bytes (0 disables spilling) are streamed into an unlinked file and
+// exposed as a read-only mapping instead of growing the receive buffer. A null `directory` uses a
+// memfd; otherwise an O_TMPFILE is created in that directory so its pages can be written back.
+Error http1_protocol_set_spill(HttpProtocolInterface* protocol, size_t threshold, const char* directory);
+
+// With HTTP_RECEIVE_WAIT_ALL, once the headers have given the body length the rest of the body is
+// received with the transport's `read_all` (recv with MSG_WAITALL) into a buffer sized for exactly
+// that, rather than in whatever pieces arrive. Transports without `read_all` read incrementally.
+// `read_calls` counts the transport reads made for the most recent response.
+Error http1_protocol_set_receive_strategy(HttpProtocolInterface* protocol, HttpReceiveStrategy strategy);
+
+// Grows the buffer shared by serialized requests and unsafe responses to `capacity` bytes and
+// writes every page, so the first exchanges pay neither for regrowth nor for page faults.
+// Fails with INVALID_REQUEST_SYNTAX for a protocol that is not an Http1Protocol.
+Error http1_protocol_reserve(HttpProtocolInterface* protocol, size_t capacity);
+
+// Handling of keep-alive connections the server closed while idle; both are off by default.
+// `check_before_use` asks the transport's `is_stale` before each request and reconnects up front.
+// `retry_idempotent` sends a GET once more on a fresh connection when the old one fails before any
+// response byte arrives. POSTs are never retried. `reconnect_count` counts reconnects made.
+Error http1_protocol_set_reconnect(HttpProtocolInterface* protocol, bool check_before_use, bool retry_idempotent);
@@ -30,6 +30,16 @@ typedef enum {
     HTTP_IO_VECTORED_WRITE
 } HttpIoPolicy;
 
+typedef enum {
+    HTTP_RECEIVE_INCREMENTAL,
+    HTTP_RECEIVE_WAIT_ALL
+} HttpReceiveStrategy;
+
+typedef enum {
+    HTTP_INTEGRITY_NONE,
+    HTTP_INTEGRITY_CRC32C
+} HttpIntegrityPolicy;
+
 typedef struct {
     int status_code;
     const char* status_message;
@@ -39,6 +49,8 @@ typedef struct {
     size_t num_headers;
     size_t content_length;
     void* _owned_buffer;
+    void* _mapped_body;
+    size_t _mapped_len;
 } HttpResponse;
 
 void http_response_destroy(HttpResponse* response);
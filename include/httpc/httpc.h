@@ -38,11 +38,25 @@ Error http_client_init(
     HttpIoPolicy io_policy
 );
 
+// Startup work that would otherwise land on the first real requests. `buffer_size` bytes of
+// protocol buffer are allocated and pre-faulted up front (HTTP/1 protocols; safe responses still
+// get a buffer of their own). `request`, when set, is then sent `num_requests` times to warm
+// caches, branch predictors and the server side; its responses are discarded.
+typedef struct {
+    size_t buffer_size;
+    HttpRequest* request;
+    size_t num_requests;
+} HttpWarmUpOptions;
+
 Error http_client_init_with_protocol(
     struct HttpClient* self,
     HttpProtocolInterface* protocol
 );
 void http_client_destroy(struct HttpClient* self);
 
+// Connects, then performs the warm-up described by `options` (may be null to just connect).
+// A client owns a single connection; warm several clients to have several connections ready.
+Error http_client_warm_up(struct HttpClient* self, const char* host, int port, const HttpWarmUpOptions* options);
+
 
 
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <httpc/error.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+// CRC32C (Castagnoli). Uses the SSE4.2 / ARMv8 CRC instructions when the build targets them and
+// a table-driven fallback otherwise. Start with crc = 0 and feed chunks in order.
+uint32_t httpc_crc32c_update(uint32_t crc, const void* data, size_t len);
+
+// Finds the `crc32c` member of a Content-Digest field value, a dictionary of `algorithm=:<base64>:`
+// members separated by commas (RFC 9530), and sets `*found` accordingly. A crc32c member whose
+// value is not the base64 of a 4-byte checksum is an INTEGRITY_FAILURE rather than a missing one.
+Error httpc_parse_crc32c_digest(const char* field_value, bool* found, uint32_t* crc);
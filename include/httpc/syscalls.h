@@ -1,6 +1,7 @@
 #pragma once
 
 #include <netdb.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/uio.h>
@@ -18,6 +19,15 @@ typedef struct {
     ssize_t (*writev) (int fd, const struct iovec* iovec, int count);
     ssize_t (*read)(int fd, void* buf, size_t count);
     int (*close)(int fd);
+    int (*poll)(struct pollfd* fds, nfds_t nfds, int timeout);
+    ssize_t (*recv)(int fd, void* buf, size_t len, int flags);
+
+    // File Syscalls
+    int (*open)(const char* path, int flags, ...);
+    int (*memfd_create)(const char* name, unsigned int flags);
+    int (*ftruncate)(int fd, off_t length);
+    void* (*mmap)(void* addr, size_t length, int prot, int flags, int fd, off_t offset);
+    int (*munmap)(void* addr, size_t length);
 
     // Memory Syscalls
     void* (*malloc)(size_t size);
@@ -25,12 +35,14 @@ typedef struct {
     void (*free)(void* ptr);
     void* (*memset)(void* s, int c, size_t n);
     void* (*memcpy)(void* dest, const void* src, size_t n);
+    void* (*memmove)(void* dest, const void* src, size_t n);
 
     // String Syscalls
     char* (*strchr)(const char* s, int c);
     char* (*strncpy) (char* d, const char* s, size_t n);
     size_t (*strlen)(const char* s);
     char* (*strstr)(const char* haystack, const char* needle);
+    void* (*memmem)(const void* haystack, size_t haystack_len, const void* needle, size_t needle_len);
     char* (*strtok_r)(char* str, const char* delim, char** saveptr);
     int (*snprintf)(char* str, size_t size, const char* format, ...);
     int (*strcasecmp)(const char* s1, const char* s2);
@@ -7,6 +7,12 @@ typedef struct {
     TransportInterface interface;
     int fd;
     const HttpcSyscalls* syscalls;
+    bool fast_open;
 } TcpClient;
 
 TransportInterface* tcp_transport_new(const HttpcSyscalls* syscalls_override);
+
+// Opt-in TCP Fast Open (TCP_FASTOPEN_CONNECT) for subsequent connects: the first write carries
+// the request in the SYN once the kernel holds a cookie for the server. Without kernel support
+// connect falls back to the ordinary handshake. A refused connection then fails the first write.
+Error tcp_transport_set_fast_open(TransportInterface* transport, bool enabled);
@@ -13,4 +13,9 @@ typedef struct {
     Error (*read)(void* context, void* buffer, size_t len, ssize_t* bytes_read);
     Error (*close)(void* context);
     void (*destroy)(void* context);
+    // Optional: true when an idle connection was closed or reset by the peer. Must not block.
+    bool (*is_stale)(void* context);
+    // Optional: like `read`, but blocks until all `len` bytes have arrived unless the peer closes
+    // first, so a body of known length takes one call rather than one per segment.
+    Error (*read_all)(void* context, void* buffer, size_t len, ssize_t* bytes_read);
 } TransportInterface;
\ No newline at end of file
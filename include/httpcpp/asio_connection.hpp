@@ -0,0 +1,152 @@
+#pragma once
+
+#include <httpcpp/asio_transport.hpp>
+#include <httpcpp/http1_protocol.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/write.hpp>
+
+#include <algorithm>
+#include <array>
+#include <expected>
+#include <span>
+#include <string_view>
+
+namespace httpcpp {
+
+    // HTTP/1.1 driven by a Boost.Asio event loop: the request is sent with async_write and the
+    // response collected with async_read_some on the socket's executor, so any number of
+    // connections share the application's io_context instead of a blocking thread each.
+    //
+    // A connection carries one request at a time; the next may be started from the previous
+    // one's completion. Serialization and parsing are Http1Protocol's, fed one read at a time
+    // through its incremental interface, so `Protocol`'s policies, body layout, spill policy and
+    // size prediction apply as they do to the blocking client. Configure them via protocol().
+    template<typename Socket, typename Protocol = Http1Protocol<AsioTransport<Socket>>>
+    class AsioHttpConnection {
+    public:
+        using Result = std::expected<SafeHttpResponse, Error>;
+
+        explicit AsioHttpConnection(Socket socket) {
+            protocol_.transport().adopt(std::move(socket));
+        }
+
+        // Operations in flight refer to the connection, so it stays where it was created.
+        AsioHttpConnection(const AsioHttpConnection&) = delete;
+        AsioHttpConnection& operator=(const AsioHttpConnection&) = delete;
+        AsioHttpConnection(AsioHttpConnection&&) = delete;
+        AsioHttpConnection& operator=(AsioHttpConnection&&) = delete;
+
+        [[nodiscard]] auto socket() noexcept -> Socket& {
+            return *protocol_.transport().socket();
+        }
+
+        [[nodiscard]] auto protocol() noexcept -> Protocol& {
+            return protocol_;
+        }
+
+        // Completes with `void(std::expected<SafeHttpResponse, Error>)` through any completion
+        // token: a callback, use_future, use_awaitable, deferred. The request line and headers
+        // are copied when this is called; a POST body is written from `request.body` in place
+        // and must stay valid until completion.
+        template<typename CompletionToken>
+        auto async_request(const HttpRequest& request, CompletionToken&& token) {
+            head_ = protocol_.serialize_request_head(request);
+            body_ = request.method == HttpMethod::Post ? request.body : std::span<const std::byte>{};
+            return boost::asio::async_compose<CompletionToken, void(Result)>(
+                RequestOp{*this}, token, socket());
+        }
+
+    private:
+        struct RequestOp {
+            AsioHttpConnection& connection;
+            enum class Step { Start, Write, Read } step = Step::Start;
+
+            template<typename Self>
+            void operator()(Self& self, boost::system::error_code ec = {}, size_t transferred = 0) {
+                AsioHttpConnection& c = connection;
+                switch (step) {
+                    case Step::Start: {
+                        step = Step::Write;
+                        const std::array<boost::asio::const_buffer, 2> buffers{
+                            boost::asio::const_buffer(c.head_.data(), c.head_.size()),
+                            boost::asio::const_buffer(c.body_.data(), c.body_.size()),
+                        };
+                        boost::asio::async_write(c.socket(), buffers, std::move(self));
+                        return;
+                    }
+                    case Step::Write:
+                        if (ec) {
+                            c.close();
+                            self.complete(std::unexpected(Error{TransportError::SocketWriteFailure}));
+                            return;
+                        }
+                        c.protocol_.begin_response();
+                        step = Step::Read;
+                        break;
+                    case Step::Read: {
+                        auto complete = c.protocol_.advance_response(to_read_result(ec, transferred));
+                        if (!complete) {
+                            c.close();
+                            self.complete(std::unexpected(complete.error()));
+                            return;
+                        }
+                        if (*complete) {
+                            self.complete(c.take_response());
+                            return;
+                        }
+                        break;
+                    }
+                }
+
+                const std::span<std::byte> window = c.protocol_.response_window();
+                c.socket().async_read_some(boost::asio::buffer(window.data(), window.size()), std::move(self));
+            }
+        };
+
+        // A read's outcome as AsioTransport::read reports it.
+        [[nodiscard]] static auto to_read_result(boost::system::error_code ec, size_t transferred) noexcept
+            -> std::expected<size_t, TransportError> {
+            if (ec == boost::asio::error::eof) {
+                return std::unexpected(TransportError::ConnectionClosed);
+            }
+            if (ec) {
+                return std::unexpected(TransportError::SocketReadFailure);
+            }
+            return transferred;
+        }
+
+        // A response framed by the end of the connection, or announcing its end, leaves nothing
+        // to reuse.
+        [[nodiscard]] auto take_response() -> Result {
+            auto response = protocol_.response_safe();
+            if (!response || !response->content_length || announces_close(*response)) {
+                close();
+            }
+            return response;
+        }
+
+        [[nodiscard]] static auto announces_close(const SafeHttpResponse& response) noexcept -> bool {
+            return std::ranges::any_of(response.headers, [](const HttpOwnedHeader& header) {
+                return iequals(header.first, "connection") && iequals(std::string_view(header.second).substr(0, 5), "close");
+            });
+        }
+
+        void close() noexcept {
+            (void)protocol_.transport().close();
+        }
+
+        [[nodiscard]] static auto iequals(std::string_view a, std::string_view lowercase) noexcept -> bool {
+            return a.size() == lowercase.size() && std::equal(a.begin(), a.end(), lowercase.begin(), [](char x, char y) {
+                return (x >= 'A' && x <= 'Z' ? static_cast<char>(x - 'A' + 'a') : x) == y;
+            });
+        }
+
+        Protocol protocol_;
+        std::span<const std::byte> head_;
+        std::span<const std::byte> body_;
+    };
+
+} // namespace httpcpp
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <httpcpp/transport.hpp>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/write.hpp>
+
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace httpcpp {
+
+    // A Transport over a Boost.Asio stream socket (ip::tcp or local::stream_protocol) owned by an
+    // application that already runs io_contexts. The socket is adopted, usually already
+    // connected, and driven with Asio's blocking calls, so it can be handed to the synchronous
+    // engine (Http1Protocol, TlsTransport) on whichever thread runs it. For requests issued from
+    // inside the event loop itself, see AsioHttpConnection.
+    //
+    // connect() reconnects the adopted socket, which supplies the executor; without one it fails.
+    template<typename Socket>
+    class AsioTransport {
+    public:
+        AsioTransport() noexcept = default;
+
+        explicit AsioTransport(Socket socket) noexcept : socket_(std::move(socket)) {}
+
+        void adopt(Socket socket) noexcept {
+            socket_.emplace(std::move(socket));
+        }
+
+        // The adopted socket; empty before adopt().
+        [[nodiscard]] auto socket() noexcept -> std::optional<Socket>& {
+            return socket_;
+        }
+
+        [[nodiscard]] auto connect(const char* host, uint16_t port) noexcept -> std::expected<void, TransportError> {
+            if (!socket_) {
+                return std::unexpected(TransportError::InitFailure);
+            }
+            boost::system::error_code ec;
+            socket_->close(ec);
+            if constexpr (std::is_same_v<typename Socket::protocol_type, boost::asio::ip::tcp>) {
+                boost::asio::ip::tcp::resolver resolver(socket_->get_executor());
+                auto endpoints = resolver.resolve(host, std::to_string(port), ec);
+                if (ec) {
+                    return std::unexpected(TransportError::DnsFailure);
+                }
+                boost::asio::connect(*socket_, endpoints, ec);
+                if (ec) {
+                    return std::unexpected(TransportError::SocketConnectFailure);
+                }
+                socket_->set_option(boost::asio::ip::tcp::no_delay(true), ec);
+            } else {
+                // As with UnixTransport, `host` is the socket path and the port is ignored.
+                socket_->connect(typename Socket::endpoint_type(host), ec);
+                if (ec) {
+                    return std::unexpected(TransportError::SocketConnectFailure);
+                }
+            }
+            return {};
+        }
+
+        [[nodiscard]] auto close() noexcept -> std::expected<void, TransportError> {
+            if (!socket_ || !socket_->is_open()) {
+                return {};
+            }
+            boost::system::error_code ec;
+            socket_->close(ec);
+            if (ec) {
+                return std::unexpected(TransportError::SocketCloseFailure);
+            }
+            return {};
+        }
+
+        [[nodiscard]] auto write(std::span<const std::byte> data) noexcept -> std::expected<size_t, TransportError> {
+            if (!socket_) {
+                return std::unexpected(TransportError::SocketWriteFailure);
+            }
+            boost::system::error_code ec;
+            const size_t written = socket_->write_some(boost::asio::buffer(data.data(), data.size()), ec);
+            if (ec) {
+                return std::unexpected(TransportError::SocketWriteFailure);
+            }
+            return written;
+        }
+
+        // One composed write over all buffers; Asio gathers them into sendmsg calls.
+        [[nodiscard]] auto write_vectored(std::span<const std::span<const std::byte>> buffers) noexcept
+            -> std::expected<size_t, TransportError> {
+            if (!socket_) {
+                return std::unexpected(TransportError::SocketWriteFailure);
+            }
+            gather_.clear();
+            for (const auto& part : buffers) {
+                gather_.emplace_back(part.data(), part.size());
+            }
+            boost::system::error_code ec;
+            const size_t written = boost::asio::write(*socket_, gather_, ec);
+            if (ec) {
+                return std::unexpected(TransportError::SocketWriteFailure);
+            }
+            return written;
+        }
+
+        [[nodiscard]] auto read(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError> {
+            if (!socket_) {
+                return std::unexpected(TransportError::SocketReadFailure);
+            }
+            boost::system::error_code ec;
+            const size_t bytes_read = socket_->read_some(boost::asio::buffer(buffer.data(), buffer.size()), ec);
+            if (ec == boost::asio::error::eof) {
+                return std::unexpected(TransportError::ConnectionClosed);
+            }
+            if (ec) {
+                return std::unexpected(TransportError::SocketReadFailure);
+            }
+            return bytes_read;
+        }
+
+        // The connected socket, or -1.
+        [[nodiscard]] auto native_handle() noexcept -> int {
+            return socket_ && socket_->is_open() ? socket_->native_handle() : -1;
+        }
+
+    private:
+        std::optional<Socket> socket_;
+        std::vector<boost::asio::const_buffer> gather_;
+    };
+
+    static_assert(VectoredWriteTransport<AsioTransport<boost::asio::ip::tcp::socket>>);
+    static_assert(SocketTransport<AsioTransport<boost::asio::ip::tcp::socket>>);
+    static_assert(SocketTransport<AsioTransport<boost::asio::local::stream_protocol::socket>>);
+
+} // namespace httpcpp
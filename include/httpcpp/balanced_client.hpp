@@ -0,0 +1,222 @@
+#pragma once
+
+#include <httpcpp/httpcpp.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace httpcpp {
+
+    // One replica of an upstream: a host and port, or a socket path (port ignored) for UnixTransport.
+    struct Endpoint {
+        std::string host;
+        uint16_t port = 0;
+    };
+
+    enum class BalancePolicy {
+        // Sample two endpoints at random and send to the cheaper one, where cost is the EWMA
+        // latency scaled by the requests already outstanding on it. Endpoints without a latency
+        // sample yet cost nothing, so every replica gets probed early.
+        PowerOfTwoChoices,
+        // Hash the request path onto a ring of virtual nodes, so a path keeps going to the same
+        // replica (and its cache) and only ~1/N of the paths move when the endpoint set changes.
+        ConsistentHash,
+        // Rotate through the endpoints; the baseline the other policies are measured against.
+        RoundRobin,
+    };
+
+    struct EndpointStats {
+        size_t requests = 0;
+        size_t outstanding = 0;
+        uint64_t ewma_latency_ns = 0;
+    };
+
+    // A client for several replicas of one upstream. Each endpoint gets its own connection (an
+    // HttpClient<P>) and every request picks one according to the BalancePolicy. Requests may be
+    // issued from several threads at once: a connection carries one request at a time, and the
+    // requests waiting for it count as outstanding. Only owning responses are offered, because a
+    // connection's buffer is reused by the next request as soon as its lock is released.
+    template<HttpProtocol P>
+    class BalancedHttpClient {
+    public:
+        // get_safe() may be called from several threads at once (see ConcurrentGetClient).
+        static constexpr bool concurrent_get_safe = true;
+
+        explicit BalancedHttpClient(BalancePolicy policy = BalancePolicy::PowerOfTwoChoices) noexcept
+            : policy_(policy) {}
+
+        BalancedHttpClient(const BalancedHttpClient&) = delete;
+        BalancedHttpClient& operator=(const BalancedHttpClient&) = delete;
+        BalancedHttpClient(BalancedHttpClient&&) = delete;
+        BalancedHttpClient& operator=(BalancedHttpClient&&) = delete;
+
+        // Connects to every endpoint; on failure no connection is kept. Not thread-safe with
+        // respect to requests in flight.
+        [[nodiscard]] auto connect(std::span<const Endpoint> endpoints) noexcept -> std::expected<void, Error> {
+            slots_.clear();
+            ring_.clear();
+            if (endpoints.empty()) {
+                return std::unexpected(HttpClientError::InvalidRequest);
+            }
+            for (const auto& endpoint : endpoints) {
+                auto slot = std::make_unique<Slot>();
+                slot->endpoint = endpoint;
+                if (auto connected = slot->client.connect(endpoint.host.c_str(), endpoint.port); !connected) {
+                    slots_.clear();
+                    return connected;
+                }
+                slots_.push_back(std::move(slot));
+            }
+            build_ring();
+            return {};
+        }
+
+        [[nodiscard]] auto disconnect() noexcept -> std::expected<void, Error> {
+            std::expected<void, Error> result;
+            for (auto& slot : slots_) {
+                std::lock_guard lock(slot->mutex);
+                if (auto closed = slot->client.disconnect(); !closed && result) {
+                    result = closed;
+                }
+            }
+            return result;
+        }
+
+        [[nodiscard]] auto get_safe(HttpRequest& request) noexcept -> std::expected<SafeHttpResponse, Error> {
+            return perform(request, [](HttpClient<P>& client, HttpRequest& req) { return client.get_safe(req); });
+        }
+
+        [[nodiscard]] auto post_safe(HttpRequest& request) noexcept -> std::expected<SafeHttpResponse, Error> {
+            return perform(request, [](HttpClient<P>& client, HttpRequest& req) { return client.post_safe(req); });
+        }
+
+        // Per-endpoint counters, in the order the endpoints were passed to connect().
+        [[nodiscard]] auto endpoint_stats() const noexcept -> std::vector<EndpointStats> {
+            std::vector<EndpointStats> stats;
+            stats.reserve(slots_.size());
+            for (const auto& slot : slots_) {
+                stats.push_back({
+                    .requests = slot->requests.load(std::memory_order_relaxed),
+                    .outstanding = slot->outstanding.load(std::memory_order_relaxed),
+                    .ewma_latency_ns = slot->ewma_latency_ns.load(std::memory_order_relaxed),
+                });
+            }
+            return stats;
+        }
+
+    private:
+        struct Slot {
+            Endpoint endpoint;
+            HttpClient<P> client;
+            std::mutex mutex;
+            std::atomic<size_t> requests{0};
+            std::atomic<size_t> outstanding{0};
+            std::atomic<uint64_t> ewma_latency_ns{0};
+        };
+
+        template<typename Send>
+        [[nodiscard]] auto perform(HttpRequest& request, Send send) noexcept -> std::expected<SafeHttpResponse, Error> {
+            if (slots_.empty()) {
+                return std::unexpected(TransportError::SocketWriteFailure);
+            }
+            Slot& slot = *slots_[pick(request)];
+            slot.outstanding.fetch_add(1, std::memory_order_relaxed);
+
+            std::unique_lock lock(slot.mutex);
+            const auto start = std::chrono::steady_clock::now();
+            auto response = send(slot.client, request);
+            const auto latency = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            record_latency(slot, latency);
+            lock.unlock();
+
+            slot.outstanding.fetch_sub(1, std::memory_order_relaxed);
+            slot.requests.fetch_add(1, std::memory_order_relaxed);
+            return response;
+        }
+
+        [[nodiscard]] auto pick(const HttpRequest& request) noexcept -> size_t {
+            const size_t n = slots_.size();
+            if (n == 1) {
+                return 0;
+            }
+            switch (policy_) {
+                case BalancePolicy::ConsistentHash: {
+                    const uint64_t key = hash(request.path);
+                    auto it = std::lower_bound(ring_.begin(), ring_.end(), key,
+                        [](const std::pair<uint64_t, size_t>& node, uint64_t k) { return node.first < k; });
+                    return it == ring_.end() ? ring_.front().second : it->second;
+                }
+                case BalancePolicy::RoundRobin:
+                    return next_.fetch_add(1, std::memory_order_relaxed) % n;
+                case BalancePolicy::PowerOfTwoChoices:
+                    break;
+            }
+
+            thread_local std::minstd_rand rng{std::random_device{}()};
+            const size_t a = rng() % n;
+            size_t b = rng() % (n - 1);
+            if (b >= a) {
+                ++b;
+            }
+            return cost(*slots_[b]) < cost(*slots_[a]) ? b : a;
+        }
+
+        [[nodiscard]] static auto cost(const Slot& slot) noexcept -> double {
+            const auto outstanding = static_cast<double>(slot.outstanding.load(std::memory_order_relaxed));
+            const auto latency = static_cast<double>(slot.ewma_latency_ns.load(std::memory_order_relaxed));
+            // The outstanding count breaks ties between endpoints that have no latency sample yet.
+            return latency * (outstanding + 1) + outstanding;
+        }
+
+        // Runs under the slot's lock, so updates never race each other; readers see either value.
+        static void record_latency(Slot& slot, uint64_t latency_ns) noexcept {
+            const uint64_t previous = slot.ewma_latency_ns.load(std::memory_order_relaxed);
+            const uint64_t next = previous == 0 ? latency_ns
+                : previous - previous / EWMA_DIVISOR_ + latency_ns / EWMA_DIVISOR_;
+            slot.ewma_latency_ns.store(std::max<uint64_t>(next, 1), std::memory_order_relaxed);
+        }
+
+        // FNV-1a with a final avalanche step, so similar paths still land far apart on the ring.
+        [[nodiscard]] static auto hash(std::string_view key) noexcept -> uint64_t {
+            uint64_t h = 0xcbf29ce484222325ull;
+            for (char c : key) {
+                h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+            }
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            return h;
+        }
+
+        void build_ring() {
+            ring_.reserve(slots_.size() * VIRTUAL_NODES_);
+            for (size_t i = 0; i < slots_.size(); ++i) {
+                const std::string name = slots_[i]->endpoint.host + ":" + std::to_string(slots_[i]->endpoint.port) + "#";
+                for (size_t v = 0; v < VIRTUAL_NODES_; ++v) {
+                    ring_.emplace_back(hash(name + std::to_string(v)), i);
+                }
+            }
+            std::sort(ring_.begin(), ring_.end());
+        }
+
+        static constexpr uint64_t EWMA_DIVISOR_ = 8;
+        static constexpr size_t VIRTUAL_NODES_ = 64;
+
+        BalancePolicy policy_;
+        std::vector<std::unique_ptr<Slot>> slots_;
+        std::vector<std::pair<uint64_t, size_t>> ring_;
+        std::atomic<size_t> next_{0};
+    };
+
+} // namespace httpcpp
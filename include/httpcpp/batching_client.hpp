@@ -0,0 +1,226 @@
+#pragma once
+
+#include <httpcpp/httpcpp.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace httpcpp {
+
+    enum class BatchFraming {
+        // Every body is preceded by its length as a 4-byte big-endian integer; bodies of 4 GiB or
+        // more are rejected.
+        LengthPrefixed,
+        // Every body is one line terminated by '\n'; bodies containing '\n' are rejected.
+        Ndjson,
+    };
+
+    struct BatchOptions {
+        std::string path = "/batch";
+        BatchFraming framing = BatchFraming::LengthPrefixed;
+        // A batch is sent once it holds this many bodies or bytes, or once its oldest body has
+        // waited `max_delay`, whichever comes first.
+        size_t max_items = 64;
+        size_t max_bytes = 64 * 1024;
+        std::chrono::microseconds max_delay{1000};
+    };
+
+    // What each caller of submit() receives: the response to the whole batch, shared by every
+    // body in it, and the position of the caller's body within the batch.
+    struct BatchedResponse {
+        std::shared_ptr<const SafeHttpResponse> response;
+        size_t index = 0;
+        size_t batch_size = 0;
+    };
+
+    struct BatchingStats {
+        size_t submitted = 0;
+        size_t batches = 0;
+    };
+
+    // Opt-in front-end that turns many small POSTs into one framed POST. Bodies submitted from
+    // any thread are collected by a background sender and written with one gathered write
+    // straight from the callers' buffers, so a body must stay alive until its future is ready.
+    template<HttpProtocol P>
+    class BatchingClient {
+    public:
+        explicit BatchingClient(BatchOptions options = {}) : options_(std::move(options)) {}
+
+        BatchingClient(const BatchingClient&) = delete;
+        BatchingClient& operator=(const BatchingClient&) = delete;
+        BatchingClient(BatchingClient&&) = delete;
+        BatchingClient& operator=(BatchingClient&&) = delete;
+
+        ~BatchingClient() {
+            stop_sender();
+        }
+
+        [[nodiscard]] auto connect(const char* host, uint16_t port) -> std::expected<void, Error> {
+            stop_sender();
+            if (options_.max_items == 0) {
+                return std::unexpected(HttpClientError::InvalidRequest);
+            }
+            if (auto connected = client_.connect(host, port); !connected) {
+                return connected;
+            }
+            stopping_ = false;
+            sender_ = std::thread([this] { run_sender(); });
+            return {};
+        }
+
+        // Sends whatever is still pending, then closes the connection.
+        [[nodiscard]] auto disconnect() -> std::expected<void, Error> {
+            stop_sender();
+            return client_.disconnect();
+        }
+
+        [[nodiscard]] auto submit(std::span<const std::byte> body) -> std::future<std::expected<BatchedResponse, Error>> {
+            Pending pending{body, std::chrono::steady_clock::now(), {}};
+            auto future = pending.promise.get_future();
+            if (options_.framing == BatchFraming::Ndjson && std::ranges::find(body, std::byte{'\n'}) != body.end()) {
+                pending.promise.set_value(std::unexpected(HttpClientError::InvalidRequest));
+                return future;
+            }
+            if (options_.framing == BatchFraming::LengthPrefixed && body.size() > std::numeric_limits<uint32_t>::max()) {
+                pending.promise.set_value(std::unexpected(HttpClientError::InvalidRequest));
+                return future;
+            }
+
+            std::unique_lock lock(mutex_);
+            if (!sender_.joinable() || stopping_) {
+                lock.unlock();
+                pending.promise.set_value(std::unexpected(TransportError::SocketWriteFailure));
+                return future;
+            }
+            queue_.push_back(std::move(pending));
+            queued_bytes_ += body.size();
+            ++submitted_;
+            if (queue_.size() == 1 || full()) {
+                wake_.notify_one();
+            }
+            return future;
+        }
+
+        [[nodiscard]] auto stats() const -> BatchingStats {
+            std::lock_guard lock(mutex_);
+            return {.submitted = submitted_, .batches = batches_};
+        }
+
+    private:
+        struct Pending {
+            std::span<const std::byte> body;
+            std::chrono::steady_clock::time_point queued_at;
+            std::promise<std::expected<BatchedResponse, Error>> promise;
+        };
+
+        [[nodiscard]] auto full() const noexcept -> bool {
+            return queue_.size() >= options_.max_items || queued_bytes_ >= options_.max_bytes;
+        }
+
+        void stop_sender() {
+            {
+                std::lock_guard lock(mutex_);
+                stopping_ = true;
+            }
+            wake_.notify_one();
+            if (sender_.joinable()) {
+                sender_.join();
+            }
+        }
+
+        void run_sender() {
+            std::vector<Pending> batch;
+            std::unique_lock lock(mutex_);
+            while (true) {
+                wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;
+                }
+                wake_.wait_until(lock, queue_.front().queued_at + options_.max_delay, [this] { return stopping_ || full(); });
+
+                const size_t count = std::min(queue_.size(), options_.max_items);
+                batch.assign(std::make_move_iterator(queue_.begin()), std::make_move_iterator(queue_.begin() + count));
+                queue_.erase(queue_.begin(), queue_.begin() + count);
+                queued_bytes_ = 0;
+                for (const auto& pending : queue_) {
+                    queued_bytes_ += pending.body.size();
+                }
+                ++batches_;
+
+                lock.unlock();
+                send(batch);
+                batch.clear();
+                lock.lock();
+            }
+        }
+
+        void send(std::vector<Pending>& batch) {
+            parts_.clear();
+            prefixes_.resize(batch.size());
+            size_t total = 0;
+            for (size_t i = 0; i < batch.size(); ++i) {
+                const auto body = batch[i].body;
+                if (options_.framing == BatchFraming::LengthPrefixed) {
+                    const auto length = static_cast<uint32_t>(body.size());
+                    prefixes_[i] = {std::byte(length >> 24), std::byte(length >> 16), std::byte(length >> 8), std::byte(length)};
+                    parts_.emplace_back(prefixes_[i]);
+                    parts_.emplace_back(body);
+                    total += prefixes_[i].size() + body.size();
+                } else {
+                    parts_.emplace_back(body);
+                    parts_.emplace_back(NEWLINE_);
+                    total += body.size() + NEWLINE_.size();
+                }
+            }
+
+            const std::string content_length = std::to_string(total);
+            HttpRequest request{};
+            request.path = options_.path;
+            request.headers = {
+                {"Content-Type", options_.framing == BatchFraming::Ndjson ? "application/x-ndjson" : "application/octet-stream"},
+                {"Content-Length", content_length},
+            };
+            auto response = client_.post_gather_safe(request, parts_);
+
+            if (!response) {
+                for (auto& pending : batch) {
+                    pending.promise.set_value(std::unexpected(response.error()));
+                }
+                return;
+            }
+            auto shared = std::make_shared<const SafeHttpResponse>(std::move(*response));
+            for (size_t i = 0; i < batch.size(); ++i) {
+                batch[i].promise.set_value(BatchedResponse{shared, i, batch.size()});
+            }
+        }
+
+        static constexpr std::array<std::byte, 1> NEWLINE_ = {std::byte{'\n'}};
+
+        BatchOptions options_;
+        HttpClient<P> client_;
+        std::thread sender_;
+        mutable std::mutex mutex_;
+        std::condition_variable wake_;
+        std::deque<Pending> queue_;
+        size_t queued_bytes_ = 0;
+        bool stopping_ = false;
+        size_t submitted_ = 0;
+        size_t batches_ = 0;
+        // Owned by the sender thread; reused across batches.
+        std::vector<std::span<const std::byte>> parts_;
+        std::vector<std::array<std::byte, 4>> prefixes_;
+    };
+
+} // namespace httpcpp
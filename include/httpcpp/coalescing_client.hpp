@@ -0,0 +1,136 @@
+#pragma once
+
+#include <httpcpp/http_protocol.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <concepts>
+#include <expected>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace httpcpp {
+
+    // A client whose get_safe() may be called from several threads at once. The signature alone
+    // cannot tell, so clients opt in with `static constexpr bool concurrent_get_safe = true;`, as
+    // BalancedHttpClient does. A single HttpClient carries one request at a time and does not.
+    template<typename T>
+    concept ConcurrentGetClient = T::concurrent_get_safe && requires(T client, HttpRequest& req) {
+        { client.get_safe(req) } -> std::same_as<std::expected<SafeHttpResponse, Error>>;
+    };
+
+    struct CoalescingStats {
+        size_t requests = 0;  // get() calls
+        size_t upstream = 0;  // requests actually sent
+        size_t coalesced = 0; // requests answered by another caller's in-flight request
+    };
+
+    using SharedHttpResponse = std::shared_ptr<const SafeHttpResponse>;
+
+    // Single-flight layer over a client: concurrent GETs for the same path and the same values of
+    // the selected headers share one upstream request, and every caller receives the same
+    // ref-counted response (or the same error). Nothing is cached; a GET arriving after the
+    // response came back starts a new request.
+    template<ConcurrentGetClient Client>
+    class CoalescingClient {
+    public:
+        // `key_headers` names the request headers (case-insensitive) that distinguish otherwise
+        // identical GETs, e.g. Accept or Authorization. All other headers are ignored, so
+        // callers sharing a flight get the response to the first caller's request.
+        explicit CoalescingClient(Client& upstream, std::vector<std::string> key_headers = {})
+            : upstream_(upstream), key_headers_(std::move(key_headers)) {}
+
+        CoalescingClient(const CoalescingClient&) = delete;
+        CoalescingClient& operator=(const CoalescingClient&) = delete;
+
+        [[nodiscard]] auto get(HttpRequest& request) -> std::expected<SharedHttpResponse, Error> {
+            if (!request.body.empty()) {
+                return std::unexpected(HttpClientError::InvalidRequest);
+            }
+            requests_.fetch_add(1, std::memory_order_relaxed);
+
+            std::string key = make_key(request);
+            std::promise<Result> promise;
+            std::shared_future<Result> flight;
+            {
+                std::lock_guard lock(mutex_);
+                auto [it, inserted] = in_flight_.try_emplace(key);
+                if (inserted) {
+                    it->second = promise.get_future().share();
+                } else {
+                    flight = it->second;
+                }
+            }
+            if (flight.valid()) {
+                coalesced_.fetch_add(1, std::memory_order_relaxed);
+                return flight.get();
+            }
+
+            upstream_count_.fetch_add(1, std::memory_order_relaxed);
+            Result result;
+            try {
+                auto response = upstream_.get_safe(request);
+                result = response ? Result(std::make_shared<const SafeHttpResponse>(std::move(*response)))
+                                  : Result(std::unexpect, response.error());
+            } catch (...) {
+                // Waiters rethrow what the leader threw, and later callers start a new flight.
+                land(key);
+                promise.set_exception(std::current_exception());
+                throw;
+            }
+            land(key);
+            promise.set_value(result);
+            return result;
+        }
+
+        [[nodiscard]] auto stats() const noexcept -> CoalescingStats {
+            return {
+                .requests = requests_.load(std::memory_order_relaxed),
+                .upstream = upstream_count_.load(std::memory_order_relaxed),
+                .coalesced = coalesced_.load(std::memory_order_relaxed),
+            };
+        }
+
+    private:
+        using Result = std::expected<SharedHttpResponse, Error>;
+
+        void land(const std::string& key) {
+            std::lock_guard lock(mutex_);
+            in_flight_.erase(key);
+        }
+
+        [[nodiscard]] auto make_key(const HttpRequest& request) const -> std::string {
+            std::string key(request.path);
+            for (const auto& name : key_headers_) {
+                key += '\0';
+                auto it = std::find_if(request.headers.begin(), request.headers.end(), [&](const HttpHeaderView& header) {
+                    return std::ranges::equal(header.first, name, [](char a, char b) {
+                        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+                    });
+                });
+                if (it != request.headers.end()) {
+                    // Marks the header as present, so an empty value differs from a missing header.
+                    key += '\1';
+                    key += it->second;
+                }
+            }
+            return key;
+        }
+
+        Client& upstream_;
+        std::vector<std::string> key_headers_;
+        std::mutex mutex_;
+        std::unordered_map<std::string, std::shared_future<Result>> in_flight_;
+        std::atomic<size_t> requests_{0};
+        std::atomic<size_t> upstream_count_{0};
+        std::atomic<size_t> coalesced_{0};
+    };
+
+} // namespace httpcpp
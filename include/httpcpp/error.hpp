@@ -14,6 +14,7 @@ namespace httpcpp {
         ConnectionClosed,
         SocketCloseFailure,
         InitFailure,
+        TlsHandshakeFailure,
     };
 
     enum class HttpClientError {
@@ -22,6 +23,8 @@ namespace httpcpp {
         HttpParseFailure,
         InvalidRequest,
         InitFailure,
+        IntegrityFailure,
+        SpillFailure,
     };
 
     using Error = std::variant<TransportError, HttpClientError>;
@@ -2,6 +2,10 @@
 
 #include <httpcpp/transport.hpp>
 #include <httpcpp/http_protocol.hpp>
+#include <httpcpp/integrity.hpp>
+#include <httpcpp/stream_copy.hpp>
+#include <httpcpp/spill.hpp>
+#include <httpcpp/numa.hpp>
 
 #include <vector>
 #include <cstddef>
@@ -10,10 +14,171 @@
 #include <algorithm>
 #include <charconv>
 #include <optional>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <span>
+#include <array>
+#include <limits>
 
 namespace httpcpp {
 
-    template<Transport T>
+    // Compile-time parsing policies. Work a policy opts out of is removed by `if constexpr`,
+    // so e.g. a HeadersPolicy::None instantiation contains no header-splitting code at all.
+    enum class HeadersPolicy {
+        None,        // Only framing is interpreted; `headers` is left empty.
+        FramingOnly, // `headers` contains only Content-Length / Transfer-Encoding.
+        Full,
+    };
+
+    enum class StatusPolicy {
+        CodeOnly,    // `status_message` is left empty; a missing reason phrase is accepted.
+        Full,
+    };
+
+    enum class ValidationPolicy {
+        Lenient,
+        Strict,      // Reject malformed status lines, header lines and Content-Length values.
+    };
+
+    enum class IntegrityPolicy {
+        None,
+        Crc32c,      // Checksum the body as each chunk is read; verify against `Content-Digest: crc32c=:...:`.
+    };
+
+    // Receive layout for consumers that read past the end of the body (SIMD parsers, columnar
+    // decoders). `padding` zeroed bytes are guaranteed readable after `body`, and with a non-zero
+    // `alignment` (a power of two) the body start is aligned by choosing its offset after the header
+    // block instead of copying the body afterwards. Applies to unsafe responses.
+    struct BodyLayout {
+        size_t padding = 0;
+        size_t alignment = 0;
+    };
+
+    // Handling of keep-alive connections the server closed while they sat idle. Both are off by
+    // default. `check_before_use` asks a StaleCheckingTransport whether the connection is still
+    // open before each request and reconnects up front, so the common case never sees an error.
+    // `retry_idempotent` covers the race the check cannot: a GET whose connection drops before
+    // any response byte arrives is sent once more on a fresh connection. POSTs are never retried.
+    struct ReconnectPolicy {
+        bool check_before_use = false;
+        bool retry_idempotent = false;
+    };
+
+    // How the rest of a body is received once the headers have given its length. `Incremental`
+    // takes whatever has arrived, bounded by the spare capacity. `WaitAll` reserves the exact
+    // remainder and has an ExactReadTransport block until all of it is in, so a large body costs one
+    // read call rather than one per segment; other transports keep reading incrementally.
+    enum class ReceiveStrategy {
+        Incremental,
+        WaitAll,
+    };
+
+    // A prediction is a hit when the response fit in the buffer reserved for it, i.e. it was read
+    // without regrowing the buffer.
+    struct SizePredictionStats {
+        size_t predictions = 0;
+        size_t hits = 0;
+    };
+
+    // Estimates the size of the next response on a connection from an exponentially weighted moving
+    // average of recent sizes and of their mean deviation (the estimator TCP uses for round-trip
+    // times), so the receive buffer can be reserved and the first read sized before bytes arrive.
+    class ResponseSizePredictor {
+    public:
+        // Bytes the next response is expected to fit in; 0 until a response has been observed.
+        [[nodiscard]] auto predict() const noexcept -> size_t {
+            return samples_ == 0 ? 0 : mean_ + 2 * deviation_;
+        }
+
+        // Scores the `predicted` size against the `actual` one and folds `actual` into the averages.
+        void observe(size_t predicted, size_t actual) noexcept {
+            if (predicted > 0) {
+                ++stats_.predictions;
+                stats_.hits += actual <= predicted ? 1 : 0;
+            }
+            if (samples_++ == 0) {
+                mean_ = actual;
+                deviation_ = actual / 4;
+                return;
+            }
+            const size_t error = actual > mean_ ? actual - mean_ : mean_ - actual;
+            deviation_ = deviation_ - deviation_ / 4 + error / 4;
+            mean_ = mean_ - mean_ / 8 + actual / 8;
+        }
+
+        void reset() noexcept {
+            mean_ = 0;
+            deviation_ = 0;
+            samples_ = 0;
+        }
+
+        [[nodiscard]] auto stats() const noexcept -> SizePredictionStats {
+            return stats_;
+        }
+
+    private:
+        size_t mean_ = 0;
+        size_t deviation_ = 0;
+        size_t samples_ = 0;
+        SizePredictionStats stats_;
+    };
+
+    // The buffer a protocol serializes requests and receives responses into.
+    using ProtocolBuffer = std::vector<std::byte, numa::NodeAllocator<std::byte>>;
+
+    // Where a BodyWriter generates a request body: the protocol buffer right after the serialized
+    // head, so the body is written once, in place, and sent from there. The buffer grows as needed;
+    // regions handed out before a later prepare() or append() may move.
+    class RequestBodyBuffer {
+    public:
+        explicit RequestBodyBuffer(ProtocolBuffer& buffer) noexcept : buffer_(buffer), start_(buffer.size()) {}
+
+        // At least `bytes` writable bytes after the body written so far.
+        [[nodiscard]] auto prepare(size_t bytes) -> std::span<std::byte> {
+            commit(0);
+            const size_t end = buffer_.size();
+            buffer_.resize(end + bytes);
+            prepared_ = bytes;
+            return std::span(buffer_).subspan(end, bytes);
+        }
+
+        // Adds the first `bytes` of the region returned by the last prepare() to the body.
+        void commit(size_t bytes) noexcept {
+            buffer_.resize(buffer_.size() - prepared_ + std::min(bytes, prepared_));
+            prepared_ = 0;
+        }
+
+        void append(std::span<const std::byte> data) {
+            commit(0);
+            buffer_.insert(buffer_.end(), data.begin(), data.end());
+        }
+
+        void append(std::string_view text) {
+            append(std::as_bytes(std::span(text)));
+        }
+
+        // Bytes of body committed so far.
+        [[nodiscard]] auto size() const noexcept -> size_t {
+            return buffer_.size() - prepared_ - start_;
+        }
+
+    private:
+        ProtocolBuffer& buffer_;
+        size_t start_;
+        size_t prepared_ = 0;
+    };
+
+    // Generates a request body into a RequestBodyBuffer; an error abandons the request unsent.
+    template<typename F>
+    concept BodyWriter = std::invocable<F&, RequestBodyBuffer&> &&
+        std::same_as<std::invoke_result_t<F&, RequestBodyBuffer&>, std::expected<void, Error>>;
+
+    template<Transport T,
+             HeadersPolicy Headers = HeadersPolicy::Full,
+             StatusPolicy Status = StatusPolicy::Full,
+             ValidationPolicy Validation = ValidationPolicy::Lenient,
+             IntegrityPolicy Integrity = IntegrityPolicy::None>
     class Http1Protocol {
     public:
         Http1Protocol() noexcept = default;
@@ -24,12 +189,88 @@ namespace httpcpp {
             }
         }
 
+        [[nodiscard]] auto set_body_layout(BodyLayout layout) noexcept -> std::expected<void, Error> {
+            if ((layout.alignment & (layout.alignment - 1)) != 0) {
+                return std::unexpected(Error{HttpClientError::InvalidRequest});
+            }
+            layout_ = layout;
+            return {};
+        }
+
+        // Spilling bounds the memory a response takes only for perform_request_*_unsafe; see SpillPolicy.
+        void set_spill_policy(SpillPolicy spill) noexcept {
+            spill_ = spill;
+        }
+
+        void set_reconnect_policy(ReconnectPolicy reconnect) noexcept {
+            reconnect_ = reconnect;
+        }
+
+        void set_receive_strategy(ReceiveStrategy strategy) noexcept {
+            receive_strategy_ = strategy;
+        }
+
+        // Grows the buffer shared by serialized requests and unsafe responses to `bytes` and writes
+        // every page of it, so the first exchanges pay neither for regrowth nor for page faults.
+        void reserve_buffer(size_t bytes) noexcept {
+            buffer_.resize(std::max(bytes, buffer_.size()));
+            buffer_.clear();
+        }
+
+        // Places the buffer shared by serialized requests and unsafe responses on memory `node`
+        // (see numa::NodeAllocator), or back on the default heap for -1. Call it from the thread
+        // that services the connection, typically with numa::current_node() after
+        // numa::bind_current_thread(). The buffer is reallocated with its capacity kept, which
+        // invalidates the most recent unsafe response.
+        [[nodiscard]] auto set_numa_node(int node) noexcept -> std::expected<void, Error> {
+            if (node < -1 || node >= numa::node_count()) {
+                return std::unexpected(Error{HttpClientError::InvalidRequest});
+            }
+            try {
+                ProtocolBuffer placed{numa::NodeAllocator<std::byte>(node)};
+                placed.reserve(buffer_.capacity());
+                buffer_ = std::move(placed);
+            } catch (const std::bad_alloc&) {
+                return std::unexpected(Error{HttpClientError::InitFailure});
+            }
+            return {};
+        }
+
+        [[nodiscard]] auto numa_node() const noexcept -> int {
+            return buffer_.get_allocator().node();
+        }
+
+        // Access to transport-specific configuration (e.g. TcpTransport::set_fast_open).
+        [[nodiscard]] auto transport() noexcept -> T& {
+            return transport_;
+        }
+
+        // Number of connections re-established by the reconnect policy since construction.
+        [[nodiscard]] auto reconnect_count() const noexcept -> size_t {
+            return reconnect_count_;
+        }
+
+        // Transport read calls it took to receive the most recent response.
+        [[nodiscard]] auto read_calls() const noexcept -> size_t {
+            return read_calls_;
+        }
+
+        // How often the response-size predictor that presizes the receive buffer was right.
+        [[nodiscard]] auto size_prediction_stats() const noexcept -> SizePredictionStats {
+            return size_predictor_.stats();
+        }
+
         // --- Connection Management ---
         [[nodiscard]] auto connect(const char* host, uint16_t port) noexcept -> std::expected<void, Error> {
             auto result = transport_.connect(host, port);
             if (!result) {
                 return std::unexpected(Error{result.error()});
             }
+            if (host_ != host || port_ != port) {
+                size_predictor_.reset();
+            }
+            host_ = host;
+            port_ = port;
             return {};
         }
 
@@ -42,7 +283,228 @@ namespace httpcpp {
         }
 
         [[nodiscard]] auto perform_request_safe(const HttpRequest& req) noexcept -> std::expected<SafeHttpResponse, Error> {
-            auto unsafe_res_expected = perform_request_unsafe(req);
+            return to_safe(perform_request_unsafe(req));
+        }
+
+        // A request whose body is the concatenation of `body_parts` (`req.body` must be empty and
+        // `req.headers` must carry the total Content-Length). With a VectoredWriteTransport the
+        // head and the parts leave in one gathered write, without being copied into the buffer.
+        [[nodiscard]] auto perform_request_gather_safe(const HttpRequest& req, std::span<const std::span<const std::byte>> body_parts) noexcept
+            -> std::expected<SafeHttpResponse, Error> {
+            return to_safe(perform(req, body_parts));
+        }
+
+        [[nodiscard]] auto perform_request_gather_unsafe(const HttpRequest& req, std::span<const std::span<const std::byte>> body_parts) noexcept
+            -> std::expected<UnsafeHttpResponse, Error> {
+            return perform(req, body_parts);
+        }
+
+        [[nodiscard]] auto perform_request_unsafe(const HttpRequest& req) noexcept -> std::expected<UnsafeHttpResponse, Error> {
+            return perform(req, {});
+        }
+
+        // A request whose body is pulled from `producer` and sent with `Transfer-Encoding: chunked`,
+        // so it never has to exist in memory as a whole (`req.body` must be empty and `req.headers`
+        // must not frame the body themselves). Every chunk leaves in one write: with a
+        // VectoredWriteTransport its size line and the producer's buffers are gathered in place,
+        // otherwise they are copied into the protocol buffer. The head rides with the first chunk.
+        // Streamed requests are never retried, as the body cannot be produced twice.
+        template<BodyProducer Producer>
+        [[nodiscard]] auto perform_request_stream_safe(const HttpRequest& req, Producer& producer) noexcept
+            -> std::expected<SafeHttpResponse, Error> {
+            return to_safe(perform_request_stream_unsafe(req, producer));
+        }
+
+        template<BodyProducer Producer>
+        [[nodiscard]] auto perform_request_stream_unsafe(const HttpRequest& req, Producer& producer) noexcept
+            -> std::expected<UnsafeHttpResponse, Error> {
+            if (auto refreshed = refresh_if_stale(); !refreshed) {
+                return std::unexpected(refreshed.error());
+            }
+            build_request_string(req, BodyFraming::Chunked);
+            if (auto sent = write_chunked(producer); !sent) {
+                return std::unexpected(sent.error());
+            }
+            if (auto received = read_full_response(); !received) {
+                return std::unexpected(received.error());
+            }
+            return parse_unsafe_response();
+        }
+
+        // A POST whose body `writer` generates straight into the protocol buffer behind the head
+        // (`req.body` must be empty and `req.headers` must not frame the body themselves). The
+        // Content-Length header is written with room for any length and filled in once the body
+        // is complete; the head is then moved up against the body, so neither the body nor the
+        // header is padded and the body is never copied. Nothing is sent if `writer` fails.
+        template<BodyWriter Writer>
+        [[nodiscard]] auto perform_request_writer_safe(const HttpRequest& req, Writer& writer) noexcept
+            -> std::expected<SafeHttpResponse, Error> {
+            return to_safe(perform_request_writer_unsafe(req, writer));
+        }
+
+        template<BodyWriter Writer>
+        [[nodiscard]] auto perform_request_writer_unsafe(const HttpRequest& req, Writer& writer) noexcept
+            -> std::expected<UnsafeHttpResponse, Error> {
+            if (auto refreshed = refresh_if_stale(); !refreshed) {
+                return std::unexpected(refreshed.error());
+            }
+            build_request_string(req, BodyFraming::Backpatched);
+            const size_t body_start = buffer_.size();
+            RequestBodyBuffer body(buffer_);
+            if (auto written = writer(body); !written) {
+                return std::unexpected(written.error());
+            }
+            buffer_.resize(body_start + body.size());
+
+            // Right-align the digits in their field and close the gap in front of them.
+            std::array<char, CONTENT_LENGTH_DIGITS_> digits;
+            auto [end, ec] = std::to_chars(digits.data(), digits.data() + digits.size(), body.size());
+            const size_t digit_count = static_cast<size_t>(end - digits.data());
+            const size_t shift = CONTENT_LENGTH_DIGITS_ - digit_count;
+            std::memcpy(buffer_.data() + content_length_digits_ + shift, digits.data(), digit_count);
+            std::memmove(buffer_.data() + shift, buffer_.data(), content_length_digits_);
+
+            if (auto sent = transport_.write(std::span(buffer_).subspan(shift)); !sent) {
+                return std::unexpected(Error{sent.error()});
+            }
+            if (auto received = read_full_response(); !received) {
+                return std::unexpected(received.error());
+            }
+            return parse_unsafe_response();
+        }
+
+        // --- Incremental Use ---
+        // For drivers that do their own I/O on the transport's connection, such as an event loop
+        // (see AsioHttpConnection), with the serialization, policies, body layout, spilling and
+        // size prediction of perform_request_*. serialize_request_head() leaves the request line
+        // and headers in the protocol buffer; send them, then `req.body`. Once they are sent,
+        // begin_response() starts the response: read into response_window() and hand the outcome
+        // of each read to advance_response() until it reports the response complete, which is
+        // then returned by response_safe() or response_unsafe() as perform_request_* would have.
+        [[nodiscard]] auto serialize_request_head(const HttpRequest& req) -> std::span<const std::byte> {
+            build_request_string(req, BodyFraming::Detached);
+            return buffer_;
+        }
+
+        void begin_response() noexcept {
+            buffer_.clear();
+            header_size_ = 0;
+            body_offset_ = 0;
+            content_length_ = std::nullopt;
+            digest_ = 0;
+            digested_ = 0;
+            spill_file_.reset();
+            spilling_ = false;
+            read_calls_ = 0;
+            presized_ = false;
+
+            // Room for the predicted response up front, so it is read without regrowing the buffer.
+            predicted_ = size_predictor_.predict();
+            buffer_.reserve(predicted_);
+        }
+
+        // Where the next read goes; valid until the following advance_response().
+        [[nodiscard]] auto response_window() noexcept -> std::span<std::byte> {
+            ++read_calls_;
+            if (spilling_) {
+                wait_all_ = false;
+                const size_t want = std::min(SPILL_WINDOW_SIZE_, content_length_.value_or(SIZE_MAX) - spill_file_.size());
+                return std::span(buffer_).subspan(body_offset_, want);
+            }
+
+            window_start_ = buffer_.size();
+            // With the body length known, WaitAll asks for exactly the rest of the body at once.
+            wait_all_ = receive_strategy_ == ReceiveStrategy::WaitAll && ExactReadTransport<T> &&
+                header_size_ != 0 && content_length_.has_value();
+            if (wait_all_) {
+                buffer_.reserve(body_offset_ + *content_length_);
+            }
+            const size_t available_capacity = buffer_.capacity() - buffer_.size();
+            // `resize` zero-fills the read window, so keep it bounded: a large reserved capacity
+            // (predicted, or presized for an aligned body) must not turn every small read into a
+            // pass over the whole rest of the buffer. WaitAll's window is filled by a single read.
+            const size_t read_amount = wait_all_ ? body_offset_ + *content_length_ - window_start_
+                : presized_ && available_capacity > 0 ? std::min(available_capacity, READ_WINDOW_SIZE_)
+                : std::clamp(available_capacity, static_cast<size_t>(1024), READ_WINDOW_SIZE_);
+            buffer_.resize(window_start_ + read_amount);
+            return std::span(buffer_).subspan(window_start_, read_amount);
+        }
+
+        // Takes the number of bytes the last read put into response_window(), or the reason it
+        // failed. True once the response is complete; a closed connection completes a response
+        // that has no Content-Length.
+        [[nodiscard]] auto advance_response(std::expected<size_t, TransportError> read) noexcept -> std::expected<bool, Error> {
+            if (spilling_) {
+                return advance_spill(read);
+            }
+            if (!read) {
+                buffer_.resize(window_start_);
+                if (read.error() != TransportError::ConnectionClosed) {
+                    return std::unexpected(Error{read.error()});
+                }
+                if (content_length_.has_value() && buffer_.size() < body_offset_ + *content_length_) {
+                    return std::unexpected(Error{HttpClientError::HttpParseFailure});
+                }
+                if (auto finished = finish_response(); !finished) {
+                    return std::unexpected(finished.error());
+                }
+                return true;
+            }
+
+            buffer_.resize(window_start_ + *read);
+
+            if (header_size_ == 0) {
+                if (auto framed = parse_framing(); !framed) {
+                    return std::unexpected(framed.error());
+                }
+            }
+
+            if (header_size_ != 0 && should_spill()) {
+                if (auto started = start_spill(); !started) {
+                    return std::unexpected(started.error());
+                }
+                if (content_length_.has_value() && spill_file_.size() >= *content_length_) {
+                    return finish_spill();
+                }
+                return false;
+            }
+
+            if constexpr (Integrity == IntegrityPolicy::Crc32c) {
+                if (header_size_ != 0) {
+                    update_digest();
+                }
+            }
+
+            if (content_length_.has_value() && buffer_.size() >= body_offset_ + *content_length_) {
+                if (auto finished = finish_response(); !finished) {
+                    return std::unexpected(finished.error());
+                }
+                return true;
+            }
+            return false;
+        }
+
+        [[nodiscard]] auto response_safe() noexcept -> std::expected<SafeHttpResponse, Error> {
+            return to_safe(parse_unsafe_response());
+        }
+
+        [[nodiscard]] auto response_unsafe() noexcept -> std::expected<UnsafeHttpResponse, Error> {
+            return parse_unsafe_response();
+        }
+
+        // For testing purposes only
+        [[nodiscard]] auto get_content_length_for_test() const noexcept {
+            return content_length_;
+        }
+        [[nodiscard]] auto get_internal_buffer_ptr_for_test() const noexcept {
+            return buffer_.data();
+        }
+        [[nodiscard]] auto get_internal_buffer_capacity_for_test() const noexcept {
+            return buffer_.capacity();
+        }
+    private:
+        [[nodiscard]] static auto to_safe(std::expected<UnsafeHttpResponse, Error>&& unsafe_res_expected) noexcept
+            -> std::expected<SafeHttpResponse, Error> {
             if (!unsafe_res_expected) {
                 return std::unexpected(unsafe_res_expected.error());
             }
@@ -51,7 +513,8 @@ namespace httpcpp {
             SafeHttpResponse safe_res;
             safe_res.status_code = unsafe_res.status_code;
             safe_res.status_message = std::string(unsafe_res.status_message);
-            safe_res.body = std::vector<std::byte>(unsafe_res.body.begin(), unsafe_res.body.end());
+            safe_res.body.resize(unsafe_res.body.size());
+            copy_bytes(safe_res.body.data(), unsafe_res.body.data(), unsafe_res.body.size());
             safe_res.content_length = unsafe_res.content_length;
             safe_res.headers.reserve(unsafe_res.headers.size());
             for (const auto& header_view : unsafe_res.headers) {
@@ -64,29 +527,158 @@ namespace httpcpp {
             return safe_res;
         }
 
-        [[nodiscard]] auto perform_request_unsafe(const HttpRequest& req) noexcept -> std::expected<UnsafeHttpResponse, Error> {
+        [[nodiscard]] auto perform(const HttpRequest& req, std::span<const std::span<const std::byte>> body_parts) noexcept
+            -> std::expected<UnsafeHttpResponse, Error> {
+            if (auto refreshed = refresh_if_stale(); !refreshed) {
+                return std::unexpected(refreshed.error());
+            }
+
             build_request_string(req);
 
-            if (auto write_res = transport_.write(buffer_); !write_res) {
-                return std::unexpected(Error{write_res.error()});
+            bool dropped = false;
+            auto exchanged = exchange(body_parts, dropped);
+            if (dropped && reconnect_.retry_idempotent && req.method == HttpMethod::Get && !host_.empty()) {
+                if (auto reconnected = reconnect(); !reconnected) {
+                    return std::unexpected(reconnected.error());
+                }
+                build_request_string(req);
+                exchanged = exchange(body_parts, dropped);
             }
-
-            if (auto read_res = read_full_response(); !read_res) {
-                return std::unexpected(read_res.error());
+            if (!exchanged) {
+                return std::unexpected(exchanged.error());
             }
 
             return parse_unsafe_response();
         }
 
-        // For testing purposes only
-        [[nodiscard]] auto get_content_length_for_test() const noexcept {
-            return content_length_;
+        // Applies ReconnectPolicy::check_before_use.
+        [[nodiscard]] auto refresh_if_stale() noexcept -> std::expected<void, Error> {
+            if constexpr (StaleCheckingTransport<T>) {
+                if (reconnect_.check_before_use && !host_.empty() && transport_.is_stale()) {
+                    return reconnect();
+                }
+            }
+            return {};
         }
-        [[nodiscard]] auto get_internal_buffer_ptr_for_test() const noexcept {
-            return buffer_.data();
+
+        [[nodiscard]] auto reconnect() noexcept -> std::expected<void, Error> {
+            (void)transport_.close();
+            if (auto result = transport_.connect(host_.c_str(), port_); !result) {
+                return std::unexpected(Error{result.error()});
+            }
+            ++reconnect_count_;
+            return {};
         }
-    private:
-        void build_request_string(const HttpRequest& req) {
+
+        // Sends the request held in `buffer_` (plus any gathered body) and reads the response into it. `dropped` is set when
+        // the connection failed before a single response byte arrived, which is what a connection
+        // the server already closed looks like; the request cannot have been processed then.
+        [[nodiscard]] auto exchange(std::span<const std::span<const std::byte>> body_parts, bool& dropped) noexcept
+            -> std::expected<void, Error> {
+            if (auto write_res = write_request(body_parts); !write_res) {
+                dropped = true;
+                return std::unexpected(Error{write_res.error()});
+            }
+            auto read_res = read_full_response();
+            dropped = header_size_ == 0 && buffer_.empty();
+            return read_res;
+        }
+
+        // Sends the head in `buffer_` followed by `body_parts`.
+        [[nodiscard]] auto write_request(std::span<const std::span<const std::byte>> body_parts) noexcept
+            -> std::expected<size_t, TransportError> {
+            if (body_parts.empty()) {
+                return transport_.write(buffer_);
+            }
+            if constexpr (VectoredWriteTransport<T>) {
+                gather_.clear();
+                gather_.emplace_back(buffer_);
+                gather_.insert(gather_.end(), body_parts.begin(), body_parts.end());
+                return transport_.write_vectored(gather_);
+            } else {
+                for (const auto& part : body_parts) {
+                    buffer_.insert(buffer_.end(), part.begin(), part.end());
+                }
+                return transport_.write(buffer_);
+            }
+        }
+
+        // Sends the head in `buffer_` with the first chunk pulled from `producer`, then the rest.
+        // The CRLF closing a chunk is sent in front of the next size line, so each write carries
+        // exactly one framing buffer; the last one also closes the body with the zero-size chunk.
+        template<typename Producer>
+        [[nodiscard]] auto write_chunked(Producer& producer) noexcept -> std::expected<void, Error> {
+            bool first = true;
+            while (true) {
+                auto chunk = producer();
+                if (!chunk) {
+                    // Part of the body is on the wire; the connection cannot carry another request.
+                    if (!first) {
+                        (void)transport_.close();
+                    }
+                    return std::unexpected(chunk.error());
+                }
+                size_t chunk_size = 0;
+                for (const auto& part : *chunk) {
+                    chunk_size += part.size();
+                }
+
+                // "\r\n" + hex size + "\r\n", or + "\r\n\r\n" for the zero-size chunk that ends the body.
+                size_t framing_size = 0;
+                if (!first) {
+                    chunk_framing_[framing_size++] = '\r';
+                    chunk_framing_[framing_size++] = '\n';
+                }
+                auto [end, ec] = std::to_chars(chunk_framing_.data() + framing_size,
+                                               chunk_framing_.data() + chunk_framing_.size(), chunk_size, 16);
+                framing_size = static_cast<size_t>(end - chunk_framing_.data());
+                for (char c : chunk_size == 0 ? std::string_view("\r\n\r\n") : std::string_view("\r\n")) {
+                    chunk_framing_[framing_size++] = c;
+                }
+                const auto framing = std::as_bytes(std::span(chunk_framing_.data(), framing_size));
+
+                std::expected<size_t, TransportError> written;
+                if constexpr (VectoredWriteTransport<T>) {
+                    gather_.clear();
+                    if (first) {
+                        gather_.emplace_back(buffer_);
+                    }
+                    gather_.push_back(framing);
+                    for (const auto& part : *chunk) {
+                        if (!part.empty()) {
+                            gather_.push_back(part);
+                        }
+                    }
+                    written = transport_.write_vectored(gather_);
+                } else {
+                    if (!first) {
+                        buffer_.clear();
+                    }
+                    buffer_.insert(buffer_.end(), framing.begin(), framing.end());
+                    for (const auto& part : *chunk) {
+                        buffer_.insert(buffer_.end(), part.begin(), part.end());
+                    }
+                    written = transport_.write(buffer_);
+                }
+                if (!written) {
+                    return std::unexpected(Error{written.error()});
+                }
+                if (chunk_size == 0) {
+                    return {};
+                }
+                first = false;
+            }
+        }
+
+        // How build_request_string frames the body beyond the caller's headers.
+        enum class BodyFraming {
+            Inline,      // The caller's headers frame `req.body`.
+            Detached,    // As Inline, but `req.body` is left for the caller to send after the head.
+            Chunked,     // Transfer-Encoding: chunked; the body follows in chunks.
+            Backpatched, // Content-Length with CONTENT_LENGTH_DIGITS_ blank digits at `content_length_digits_`.
+        };
+
+        void build_request_string(const HttpRequest& req, BodyFraming framing = BodyFraming::Inline) {
             buffer_.clear();
 
             // Helper lambda to efficiently append string views to our byte vector.
@@ -111,93 +703,264 @@ namespace httpcpp {
                 append("\r\n");
             }
 
+            if (framing == BodyFraming::Chunked) {
+                append("Transfer-Encoding: chunked\r\n");
+            } else if (framing == BodyFraming::Backpatched) {
+                append("Content-Length: ");
+                content_length_digits_ = buffer_.size();
+                buffer_.resize(buffer_.size() + CONTENT_LENGTH_DIGITS_);
+                append("\r\n");
+            }
+
             // 3. End of Headers
             append("\r\n");
 
             // 4. Body
-            if (!req.body.empty() && req.method == HttpMethod::Post) {
+            if (framing != BodyFraming::Detached && !req.body.empty() && req.method == HttpMethod::Post) {
                 buffer_.insert(buffer_.end(), req.body.begin(), req.body.end());
             }
         }
 
         [[nodiscard]] auto read_full_response() noexcept -> std::expected<void, Error> {
-            buffer_.clear();
-            header_size_ = 0;
-            content_length_ = std::nullopt;
-
+            begin_response();
             while (true) {
-                const size_t available_capacity = buffer_.capacity() - buffer_.size();
-                const size_t read_amount = std::max(available_capacity, static_cast<size_t>(1024));
-                const size_t old_size = buffer_.size();
-                buffer_.resize(old_size + read_amount);
-
-                std::span<std::byte> write_area(buffer_.data() + old_size, read_amount);
+                const std::span<std::byte> window = response_window();
+                auto read_result = [&] {
+                    if constexpr (ExactReadTransport<T>) {
+                        if (wait_all_) {
+                            return transport_.read_exact(window);
+                        }
+                    }
+                    return transport_.read(window);
+                }();
+                auto complete = advance_response(read_result);
+                if (!complete) {
+                    return std::unexpected(complete.error());
+                }
+                if (*complete) {
+                    return {};
+                }
+            }
+        }
 
-                auto read_result = transport_.read(write_area);
+        // Finds the end of the header block in what has arrived, takes the body's framing from it
+        // and picks the body offset the layout asks for.
+        [[nodiscard]] auto parse_framing() noexcept -> std::expected<void, Error> {
+            auto it = std::search(
+                buffer_.begin(), buffer_.end(),
+                HEADER_SEPARATOR_.begin(), HEADER_SEPARATOR_.end(),
+                [](std::byte b, char c) {
+                    return static_cast<unsigned char>(b) == static_cast<unsigned char>(c);
+                }
+            );
+            if (it == buffer_.end()) {
+                return {};
+            }
+            header_size_ = std::distance(buffer_.begin(), it) + HEADER_SEPARATOR_.size();
+            std::string_view headers_view(reinterpret_cast<const char*>(buffer_.data()), header_size_);
 
-                if (!read_result) {
-                    buffer_.resize(old_size);
-                    if (read_result.error() == TransportError::ConnectionClosed) {
-                        if (content_length_.has_value() && buffer_.size() < header_size_ + *content_length_) {
+            size_t line_start = headers_view.find("\r\n") + 2;
+            while (line_start < headers_view.size()) {
+                size_t line_end = headers_view.find("\r\n", line_start);
+                std::string_view line = headers_view.substr(line_start, line_end - line_start);
+                if (line.empty()) break;
+                if (line.size() >= 15 &&
+                    std::equal(line.begin(), line.begin() + 15,
+                        HEADER_SEPARATOR_CL.begin(), HEADER_SEPARATOR_CL.end(),
+                        [](char a, char b) { return std::tolower(a) == std::tolower(b); })
+                ) {
+                    auto value_sv = line.substr(15);
+                    value_sv.remove_prefix(std::min(value_sv.find_first_not_of(" \t"), value_sv.size()));
+                    size_t length = 0;
+                    auto [ptr, ec] = std::from_chars(value_sv.data(), value_sv.data() + value_sv.size(), length);
+                    if constexpr (Validation == ValidationPolicy::Strict) {
+                        auto rest = value_sv.substr(ptr - value_sv.data());
+                        if (ec != std::errc() || rest.find_first_not_of(" \t") != std::string_view::npos) {
                             return std::unexpected(Error{HttpClientError::HttpParseFailure});
                         }
-                        break;
                     }
-                    return std::unexpected(Error{read_result.error()});
+                    if (ec == std::errc()) {
+                        content_length_ = length;
+                    }
+                    break;
                 }
+                if (line_end == std::string_view::npos) break;
+                line_start = line_end + 2;
+            }
 
-                buffer_.resize(old_size + *read_result);
+            body_offset_ = header_size_;
+            if (layout_.alignment > 0 && content_length_.has_value() && !should_spill()) {
+                // Size the buffer once so the body start chosen here stays aligned.
+                buffer_.reserve(header_size_ + layout_.alignment + *content_length_ + layout_.padding);
+                const size_t gap = alignment_gap();
+                buffer_.insert(buffer_.begin() + header_size_, gap, std::byte{0});
+                body_offset_ = header_size_ + gap;
+                presized_ = true;
+            }
+            return {};
+        }
 
-                if (header_size_ == 0) {
-                    auto it = std::search(
-                        buffer_.begin(), buffer_.end(),
-                        HEADER_SEPARATOR_.begin(), HEADER_SEPARATOR_.end(),
-                        [](std::byte b, char c) {
-                            return static_cast<unsigned char>(b) == static_cast<unsigned char>(c);
-                        }
-                    );
-                    if (it != buffer_.end()) {
-                        header_size_ = std::distance(buffer_.begin(), it) + HEADER_SEPARATOR_.size();
-                        std::string_view headers_view(reinterpret_cast<const char*>(buffer_.data()), header_size_);
-
-                        size_t line_start = headers_view.find("\r\n") + 2;
-                        while (line_start < headers_view.size()) {
-                            size_t line_end = headers_view.find("\r\n", line_start);
-                            std::string_view line = headers_view.substr(line_start, line_end - line_start);
-                            if (line.empty()) break;
-                            if (line.size() >= 15 &&
-                                std::equal(line.begin(), line.begin() + 15,
-                                    HEADER_SEPARATOR_CL.begin(), HEADER_SEPARATOR_CL.end(),
-                                    [](char a, char b) { return std::tolower(a) == std::tolower(b); })
-                            ) {
-                                auto value_sv = line.substr(15);
-                                value_sv.remove_prefix(std::min(value_sv.find_first_not_of(" \t"), value_sv.size()));
-                                size_t length = 0;
-                                if (auto [ptr, ec] = std::from_chars(value_sv.data(), value_sv.data() + value_sv.size(), length); ec == std::errc()) {
-                                    content_length_ = length;
-                                }
-                                break;
-                            }
-                            if (line_end == std::string_view::npos) break;
-                            line_start = line_end + 2;
-                        }
+        // The end of a response that was not spilled: the checks and layout that need all of it.
+        [[nodiscard]] auto finish_response() noexcept -> std::expected<void, Error> {
+            if (header_size_ == 0 && !buffer_.empty()) {
+                return std::unexpected(Error{HttpClientError::HttpParseFailure});
+            }
+
+            if constexpr (Integrity == IntegrityPolicy::Crc32c) {
+                if (header_size_ != 0) {
+                    if (auto verified = verify_digest(); !verified) {
+                        return verified;
                     }
                 }
+            }
 
-                if (content_length_.has_value()) {
-                    if (buffer_.size() >= header_size_ + *content_length_) {
-                        break;
-                    }
+            if (header_size_ != 0 && (layout_.padding > 0 || layout_.alignment > 0)) {
+                apply_body_layout();
+            }
+
+            if (header_size_ != 0) {
+                size_predictor_.observe(predicted_, buffer_.size());
+            }
+            return {};
+        }
+
+        [[nodiscard]] auto should_spill() const noexcept -> bool {
+            return spill_.threshold > 0 &&
+                content_length_.value_or(buffer_.size() - body_offset_) > spill_.threshold;
+        }
+
+        // Moves the body received so far into the spill file. The rest of it is streamed there
+        // through a fixed-size window at the end of `buffer_` (see response_window), so memory
+        // stays bounded by the window rather than the body.
+        [[nodiscard]] auto start_spill() noexcept -> std::expected<void, Error> {
+            if constexpr (Integrity == IntegrityPolicy::Crc32c) {
+                update_digest();
+            }
+            if (!spill_file_.open(spill_)) {
+                return std::unexpected(Error{HttpClientError::SpillFailure});
+            }
+
+            const size_t received = std::min(buffer_.size() - body_offset_, content_length_.value_or(SIZE_MAX));
+            if (!spill_file_.write(std::span(buffer_).subspan(body_offset_, received))) {
+                spill_file_.reset();
+                return std::unexpected(Error{HttpClientError::SpillFailure});
+            }
+            buffer_.resize(body_offset_ + SPILL_WINDOW_SIZE_);
+            spilling_ = true;
+            return {};
+        }
+
+        // Writes the `bytes` read into the spill window to the spill file; true once the body is in.
+        [[nodiscard]] auto advance_spill(std::expected<size_t, TransportError> read) noexcept -> std::expected<bool, Error> {
+            if (!read) {
+                if (read.error() == TransportError::ConnectionClosed && !content_length_.has_value()) {
+                    return finish_spill();
+                }
+                abandon_spill();
+                if (read.error() == TransportError::ConnectionClosed) {
+                    return std::unexpected(Error{HttpClientError::HttpParseFailure});
                 }
+                return std::unexpected(Error{read.error()});
             }
+            const auto chunk = std::span(buffer_).subspan(body_offset_, *read);
+            if constexpr (Integrity == IntegrityPolicy::Crc32c) {
+                digest_ = crc32c_update(digest_, chunk);
+            }
+            if (!spill_file_.write(chunk)) {
+                abandon_spill();
+                return std::unexpected(Error{HttpClientError::SpillFailure});
+            }
+            if (content_length_.has_value() && spill_file_.size() >= *content_length_) {
+                return finish_spill();
+            }
+            return false;
+        }
 
-            if (header_size_ == 0 && !buffer_.empty()) {
-                return std::unexpected(Error{HttpClientError::HttpParseFailure});
+        [[nodiscard]] auto finish_spill() noexcept -> std::expected<bool, Error> {
+            spilling_ = false;
+            buffer_.resize(body_offset_);
+
+            if constexpr (Integrity == IntegrityPolicy::Crc32c) {
+                if (auto verified = verify_digest(); !verified) {
+                    spill_file_.reset();
+                    return std::unexpected(verified.error());
+                }
+            }
+            if (!spill_file_.map(layout_.padding)) {
+                spill_file_.reset();
+                return std::unexpected(Error{HttpClientError::SpillFailure});
             }
+            return true;
+        }
+
+        void abandon_spill() noexcept {
+            spilling_ = false;
+            spill_file_.reset();
+            buffer_.resize(body_offset_);
+        }
 
+        // Folds the body bytes that arrived since the last call into the running digest, while they
+        // are still hot from the read that delivered them.
+        void update_digest() noexcept {
+            const size_t available = std::min(buffer_.size() - body_offset_,
+                                               content_length_.value_or(buffer_.size() - body_offset_));
+            if (available > digested_) {
+                digest_ = crc32c_update(digest_, std::span(buffer_).subspan(body_offset_ + digested_, available - digested_));
+                digested_ = available;
+            }
+        }
+
+        [[nodiscard]] auto verify_digest() const noexcept -> std::expected<void, Error> {
+            std::string_view headers_view(reinterpret_cast<const char*>(buffer_.data()), header_size_);
+            size_t line_start = headers_view.find("\r\n") + 2;
+            while (line_start < headers_view.size()) {
+                size_t line_end = headers_view.find("\r\n", line_start);
+                std::string_view line = headers_view.substr(line_start, line_end - line_start);
+                if (line.size() >= HEADER_CONTENT_DIGEST_.size() &&
+                    std::equal(HEADER_CONTENT_DIGEST_.begin(), HEADER_CONTENT_DIGEST_.end(), line.begin(),
+                        [](char a, char b) { return std::tolower(a) == std::tolower(b); })
+                ) {
+                    auto expected = parse_crc32c_digest(line.substr(HEADER_CONTENT_DIGEST_.size()));
+                    if (!expected) {
+                        return std::unexpected(expected.error());
+                    }
+                    if (expected->has_value() && **expected != digest_) {
+                        return std::unexpected(Error{HttpClientError::IntegrityFailure});
+                    }
+                    break;
+                }
+                if (line_end == std::string_view::npos) break;
+                line_start = line_end + 2;
+            }
             return {};
         }
 
+        // Number of bytes between the header block and an aligned body start at the current buffer address.
+        [[nodiscard]] auto alignment_gap() const noexcept -> size_t {
+            if (layout_.alignment == 0) {
+                return 0;
+            }
+            auto start = reinterpret_cast<std::uintptr_t>(buffer_.data() + header_size_);
+            return (layout_.alignment - (start & (layout_.alignment - 1))) & (layout_.alignment - 1);
+        }
+
+        // Fallback for responses without Content-Length (or a buffer that moved while growing):
+        // shift the body into place once, then zero the tail padding.
+        void apply_body_layout() noexcept {
+            const size_t body_len = content_length_.value_or(buffer_.size() - body_offset_);
+            buffer_.reserve(header_size_ + layout_.alignment + body_len + layout_.padding);
+
+            const size_t aligned_offset = header_size_ + alignment_gap();
+            if (aligned_offset != body_offset_) {
+                buffer_.resize(std::max(buffer_.size(), aligned_offset + body_len));
+                std::memmove(buffer_.data() + aligned_offset, buffer_.data() + body_offset_, body_len);
+                body_offset_ = aligned_offset;
+            }
+
+            buffer_.resize(body_offset_ + body_len);
+            buffer_.resize(body_offset_ + body_len + layout_.padding);
+        }
+
         [[nodiscard]] auto parse_unsafe_response() noexcept -> std::expected<UnsafeHttpResponse, Error> {
             UnsafeHttpResponse res;
             std::string_view response_view(reinterpret_cast<const char*>(buffer_.data()), buffer_.size());
@@ -211,49 +974,114 @@ namespace httpcpp {
             size_t status_line_end = headers_block.find("\r\n");
             if (status_line_end == std::string_view::npos) return std::unexpected(Error{HttpClientError::HttpParseFailure});
             std::string_view status_line = headers_block.substr(0, status_line_end);
+            if constexpr (Validation == ValidationPolicy::Strict) {
+                if (!status_line.starts_with(HTTP_VERSION_PREFIX_)) {
+                    return std::unexpected(Error{HttpClientError::HttpParseFailure});
+                }
+            }
             auto code_start = status_line.find(' ');
             if (code_start == std::string_view::npos) return std::unexpected(Error{HttpClientError::HttpParseFailure});
             auto code_end = status_line.find(' ', code_start + 1);
-            if (code_end == std::string_view::npos) return std::unexpected(Error{HttpClientError::HttpParseFailure});
+            if constexpr (Status == StatusPolicy::Full) {
+                if (code_end == std::string_view::npos) return std::unexpected(Error{HttpClientError::HttpParseFailure});
+            } else {
+                code_end = std::min(code_end, status_line.size());
+            }
             auto code_sv = status_line.substr(code_start + 1, code_end - (code_start + 1));
-            if (auto [ptr, ec] = std::from_chars(code_sv.data(), code_sv.data() + code_sv.size(), res.status_code); ec != std::errc()) {
+            auto [code_ptr, code_ec] = std::from_chars(code_sv.data(), code_sv.data() + code_sv.size(), res.status_code);
+            if (code_ec != std::errc()) {
                 return std::unexpected(Error{HttpClientError::HttpParseFailure});
             }
-            res.status_message = status_line.substr(code_end + 1);
-
-            // 3. Parse all header key-value pairs.
-            headers_block.remove_prefix(status_line_end + 2);
-            while (!headers_block.empty()) {
-                size_t line_end = headers_block.find("\r\n");
-                std::string_view line = headers_block.substr(0, line_end);
-                size_t colon_pos = line.find(':');
-                if (colon_pos != std::string_view::npos) {
-                    auto key = line.substr(0, colon_pos);
-                    auto value = line.substr(colon_pos + 1);
-                    value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
-                    res.headers.emplace_back(key, value);
+            if constexpr (Validation == ValidationPolicy::Strict) {
+                if (code_sv.size() != 3 || code_ptr != code_sv.data() + code_sv.size()) {
+                    return std::unexpected(Error{HttpClientError::HttpParseFailure});
+                }
+            }
+            if constexpr (Status == StatusPolicy::Full) {
+                res.status_message = status_line.substr(code_end + 1);
+            }
+
+            // 3. Parse the header key-value pairs the policy asks for.
+            if constexpr (Headers != HeadersPolicy::None) {
+                headers_block.remove_prefix(status_line_end + 2);
+                while (!headers_block.empty()) {
+                    size_t line_end = headers_block.find("\r\n");
+                    std::string_view line = headers_block.substr(0, line_end);
+                    size_t colon_pos = line.find(':');
+                    if constexpr (Validation == ValidationPolicy::Strict) {
+                        if (colon_pos == std::string_view::npos || colon_pos == 0 ||
+                            line.substr(0, colon_pos).find_first_of(" \t") != std::string_view::npos) {
+                            return std::unexpected(Error{HttpClientError::HttpParseFailure});
+                        }
+                    }
+                    if (colon_pos != std::string_view::npos) {
+                        auto key = line.substr(0, colon_pos);
+                        if (Headers == HeadersPolicy::Full || is_framing_header(key)) {
+                            auto value = line.substr(colon_pos + 1);
+                            value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+                            res.headers.emplace_back(key, value);
+                        }
+                    }
+                    if (line_end == std::string_view::npos) break;
+                    headers_block.remove_prefix(line_end + 2);
                 }
-                if (line_end == std::string_view::npos) break;
-                headers_block.remove_prefix(line_end + 2);
             }
 
-            if (content_length_.has_value()) {
-                res.body = std::span(buffer_).subspan(header_size_, *content_length_);
+            if (spill_file_.size() > 0) {
+                res.body = spill_file_.body();
+                res.content_length = content_length_;
+            } else if (content_length_.has_value()) {
+                res.body = std::span(buffer_).subspan(body_offset_, *content_length_);
                 res.content_length = *content_length_;
             } else {
-                res.body = std::span(buffer_).subspan(header_size_);
+                res.body = std::span(buffer_).subspan(body_offset_, buffer_.size() - body_offset_ - layout_.padding);
             }
 
             return res;
         }
 
+        [[nodiscard]] static constexpr auto is_framing_header(std::string_view key) noexcept -> bool {
+            auto iequals = [key](std::string_view name) {
+                return key.size() == name.size() &&
+                    std::equal(key.begin(), key.end(), name.begin(),
+                        [](char a, char b) { return std::tolower(a) == std::tolower(b); });
+            };
+            return iequals("Content-Length") || iequals("Transfer-Encoding");
+        }
+
         static constexpr std::string_view HEADER_SEPARATOR_ = "\r\n\r\n";
+        static constexpr std::string_view HTTP_VERSION_PREFIX_ = "HTTP/1.";
         static constexpr std::string_view HEADER_SEPARATOR_CL = "Content-Length:";
+        static constexpr std::string_view HEADER_CONTENT_DIGEST_ = "Content-Digest:";
+        static constexpr size_t SPILL_WINDOW_SIZE_ = 64 * 1024;
+        static constexpr size_t READ_WINDOW_SIZE_ = 64 * 1024;
+        static constexpr size_t CONTENT_LENGTH_DIGITS_ = std::numeric_limits<size_t>::digits10 + 1;
 
         size_t header_size_ = 0;
+        size_t body_offset_ = 0;
+        BodyLayout layout_;
+        SpillPolicy spill_;
+        SpillFile spill_file_;
         T transport_;
-        std::vector<std::byte> buffer_;
+        ProtocolBuffer buffer_;
         std::optional<size_t> content_length_;
+        uint32_t digest_ = 0;
+        size_t digested_ = 0;
+        ReconnectPolicy reconnect_;
+        std::string host_;
+        uint16_t port_ = 0;
+        size_t reconnect_count_ = 0;
+        ResponseSizePredictor size_predictor_;
+        ReceiveStrategy receive_strategy_ = ReceiveStrategy::Incremental;
+        size_t read_calls_ = 0;
+        std::vector<std::span<const std::byte>> gather_;
+        std::array<char, 2 + 2 * sizeof(size_t) + 4> chunk_framing_{};
+        size_t content_length_digits_ = 0;
+        size_t predicted_ = 0;
+        size_t window_start_ = 0;
+        bool presized_ = false;
+        bool wait_all_ = false;
+        bool spilling_ = false;
     };
 
 } // namespace httpcpp
\ No newline at end of file
@@ -2,12 +2,16 @@
 
 #include <httpcpp/transport.hpp>
 #include <httpcpp/error.hpp>
+#include <httpcpp/stream_copy.hpp>
 #include <vector>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <span>
 #include <optional>
+#include <concepts>
+#include <expected>
+#include <type_traits>
 
 namespace httpcpp {
 
@@ -37,11 +41,23 @@ namespace httpcpp {
     struct SafeHttpResponse {
         int status_code;
         std::string status_message;
-        std::vector<std::byte> body;
+        // A std::vector<std::byte> with a default-initializing allocator (see ByteBuffer), so a
+        // large body is streamed into fresh memory rather than zeroed through the cache first.
+        // Being a different vector type, it does not convert to or compare with
+        // std::vector<std::byte>: copy it out with `std::vector<std::byte>(body.begin(),
+        // body.end())` and compare with std::ranges::equal.
+        ByteBuffer body;
         std::vector<HttpOwnedHeader> headers;
         std::optional<size_t> content_length = std::nullopt;
     };
 
+    // Supplies a streamed request body one chunk at a time. Each call returns the buffers making
+    // up the next chunk, which must stay valid until the following call; an empty chunk ends the
+    // body and an error aborts the request. Called on the sending thread; must not throw.
+    template<typename F>
+    concept BodyProducer = std::invocable<F&> &&
+        std::same_as<std::invoke_result_t<F&>, std::expected<std::span<const std::span<const std::byte>>, Error>>;
+
     template<typename T>
     concept HttpProtocol = requires(T proto, const HttpRequest& req, const char* host, uint16_t port) {
 
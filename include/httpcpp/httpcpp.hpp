@@ -1,6 +1,7 @@
 #pragma once
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 
 
 #include <httpcpp/error.hpp>
@@ -8,10 +9,26 @@
 #include <httpcpp/http1_protocol.hpp>
 #include <httpcpp/tcp_transport.hpp>
 #include <httpcpp/unix_transport.hpp>
+#include <httpcpp/url.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 
 namespace httpcpp {
 
+    // Startup work that would otherwise land on the first real requests. `buffer_size` bytes of
+    // protocol buffer are allocated and pre-faulted up front; `request`, when set, is then sent
+    // `requests` times to warm caches, branch predictors and the server side, and its responses
+    // are discarded.
+    struct WarmUpOptions {
+        size_t buffer_size = 0;
+        const HttpRequest* request = nullptr;
+        size_t requests = 0;
+    };
+
     template<HttpProtocol P>
     class HttpClient {
     public:
@@ -24,13 +41,45 @@ namespace httpcpp {
         HttpClient& operator=(HttpClient&&) = delete;
 
         [[nodiscard]] auto connect(const char* host, uint16_t port) noexcept -> std::expected<void, Error> {
-            return protocol_.connect(host, port);
+            auto connected = protocol_.connect(host, port);
+            remember_authority(connected ? host : "", port);
+            return connected;
         }
 
         [[nodiscard]] auto disconnect() noexcept -> std::expected<void, Error> {
+            remember_authority("", 0);
             return protocol_.disconnect();
         }
 
+        // Connects, then performs the warm-up described by `options`. The client owns a single
+        // connection; warm several clients to have several connections ready.
+        [[nodiscard]] auto warm_up(const char* host, uint16_t port, const WarmUpOptions& options) noexcept -> std::expected<void, Error> {
+            if (auto connected = connect(host, port); !connected) {
+                return connected;
+            }
+            if constexpr (requires(P& p) { p.reserve_buffer(size_t{}); }) {
+                if (options.buffer_size > 0) {
+                    protocol_.reserve_buffer(options.buffer_size);
+                }
+            }
+            if (options.request == nullptr) {
+                return {};
+            }
+            for (size_t i = 0; i < options.requests; ++i) {
+                HttpRequest request = *options.request;
+                auto response = request.method == HttpMethod::Post ? post_unsafe(request) : get_unsafe(request);
+                if (!response) {
+                    return std::unexpected(response.error());
+                }
+            }
+            return {};
+        }
+
+        // Access to protocol-specific configuration (e.g. Http1Protocol::set_body_layout).
+        [[nodiscard]] auto protocol() noexcept -> P& {
+            return protocol_;
+        }
+
         [[nodiscard]] auto get_safe(HttpRequest& request) noexcept -> std::expected<SafeHttpResponse, Error> {
             if (!request.body.empty()) {
                 return std::unexpected(HttpClientError::InvalidRequest);
@@ -47,6 +96,28 @@ namespace httpcpp {
             return protocol_.perform_request_unsafe(request);
         }
 
+        // URL-based requests returning owning responses. The URL's host and port select the
+        // connection: the current one is reused when they match the last connect(), otherwise
+        // the client reconnects first. A Host header naming the URL's authority is sent along.
+        // https URLs require a SecureTransport such as TlsTransport, which in turn refuses http ones.
+        [[nodiscard]] auto get(std::string_view url) noexcept -> std::expected<SafeHttpResponse, Error> {
+            HttpRequest request{};
+            if (auto routed = route(url, request); !routed) {
+                return std::unexpected(routed.error());
+            }
+            return get_safe(request);
+        }
+
+        // `request` supplies the body and headers and is left as it was: the URL's target and Host
+        // header go into a copy, so the request can be reused with another URL.
+        [[nodiscard]] auto post(std::string_view url, const HttpRequest& request) noexcept -> std::expected<SafeHttpResponse, Error> {
+            HttpRequest routed_request = request;
+            if (auto routed = route(url, routed_request); !routed) {
+                return std::unexpected(routed.error());
+            }
+            return post_safe(routed_request);
+        }
+
         [[nodiscard]] auto post_safe(HttpRequest& request) noexcept -> std::expected<SafeHttpResponse, Error> {
             if (auto validation_result = validate_post_request(request); !validation_result) {
                 return std::unexpected(validation_result.error());
@@ -64,30 +135,170 @@ namespace httpcpp {
             return protocol_.perform_request_unsafe(request);
         }
 
+        // A POST whose body is the concatenation of `body_parts`, sent with one gathered write
+        // where the transport supports it. `request.body` must be empty; the Content-Length
+        // header must give the total size, or the request is rejected unsent.
+        [[nodiscard]] auto post_gather_safe(HttpRequest& request, std::span<const std::span<const std::byte>> body_parts) noexcept
+            -> std::expected<SafeHttpResponse, Error>
+            requires requires(P p, const HttpRequest& req) { p.perform_request_gather_safe(req, body_parts); }
+        {
+            size_t body_size = 0;
+            for (const auto& part : body_parts) {
+                body_size += part.size();
+            }
+            if (!request.body.empty() || body_size == 0 || !content_length_is(request, body_size)) {
+                return std::unexpected(HttpClientError::InvalidRequest);
+            }
+            request.method = HttpMethod::Post;
+            return protocol_.perform_request_gather_safe(request, body_parts);
+        }
+
+        // A POST whose body is pulled chunk by chunk from `producer` and sent with
+        // `Transfer-Encoding: chunked`, for bodies generated on the fly or too large to hold.
+        // `request.body` must be empty and neither Content-Length nor Transfer-Encoding may be set.
+        template<BodyProducer Producer>
+        [[nodiscard]] auto post_stream_safe(HttpRequest& request, Producer&& producer) noexcept
+            -> std::expected<SafeHttpResponse, Error>
+            requires requires(P p, const HttpRequest& req) { p.perform_request_stream_safe(req, producer); }
+        {
+            if (auto validation_result = validate_unframed_request(request); !validation_result) {
+                return std::unexpected(validation_result.error());
+            }
+            request.method = HttpMethod::Post;
+            return protocol_.perform_request_stream_safe(request, producer);
+        }
+
+        template<BodyProducer Producer>
+        [[nodiscard]] auto post_stream_unsafe(HttpRequest& request, Producer&& producer) noexcept
+            -> std::expected<UnsafeHttpResponse, Error>
+            requires requires(P p, const HttpRequest& req) { p.perform_request_stream_unsafe(req, producer); }
+        {
+            if (auto validation_result = validate_unframed_request(request); !validation_result) {
+                return std::unexpected(validation_result.error());
+            }
+            request.method = HttpMethod::Post;
+            return protocol_.perform_request_stream_unsafe(request, producer);
+        }
+
+        // A POST whose body `writer` generates directly into the send buffer through a
+        // RequestBodyBuffer; the Content-Length header is filled in afterwards. `request.body`
+        // must be empty and neither Content-Length nor Transfer-Encoding may be set.
+        template<BodyWriter Writer>
+        [[nodiscard]] auto post_with_writer(HttpRequest& request, Writer&& writer) noexcept
+            -> std::expected<SafeHttpResponse, Error>
+            requires requires(P p, const HttpRequest& req) { p.perform_request_writer_safe(req, writer); }
+        {
+            if (auto validation_result = validate_unframed_request(request); !validation_result) {
+                return std::unexpected(validation_result.error());
+            }
+            request.method = HttpMethod::Post;
+            return protocol_.perform_request_writer_safe(request, writer);
+        }
+
+        template<BodyWriter Writer>
+        [[nodiscard]] auto post_with_writer_unsafe(HttpRequest& request, Writer&& writer) noexcept
+            -> std::expected<UnsafeHttpResponse, Error>
+            requires requires(P p, const HttpRequest& req) { p.perform_request_writer_unsafe(req, writer); }
+        {
+            if (auto validation_result = validate_unframed_request(request); !validation_result) {
+                return std::unexpected(validation_result.error());
+            }
+            request.method = HttpMethod::Post;
+            return protocol_.perform_request_writer_unsafe(request, writer);
+        }
+
     private:
         P protocol_;
+        std::string host_;
+        uint16_t port_ = 0;
 
-        [[nodiscard]] auto validate_post_request(const HttpRequest& request) noexcept -> std::expected<void, Error> {
-            if (request.body.empty()) {
+        void remember_authority(const char* host, uint16_t port) noexcept {
+            host_ = host;
+            port_ = port;
+        }
+
+        // Points `request` at the URL's target and makes sure the connection goes to its authority.
+        [[nodiscard]] auto route(std::string_view url, HttpRequest& request) noexcept -> std::expected<void, Error> {
+            auto parsed = parse_url(url);
+            if (!parsed) {
+                return std::unexpected(parsed.error());
+            }
+            // The scheme has to match the transport: https needs one that encrypts, and an
+            // http URL must not silently go over TLS to a server that expects plain text.
+            constexpr bool secure = requires(P& protocol) {
+                requires SecureTransport<std::remove_reference_t<decltype(protocol.transport())>>;
+            };
+            if (!detail::iequals(parsed->scheme, secure ? "https" : "http")) {
                 return std::unexpected(HttpClientError::InvalidRequest);
             }
 
-            bool content_length_found = false;
-            std::string_view cl_key = "Content-Length";
-            for (const auto& [key, value] : request.headers) {
-                if (key.size() == cl_key.size() &&
-                    std::equal(key.begin(), key.end(), cl_key.begin(),
-                               [](char a, char b) { return std::tolower(a) == std::tolower(b); })) {
-                                   content_length_found = true;
-                                   break;
-                               }
+            const bool same_authority = port_ == parsed->port && host_.size() == parsed->host.size() &&
+                std::equal(host_.begin(), host_.end(), parsed->host.begin(),
+                           [](char a, char b) { return std::tolower(a) == std::tolower(b); });
+            if (!same_authority) {
+                if (!host_.empty()) {
+                    (void)disconnect();
+                }
+                if (auto connected = connect(std::string(parsed->host).c_str(), parsed->port); !connected) {
+                    return connected;
+                }
             }
 
-            if (!content_length_found) {
+            request.path = parsed->target;
+            const bool has_host = std::ranges::any_of(request.headers, [](const HttpHeaderView& header) {
+                return detail::iequals(header.first, "host");
+            });
+            if (!has_host) {
+                request.headers.emplace_back("Host", parsed->authority);
+            }
+            return {};
+        }
+
+        [[nodiscard]] auto validate_post_request(const HttpRequest& request) noexcept -> std::expected<void, Error> {
+            if (request.body.empty() || !has_content_length(request)) {
                 return std::unexpected(HttpClientError::InvalidRequest);
             }
+            return {};
+        }
 
+        [[nodiscard]] auto validate_unframed_request(const HttpRequest& request) noexcept -> std::expected<void, Error> {
+            if (!request.body.empty() || has_content_length(request) || has_header(request, "Transfer-Encoding")) {
+                return std::unexpected(HttpClientError::InvalidRequest);
+            }
             return {};
         }
+
+        [[nodiscard]] static auto has_content_length(const HttpRequest& request) noexcept -> bool {
+            return has_header(request, "Content-Length");
+        }
+
+        // Whether the Content-Length header holds exactly `size`.
+        [[nodiscard]] static auto content_length_is(const HttpRequest& request, size_t size) noexcept -> bool {
+            auto value = find_header(request, "Content-Length");
+            if (!value) {
+                return false;
+            }
+            value->remove_prefix(std::min(value->find_first_not_of(" \t"), value->size()));
+            value->remove_suffix(value->size() - std::min(value->find_last_not_of(" \t") + 1, value->size()));
+            size_t length = 0;
+            auto [ptr, ec] = std::from_chars(value->data(), value->data() + value->size(), length);
+            return ec == std::errc() && ptr == value->data() + value->size() && length == size;
+        }
+
+        [[nodiscard]] static auto has_header(const HttpRequest& request, std::string_view name) noexcept -> bool {
+            return find_header(request, name).has_value();
+        }
+
+        [[nodiscard]] static auto find_header(const HttpRequest& request, std::string_view name) noexcept
+            -> std::optional<std::string_view> {
+            for (const auto& [key, value] : request.headers) {
+                if (key.size() == name.size() &&
+                    std::equal(key.begin(), key.end(), name.begin(),
+                               [](char a, char b) { return std::tolower(a) == std::tolower(b); })) {
+                    return value;
+                }
+            }
+            return std::nullopt;
+        }
     };
 } // namespace httpcpp
\ No newline at end of file
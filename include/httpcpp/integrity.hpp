@@ -0,0 +1,117 @@
+#pragma once
+
+#include <httpcpp/error.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace httpcpp {
+
+    namespace detail {
+        inline constexpr auto CRC32C_TABLE = [] {
+            std::array<uint32_t, 256> table{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int k = 0; k < 8; ++k) {
+                    crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+                }
+                table[i] = crc;
+            }
+            return table;
+        }();
+
+        [[nodiscard]] constexpr auto base64_value(char c) noexcept -> int {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '+') return 62;
+            if (c == '/') return 63;
+            return -1;
+        }
+    } // namespace detail
+
+    // CRC32C (Castagnoli), using the SSE4.2 / ARMv8 CRC instructions when the build targets them.
+    // Start with crc = 0 and feed chunks in order.
+    [[nodiscard]] inline auto crc32c_update(uint32_t crc, std::span<const std::byte> data) noexcept -> uint32_t {
+        const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+        size_t len = data.size();
+        crc = ~crc;
+#if defined(__SSE4_2__) || defined(__ARM_FEATURE_CRC32)
+        for (; len >= 8; p += 8, len -= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+#if defined(__SSE4_2__)
+            crc = static_cast<uint32_t>(_mm_crc32_u64(crc, word));
+#else
+            crc = __crc32cd(crc, word);
+#endif
+        }
+        for (; len > 0; --len) {
+#if defined(__SSE4_2__)
+            crc = _mm_crc32_u8(crc, *p++);
+#else
+            crc = __crc32cb(crc, *p++);
+#endif
+        }
+#else
+        for (; len > 0; --len) {
+            crc = detail::CRC32C_TABLE[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        }
+#endif
+        return ~crc;
+    }
+
+    // Extracts the `crc32c` member of a Content-Digest field value, a dictionary of
+    // `algorithm=:<base64>:` members separated by commas (RFC 9530). nullopt when there is no such
+    // member; IntegrityFailure when its value is not the base64 of a 4-byte checksum, so a
+    // damaged digest is not mistaken for a missing one.
+    [[nodiscard]] constexpr auto parse_crc32c_digest(std::string_view field_value) noexcept
+        -> std::expected<std::optional<uint32_t>, Error> {
+        std::optional<uint32_t> digest;
+        while (!field_value.empty()) {
+            const size_t comma = std::min(field_value.find(','), field_value.size());
+            std::string_view member = field_value.substr(0, comma);
+            field_value.remove_prefix(std::min(comma + 1, field_value.size()));
+
+            member.remove_prefix(std::min(member.find_first_not_of(" \t"), member.size()));
+            member.remove_suffix(member.size() - std::min(member.find_last_not_of(" \t") + 1, member.size()));
+            const size_t equals = std::min(member.find('='), member.size());
+            if (member.substr(0, equals) != "crc32c") {
+                continue;
+            }
+
+            // 4 digest bytes encode as 6 base64 characters plus "==" padding, optionally
+            // followed by parameters.
+            const std::string_view value = member.substr(std::min(equals + 1, member.size()));
+            if (value.size() < 10 || value[0] != ':' || value.substr(7, 3) != "==:" ||
+                (value.size() > 10 && value[10] != ';')) {
+                return std::unexpected(Error{HttpClientError::IntegrityFailure});
+            }
+            uint64_t bits = 0;
+            for (char c : value.substr(1, 6)) {
+                int v = detail::base64_value(c);
+                if (v < 0) {
+                    return std::unexpected(Error{HttpClientError::IntegrityFailure});
+                }
+                bits = (bits << 6) | static_cast<uint64_t>(v);
+            }
+            // A repeated member replaces the earlier one.
+            digest = static_cast<uint32_t>(bits >> 4);
+        }
+        return digest;
+    }
+
+} // namespace httpcpp
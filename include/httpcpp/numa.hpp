@@ -0,0 +1,87 @@
+#pragma once
+
+#include <httpcpp/error.hpp>
+
+#include <cstddef>
+#include <expected>
+#include <new>
+#include <type_traits>
+
+namespace httpcpp::numa {
+
+    // Number of memory nodes the kernel reports online; 1 when the machine (or the sysfs view
+    // of it inside a container) has no NUMA topology.
+    [[nodiscard]] auto node_count() noexcept -> int;
+
+    // The node of the CPU the calling thread is running on right now; 0 if it cannot be told.
+    [[nodiscard]] auto current_node() noexcept -> int;
+
+    // Pins the calling thread to the CPUs of `node` and makes that node its preferred source of
+    // memory, so a worker that owns connections parses on the node holding their buffers.
+    // Fails with InvalidRequest for a node that does not exist and InitFailure when the
+    // affinity cannot be set. Node 0 always exists.
+    [[nodiscard]] auto bind_current_thread(int node) noexcept -> std::expected<void, Error>;
+
+    // `bytes` rounded up to whole pages, mapped and bound to `node` with mbind (preferred, not
+    // strict, so a full node spills rather than fails). Where mbind is unavailable each page is
+    // touched by the caller instead, which places it on the caller's node under the kernel's
+    // first-touch policy. nullptr when the mapping fails.
+    [[nodiscard]] auto allocate_on_node(size_t bytes, int node) noexcept -> void*;
+    void deallocate_on_node(void* pointer, size_t bytes) noexcept;
+
+    // Allocations of at least a page are placed on `node` via allocate_on_node; smaller ones,
+    // and all of them for the default node of -1, come from operator new. Equal when the nodes
+    // are, so buffers move between containers placed on the same node without copying.
+    template<typename T>
+    class NodeAllocator {
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        NodeAllocator() noexcept = default;
+
+        explicit NodeAllocator(int node) noexcept : node_(node) {}
+
+        template<typename U>
+        NodeAllocator(const NodeAllocator<U>& other) noexcept : node_(other.node()) {}
+
+        [[nodiscard]] auto allocate(size_t n) -> T* {
+            const size_t bytes = n * sizeof(T);
+            if (!placed(bytes)) {
+                return static_cast<T*>(::operator new(bytes));
+            }
+            void* pointer = allocate_on_node(bytes, node_);
+            if (pointer == nullptr) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(pointer);
+        }
+
+        void deallocate(T* pointer, size_t n) noexcept {
+            const size_t bytes = n * sizeof(T);
+            if (!placed(bytes)) {
+                ::operator delete(pointer);
+                return;
+            }
+            deallocate_on_node(pointer, bytes);
+        }
+
+        [[nodiscard]] auto node() const noexcept -> int {
+            return node_;
+        }
+
+        friend auto operator==(const NodeAllocator&, const NodeAllocator&) noexcept -> bool = default;
+
+    private:
+        [[nodiscard]] auto placed(size_t bytes) const noexcept -> bool {
+            return node_ >= 0 && bytes >= PLACEMENT_THRESHOLD_;
+        }
+
+        static constexpr size_t PLACEMENT_THRESHOLD_ = 4096;
+
+        int node_ = -1;
+    };
+
+} // namespace httpcpp::numa
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <httpcpp/httpcpp.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace httpcpp {
+
+    // Fixed-size log-linear histogram of nanosecond latencies: exact below 16 ns, then eight
+    // sub-buckets per power of two, so a reported percentile is at most 12.5% above the sample.
+    // Recording is lock-free and may happen from any thread.
+    class LatencyHistogram {
+    public:
+        void record(uint64_t ns) noexcept {
+            buckets_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+            uint64_t max = max_.load(std::memory_order_relaxed);
+            while (ns > max && !max_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+            }
+        }
+
+        [[nodiscard]] auto count() const noexcept -> uint64_t {
+            uint64_t total = 0;
+            for (const auto& bucket : buckets_) {
+                total += bucket.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        // Upper bound of the bucket holding the p-quantile (0 < p <= 1); 0 without samples.
+        [[nodiscard]] auto percentile(double p) const noexcept -> uint64_t {
+            const uint64_t total = count();
+            if (total == 0) {
+                return 0;
+            }
+            const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * static_cast<double>(total) + 0.999999));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKETS_; ++i) {
+                seen += buckets_[i].load(std::memory_order_relaxed);
+                if (seen >= rank) {
+                    return std::min(upper_bound_of(i), max());
+                }
+            }
+            return max();
+        }
+
+        [[nodiscard]] auto max() const noexcept -> uint64_t {
+            return max_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t LINEAR_ = 16;
+        static constexpr size_t SUB_BUCKETS_ = 8;
+        static constexpr size_t BUCKETS_ = LINEAR_ + (64 - 4) * SUB_BUCKETS_;
+
+        [[nodiscard]] static constexpr auto bucket_of(uint64_t ns) noexcept -> size_t {
+            if (ns < LINEAR_) {
+                return static_cast<size_t>(ns);
+            }
+            const auto exponent = static_cast<size_t>(std::bit_width(ns) - 1);
+            const auto sub = static_cast<size_t>(ns >> (exponent - 3)) & (SUB_BUCKETS_ - 1);
+            return LINEAR_ + (exponent - 4) * SUB_BUCKETS_ + sub;
+        }
+
+        [[nodiscard]] static constexpr auto upper_bound_of(size_t index) noexcept -> uint64_t {
+            if (index < LINEAR_) {
+                return index;
+            }
+            const size_t exponent = (index - LINEAR_) / SUB_BUCKETS_ + 4;
+            const uint64_t sub = (index - LINEAR_) % SUB_BUCKETS_;
+            const uint64_t step = uint64_t{1} << (exponent - 3);
+            return ((SUB_BUCKETS_ | sub) << (exponent - 3)) + step - 1;
+        }
+
+        std::array<std::atomic<uint64_t>, BUCKETS_> buckets_{};
+        std::atomic<uint64_t> max_{0};
+    };
+
+    enum class Priority {
+        // Small, latency-sensitive requests; never queued behind a bulk transfer.
+        Interactive,
+        // Large uploads and downloads; optionally paced to a byte rate.
+        Bulk,
+    };
+
+    struct PriorityOptions {
+        size_t interactive_connections = 1;
+        size_t bulk_connections = 1;
+        // Requests whose body is at least this large go to the bulk lane unless a priority is given.
+        size_t bulk_threshold = 64 * 1024;
+        // Upper bound on request plus response body bytes per second in the bulk lane; 0 disables pacing.
+        uint64_t bulk_bytes_per_second = 0;
+    };
+
+    struct LaneStats {
+        uint64_t requests = 0;
+        uint64_t p50_ns = 0;
+        uint64_t p90_ns = 0;
+        uint64_t p99_ns = 0;
+        uint64_t max_ns = 0;
+    };
+
+    // A client with separate connections per Priority lane, so a small request is never stuck
+    // behind a megabyte upload on the same connection. Requests may be issued from several
+    // threads; within a lane they take whichever connection is idle, or wait for one. The latency
+    // of every request, including the wait for a connection and for pacing, is recorded per lane.
+    template<HttpProtocol P>
+    class PriorityHttpClient {
+    public:
+        explicit PriorityHttpClient(PriorityOptions options = {}) noexcept : options_(options) {}
+
+        PriorityHttpClient(const PriorityHttpClient&) = delete;
+        PriorityHttpClient& operator=(const PriorityHttpClient&) = delete;
+        PriorityHttpClient(PriorityHttpClient&&) = delete;
+        PriorityHttpClient& operator=(PriorityHttpClient&&) = delete;
+
+        // Opens every connection of both lanes up front. Not thread-safe with respect to requests in flight.
+        [[nodiscard]] auto connect(const char* host, uint16_t port) noexcept -> std::expected<void, Error> {
+            if (options_.interactive_connections == 0 || options_.bulk_connections == 0) {
+                return std::unexpected(HttpClientError::InvalidRequest);
+            }
+            for (auto [lane, count] : {std::pair{&interactive_, options_.interactive_connections},
+                                       std::pair{&bulk_, options_.bulk_connections}}) {
+                lane->connections.clear();
+                for (size_t i = 0; i < count; ++i) {
+                    auto connection = std::make_unique<Connection>();
+                    if (auto connected = connection->client.connect(host, port); !connected) {
+                        interactive_.connections.clear();
+                        bulk_.connections.clear();
+                        return connected;
+                    }
+                    lane->connections.push_back(std::move(connection));
+                }
+            }
+            return {};
+        }
+
+        [[nodiscard]] auto disconnect() noexcept -> std::expected<void, Error> {
+            std::expected<void, Error> result;
+            for (Lane* lane : {&interactive_, &bulk_}) {
+                for (auto& connection : lane->connections) {
+                    std::lock_guard lock(connection->mutex);
+                    if (auto closed = connection->client.disconnect(); !closed && result) {
+                        result = closed;
+                    }
+                }
+            }
+            return result;
+        }
+
+        [[nodiscard]] auto get_safe(HttpRequest& request, std::optional<Priority> priority = std::nullopt) noexcept
+            -> std::expected<SafeHttpResponse, Error> {
+            return perform(request, priority, [](HttpClient<P>& client, HttpRequest& req) { return client.get_safe(req); });
+        }
+
+        [[nodiscard]] auto post_safe(HttpRequest& request, std::optional<Priority> priority = std::nullopt) noexcept
+            -> std::expected<SafeHttpResponse, Error> {
+            return perform(request, priority, [](HttpClient<P>& client, HttpRequest& req) { return client.post_safe(req); });
+        }
+
+        [[nodiscard]] auto classify(const HttpRequest& request) const noexcept -> Priority {
+            return request.body.size() >= options_.bulk_threshold ? Priority::Bulk : Priority::Interactive;
+        }
+
+        [[nodiscard]] auto lane_stats(Priority priority) const noexcept -> LaneStats {
+            const LatencyHistogram& latency = lane(priority).latency;
+            return {
+                .requests = latency.count(),
+                .p50_ns = latency.percentile(0.50),
+                .p90_ns = latency.percentile(0.90),
+                .p99_ns = latency.percentile(0.99),
+                .max_ns = latency.max(),
+            };
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Connection {
+            HttpClient<P> client;
+            std::mutex mutex;
+        };
+
+        struct Lane {
+            std::vector<std::unique_ptr<Connection>> connections;
+            std::atomic<size_t> next{0};
+            LatencyHistogram latency;
+            // Pacing: the earliest time the next transfer may start, past every transfer already
+            // reserved.
+            std::mutex pace_mutex;
+            Clock::time_point next_send{};
+        };
+
+        template<typename Send>
+        [[nodiscard]] auto perform(HttpRequest& request, std::optional<Priority> priority, Send send) noexcept
+            -> std::expected<SafeHttpResponse, Error> {
+            const auto start = Clock::now();
+            const Priority chosen = priority.value_or(classify(request));
+            Lane& lane = this->lane(chosen);
+            if (lane.connections.empty()) {
+                return std::unexpected(TransportError::SocketWriteFailure);
+            }
+
+            const bool paced = chosen == Priority::Bulk && options_.bulk_bytes_per_second != 0;
+            if (paced) {
+                std::this_thread::sleep_until(reserve(lane, request.body.size()));
+            }
+
+            auto [connection, lock] = acquire(lane);
+            auto response = send(connection->client, request);
+            lock.unlock();
+
+            if (paced && response) {
+                charge(lane, response->body.size());
+            }
+            lane.latency.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
+            return response;
+        }
+
+        // Takes the first idle connection, starting from a rotating index; if all are busy, waits
+        // for the one at that index.
+        [[nodiscard]] static auto acquire(Lane& lane) noexcept -> std::pair<Connection*, std::unique_lock<std::mutex>> {
+            const size_t n = lane.connections.size();
+            const size_t first = lane.next.fetch_add(1, std::memory_order_relaxed) % n;
+            for (size_t i = 0; i < n; ++i) {
+                Connection* connection = lane.connections[(first + i) % n].get();
+                std::unique_lock lock(connection->mutex, std::try_to_lock);
+                if (lock.owns_lock()) {
+                    return {connection, std::move(lock)};
+                }
+            }
+            Connection* connection = lane.connections[first].get();
+            return {connection, std::unique_lock(connection->mutex)};
+        }
+
+        // Claims the lane for the request body before it is sent and returns when the transfer may
+        // start, so concurrent bulk requests start one body's time apart instead of together.
+        [[nodiscard]] auto reserve(Lane& lane, size_t bytes) noexcept -> Clock::time_point {
+            std::lock_guard lock(lane.pace_mutex);
+            const Clock::time_point start = std::max(lane.next_send, Clock::now());
+            lane.next_send = start + cost_of(bytes);
+            return start;
+        }
+
+        // Settles the response body, whose size is only known once it has arrived.
+        void charge(Lane& lane, size_t bytes) noexcept {
+            std::lock_guard lock(lane.pace_mutex);
+            lane.next_send = std::max(lane.next_send, Clock::now()) + cost_of(bytes);
+        }
+
+        [[nodiscard]] auto cost_of(size_t bytes) const noexcept -> Clock::duration {
+            return std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(
+                static_cast<int64_t>(static_cast<double>(bytes) * 1e9 / static_cast<double>(options_.bulk_bytes_per_second))));
+        }
+
+        [[nodiscard]] auto lane(Priority priority) noexcept -> Lane& {
+            return priority == Priority::Bulk ? bulk_ : interactive_;
+        }
+
+        [[nodiscard]] auto lane(Priority priority) const noexcept -> const Lane& {
+            return priority == Priority::Bulk ? bulk_ : interactive_;
+        }
+
+        PriorityOptions options_;
+        Lane interactive_;
+        Lane bulk_;
+    };
+
+} // namespace httpcpp
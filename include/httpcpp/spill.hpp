@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace httpcpp {
+
+    // Bodies larger than `threshold` bytes (0 disables spilling) are streamed into an unlinked
+    // file instead of the receive buffer and handed back as a read-only mapping. With a null
+    // `directory` the file is a memfd; otherwise it is an O_TMPFILE inside that directory, which
+    // lets the kernel write the pages back to disk under memory pressure.
+    //
+    // Only unsafe responses keep a spilled body out of memory: the mapping lives in the protocol
+    // until the next request. A safe response owns its body as a vector, so the mapping is
+    // copied into one, and such a body is in memory once the request returns.
+    struct SpillPolicy {
+        size_t threshold = 0;
+        const char* directory = nullptr;
+    };
+
+    // Owns the spill file descriptor while the body is written and the read-only mapping after.
+    class SpillFile {
+    public:
+        SpillFile() noexcept = default;
+        SpillFile(const SpillFile&) = delete;
+        SpillFile& operator=(const SpillFile&) = delete;
+        SpillFile(SpillFile&& other) noexcept
+            : fd_(std::exchange(other.fd_, -1)),
+              mapping_(std::exchange(other.mapping_, nullptr)),
+              mapping_len_(std::exchange(other.mapping_len_, 0)),
+              body_len_(std::exchange(other.body_len_, 0)) {}
+        SpillFile& operator=(SpillFile&& other) noexcept {
+            if (this != &other) {
+                reset();
+                fd_ = std::exchange(other.fd_, -1);
+                mapping_ = std::exchange(other.mapping_, nullptr);
+                mapping_len_ = std::exchange(other.mapping_len_, 0);
+                body_len_ = std::exchange(other.body_len_, 0);
+            }
+            return *this;
+        }
+        ~SpillFile() noexcept { reset(); }
+
+        [[nodiscard]] auto open(const SpillPolicy& policy) noexcept -> bool {
+            reset();
+            fd_ = policy.directory ? ::open(policy.directory, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600)
+                                   : ::memfd_create("httpcpp-body", MFD_CLOEXEC);
+            return fd_ >= 0;
+        }
+
+        [[nodiscard]] auto write(std::span<const std::byte> data) noexcept -> bool {
+            while (!data.empty()) {
+                ssize_t n = ::write(fd_, data.data(), data.size());
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                data = data.subspan(static_cast<size_t>(n));
+                body_len_ += static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        // Maps the written body plus `padding` zeroed bytes read-only and releases the descriptor.
+        [[nodiscard]] auto map(size_t padding) noexcept -> bool {
+            const size_t length = body_len_ + padding;
+            if (length == 0 || ::ftruncate(fd_, static_cast<off_t>(length)) != 0) {
+                return false;
+            }
+            void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd_, 0);
+            ::close(std::exchange(fd_, -1));
+            if (mapping == MAP_FAILED) {
+                return false;
+            }
+            mapping_ = mapping;
+            mapping_len_ = length;
+            return true;
+        }
+
+        [[nodiscard]] auto body() const noexcept -> std::span<const std::byte> {
+            return {static_cast<const std::byte*>(mapping_), mapping_ ? body_len_ : 0};
+        }
+
+        [[nodiscard]] auto size() const noexcept -> size_t { return body_len_; }
+
+        void reset() noexcept {
+            if (fd_ >= 0) {
+                ::close(std::exchange(fd_, -1));
+            }
+            if (mapping_) {
+                ::munmap(std::exchange(mapping_, nullptr), mapping_len_);
+            }
+            mapping_len_ = 0;
+            body_len_ = 0;
+        }
+
+    private:
+        int fd_ = -1;
+        void* mapping_ = nullptr;
+        size_t mapping_len_ = 0;
+        size_t body_len_ = 0;
+    };
+
+} // namespace httpcpp
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace httpcpp {
+
+    // Copies at or above this size bypass the cache: a multi-megabyte body copied with ordinary
+    // stores would otherwise evict the caller's L2/L3 working set for data it may never reread.
+    inline constexpr size_t NON_TEMPORAL_COPY_THRESHOLD = 256 * 1024;
+
+    // memcpy using streaming (non-temporal) stores where the target supports them.
+    inline void stream_copy(void* dst, const void* src, size_t n) noexcept {
+#if defined(__SSE2__)
+        auto* d = static_cast<unsigned char*>(dst);
+        const auto* s = static_cast<const unsigned char*>(src);
+
+        const size_t head = std::min(n, (16 - (reinterpret_cast<std::uintptr_t>(d) & 15)) & 15);
+        std::memcpy(d, s, head);
+        d += head;
+        s += head;
+        n -= head;
+
+        for (; n >= 64; d += 64, s += 64, n -= 64) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+            const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+        }
+        for (; n >= 16; d += 16, s += 16, n -= 16) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+        }
+        // Streaming stores are weakly ordered; fence before the data is published.
+        _mm_sfence();
+        std::memcpy(d, s, n);
+#else
+        std::memcpy(dst, src, n);
+#endif
+    }
+
+    inline void copy_bytes(void* dst, const void* src, size_t n) noexcept {
+        if (n >= NON_TEMPORAL_COPY_THRESHOLD) {
+            stream_copy(dst, src, n);
+        } else {
+            std::memcpy(dst, src, n);
+        }
+    }
+
+    // std::allocator that default-initializes instead of value-initializing, so resizing a
+    // vector of bytes that copy_bytes is about to overwrite does not zero it first: that
+    // extra pass writes the whole destination through the cache and would undo stream_copy.
+    template<typename T>
+    class DefaultInitAllocator : public std::allocator<T> {
+    public:
+        template<typename U>
+        struct rebind {
+            using other = DefaultInitAllocator<U>;
+        };
+
+        DefaultInitAllocator() noexcept = default;
+
+        template<typename U>
+        DefaultInitAllocator(const DefaultInitAllocator<U>&) noexcept {}
+
+        template<typename U>
+        void construct(U* pointer) noexcept(std::is_nothrow_default_constructible_v<U>) {
+            ::new (static_cast<void*>(pointer)) U;
+        }
+
+        template<typename U, typename... Args>
+        void construct(U* pointer, Args&&... args) {
+            std::construct_at(pointer, std::forward<Args>(args)...);
+        }
+    };
+
+    // A response body that copy_bytes fills; its bytes are indeterminate until written.
+    using ByteBuffer = std::vector<std::byte, DefaultInitAllocator<std::byte>>;
+
+} // namespace httpcpp
@@ -22,14 +22,28 @@ namespace httpcpp {
         [[nodiscard]] auto connect(const char* host, uint16_t port) noexcept -> std::expected<void, TransportError>;
         [[nodiscard]] auto close() noexcept -> std::expected<void, TransportError>;
         [[nodiscard]] auto write(std::span<const std::byte> data) noexcept -> std::expected<size_t, TransportError>;
+        [[nodiscard]] auto write_vectored(std::span<const std::span<const std::byte>> buffers) noexcept -> std::expected<size_t, TransportError>;
         [[nodiscard]] auto read(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError>;
+        [[nodiscard]] auto read_exact(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError>;
+        [[nodiscard]] auto is_stale() const noexcept -> bool;
+        // The connected socket, or -1.
+        [[nodiscard]] auto native_handle() noexcept -> int;
+
+        // Opt-in TCP Fast Open for subsequent connects: the handshake is deferred to the first
+        // write, whose bytes ride in the SYN once the kernel holds a cookie for the server. A
+        // refused connection then surfaces from that write rather than from connect().
+        void set_fast_open(bool enabled) noexcept;
 
     private:
         net::io_context io_context_;
         net::ip::tcp::socket socket_;
+        bool fast_open_ = false;
     };
 
-    static_assert(Transport<TcpTransport>);
+    static_assert(StaleCheckingTransport<TcpTransport>);
+    static_assert(ExactReadTransport<TcpTransport>);
+    static_assert(VectoredWriteTransport<TcpTransport>);
+    static_assert(SocketTransport<TcpTransport>);
 
 
 } // namespace httpcpp
\ No newline at end of file
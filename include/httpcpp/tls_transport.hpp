@@ -0,0 +1,414 @@
+#pragma once
+
+#include <httpcpp/transport.hpp>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+#include <algorithm>
+#include <csignal>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <pthread.h>
+
+namespace httpcpp {
+
+    struct TlsOptions {
+        // PEM file of trusted certificates, e.g. a self-signed server certificate; empty uses the
+        // system's default store.
+        std::string ca_file;
+        bool verify_peer = true;
+        // Offer the session ticket from the previous connection to the same host and port, so a
+        // reconnect costs an abbreviated handshake without the certificate exchange.
+        bool resume_sessions = true;
+        // Let OpenSSL hand record encryption to the kernel (kTLS) once the handshake is done, where
+        // both the library and the kernel support it.
+        bool kernel_tls = true;
+    };
+
+    // An SSL_CTX plus the session tickets received through it, keyed by "host:port". Transports
+    // sharing a context resume each other's sessions; a ticket is handed out once, as TLS 1.3
+    // recommends, and replaced by the tickets the resumed connection receives.
+    class TlsContext {
+    public:
+        [[nodiscard]] static auto create(TlsOptions options = {}) noexcept -> std::expected<std::shared_ptr<TlsContext>, TransportError> {
+            std::shared_ptr<TlsContext> context(new (std::nothrow) TlsContext(std::move(options)));
+            if (!context || !context->ctx_) {
+                return std::unexpected(TransportError::InitFailure);
+            }
+            SSL_CTX* ctx = context->ctx_.get();
+            SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
+            // A peer closing without close_notify reads as end of stream, as it does over plain TCP.
+            SSL_CTX_set_options(ctx, SSL_OP_IGNORE_UNEXPECTED_EOF);
+#ifdef SSL_OP_ENABLE_KTLS
+            if (context->options_.kernel_tls) {
+                SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+            }
+#endif
+            if (context->options_.verify_peer) {
+                const bool loaded = context->options_.ca_file.empty()
+                    ? SSL_CTX_set_default_verify_paths(ctx) == 1
+                    : SSL_CTX_load_verify_locations(ctx, context->options_.ca_file.c_str(), nullptr) == 1;
+                if (!loaded) {
+                    ERR_clear_error();
+                    return std::unexpected(TransportError::InitFailure);
+                }
+                SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, nullptr);
+            }
+            if (context->options_.resume_sessions) {
+                // Tickets are kept here rather than in OpenSSL's internal cache, which has no
+                // notion of which host and port a session belongs to.
+                SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+                SSL_CTX_set_app_data(ctx, context.get());
+                SSL_CTX_sess_set_new_cb(ctx, &TlsContext::on_new_session);
+            }
+            return context;
+        }
+
+        // The context TlsTransport falls back to: system trust store, resumption and kTLS on.
+        [[nodiscard]] static auto shared_default() noexcept -> std::expected<std::shared_ptr<TlsContext>, TransportError> {
+            static const auto context = create();
+            return context;
+        }
+
+        TlsContext(const TlsContext&) = delete;
+        TlsContext& operator=(const TlsContext&) = delete;
+
+        ~TlsContext() {
+            for (auto& [key, session] : sessions_) {
+                SSL_SESSION_free(session);
+            }
+        }
+
+        [[nodiscard]] auto native_handle() const noexcept -> SSL_CTX* {
+            return ctx_.get();
+        }
+
+        [[nodiscard]] auto options() const noexcept -> const TlsOptions& {
+            return options_;
+        }
+
+        // The stored ticket for `key`, which the caller now owns, or nullptr.
+        [[nodiscard]] auto take_session(std::string_view key) noexcept -> SSL_SESSION* {
+            std::lock_guard lock(mutex_);
+            auto it = sessions_.find(key);
+            if (it == sessions_.end()) {
+                return nullptr;
+            }
+            SSL_SESSION* session = it->second;
+            sessions_.erase(it);
+            return session;
+        }
+
+    private:
+        explicit TlsContext(TlsOptions options) noexcept
+            : options_(std::move(options)), ctx_(SSL_CTX_new(TLS_client_method()), &SSL_CTX_free) {}
+
+        // OpenSSL calls this for every ticket, which in TLS 1.3 arrives after the handshake,
+        // while the response is read. Returning 1 keeps the reference OpenSSL passed in.
+        static auto on_new_session(SSL* ssl, SSL_SESSION* session) noexcept -> int {
+            auto* self = static_cast<TlsContext*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+            const auto* key = static_cast<const std::string*>(SSL_get_app_data(ssl));
+            if (self == nullptr || key == nullptr || !SSL_SESSION_is_resumable(session)) {
+                return 0;
+            }
+            std::lock_guard lock(self->mutex_);
+            auto [it, inserted] = self->sessions_.try_emplace(*key, session);
+            if (!inserted) {
+                SSL_SESSION_free(it->second);
+                it->second = session;
+            }
+            return 1;
+        }
+
+        TlsOptions options_;
+        std::unique_ptr<SSL_CTX, decltype(&SSL_CTX_free)> ctx_;
+        std::mutex mutex_;
+        std::map<std::string, SSL_SESSION*, std::less<>> sessions_;
+    };
+
+    namespace detail {
+        // OpenSSL writes to its socket with write(2), which raises SIGPIPE once the peer is gone.
+        // Blocks the signal for the calling thread and discards one raised meanwhile, so a closed
+        // peer is a write error as with the MSG_NOSIGNAL sends of the plain transports. Costs one
+        // system call when the process already ignores SIGPIPE, and four otherwise.
+        class SigpipeGuard {
+        public:
+            SigpipeGuard() noexcept {
+                struct sigaction current{};
+                if (sigaction(SIGPIPE, nullptr, &current) == 0 && current.sa_handler == SIG_IGN) {
+                    return;
+                }
+                sigemptyset(&sigpipe_);
+                sigaddset(&sigpipe_, SIGPIPE);
+                sigset_t pending;
+                sigpending(&pending);
+                was_pending_ = sigismember(&pending, SIGPIPE) == 1;
+                blocked_ = pthread_sigmask(SIG_BLOCK, &sigpipe_, &previous_) == 0;
+            }
+
+            ~SigpipeGuard() {
+                if (!blocked_) {
+                    return;
+                }
+                if (!was_pending_) {
+                    sigset_t pending;
+                    sigpending(&pending);
+                    if (sigismember(&pending, SIGPIPE) == 1) {
+                        const timespec no_wait{0, 0};
+                        (void)sigtimedwait(&sigpipe_, nullptr, &no_wait);
+                    }
+                }
+                pthread_sigmask(SIG_SETMASK, &previous_, nullptr);
+            }
+
+            SigpipeGuard(const SigpipeGuard&) = delete;
+            SigpipeGuard& operator=(const SigpipeGuard&) = delete;
+
+        private:
+            sigset_t sigpipe_{};
+            sigset_t previous_{};
+            bool was_pending_ = false;
+            bool blocked_ = false;
+        };
+
+        [[nodiscard]] inline auto is_ip_literal(const char* host) noexcept -> bool {
+            unsigned char address[sizeof(in6_addr)];
+            return inet_pton(AF_INET, host, address) == 1 || inet_pton(AF_INET6, host, address) == 1;
+        }
+    } // namespace detail
+
+    // TLS over any socket transport. `Inner` connects the socket; OpenSSL then runs the handshake
+    // on its descriptor. When OpenSSL switched the socket to kernel TLS for sending, writes go
+    // straight through `Inner` again, so its send and sendmsg paths are kept and the kernel
+    // encrypts; otherwise they go through SSL_write. Reads always go through SSL_read, which
+    // also processes the session tickets a TLS 1.3 server sends after the handshake.
+    //
+    // Not movable: OpenSSL holds a pointer to the transport's session key while connected.
+    template<SocketTransport Inner>
+    class TlsTransport {
+    public:
+        TlsTransport() noexcept = default;
+
+        ~TlsTransport() noexcept {
+            (void)close();
+        }
+
+        TlsTransport(const TlsTransport&) = delete;
+        TlsTransport& operator=(const TlsTransport&) = delete;
+        TlsTransport(TlsTransport&&) = delete;
+        TlsTransport& operator=(TlsTransport&&) = delete;
+
+        // Takes effect from the next connect(). Without one, TlsContext::shared_default() is used.
+        void set_context(std::shared_ptr<TlsContext> context) noexcept {
+            context_ = std::move(context);
+        }
+
+        // Access to the wrapped transport's configuration (e.g. TcpTransport::set_fast_open).
+        [[nodiscard]] auto inner() noexcept -> Inner& {
+            return inner_;
+        }
+
+        [[nodiscard]] auto connect(const char* host, uint16_t port) noexcept -> std::expected<void, TransportError> {
+            (void)close();
+            if (!context_) {
+                auto fallback = TlsContext::shared_default();
+                if (!fallback) {
+                    return std::unexpected(fallback.error());
+                }
+                context_ = *fallback;
+            }
+            // Pinned until close(): the new-session callback reaches the context through the SSL.
+            session_context_ = context_;
+            if (auto connected = inner_.connect(host, port); !connected) {
+                return connected;
+            }
+
+            detail::SigpipeGuard guard;
+            ERR_clear_error();
+            ssl_.reset(SSL_new(session_context_->native_handle()));
+            if (!ssl_ || SSL_set_fd(ssl_.get(), inner_.native_handle()) != 1) {
+                return fail_handshake(TransportError::InitFailure);
+            }
+            session_key_.assign(host);
+            session_key_ += ':';
+            session_key_ += std::to_string(port);
+            SSL_set_app_data(ssl_.get(), &session_key_);
+
+            const bool literal = detail::is_ip_literal(host);
+            if (!literal) {
+                SSL_set_tlsext_host_name(ssl_.get(), host);
+            }
+            if (session_context_->options().verify_peer) {
+                const int checked = literal ? X509_VERIFY_PARAM_set1_ip_asc(SSL_get0_param(ssl_.get()), host)
+                                            : SSL_set1_host(ssl_.get(), host);
+                if (checked != 1) {
+                    return fail_handshake(TransportError::InitFailure);
+                }
+            }
+            if (session_context_->options().resume_sessions) {
+                if (SSL_SESSION* session = session_context_->take_session(session_key_)) {
+                    SSL_set_session(ssl_.get(), session);
+                    SSL_SESSION_free(session);
+                }
+            }
+
+            if (SSL_connect(ssl_.get()) != 1) {
+                return fail_handshake(TransportError::TlsHandshakeFailure);
+            }
+            session_reused_ = SSL_session_reused(ssl_.get()) == 1;
+#ifndef OPENSSL_NO_KTLS
+            kernel_tls_send_ = BIO_get_ktls_send(SSL_get_wbio(ssl_.get()));
+#endif
+            return {};
+        }
+
+        // Sends close_notify without waiting for the peer's, then closes the socket.
+        [[nodiscard]] auto close() noexcept -> std::expected<void, TransportError> {
+            if (ssl_) {
+                detail::SigpipeGuard guard;
+                (void)SSL_shutdown(ssl_.get());
+                ssl_.reset();
+                ERR_clear_error();
+            }
+            session_context_.reset();
+            session_reused_ = false;
+            kernel_tls_send_ = false;
+            return inner_.close();
+        }
+
+        [[nodiscard]] auto write(std::span<const std::byte> data) noexcept -> std::expected<size_t, TransportError> {
+            if (kernel_tls_send_) {
+                return inner_.write(data);
+            }
+            if (!ssl_) {
+                return std::unexpected(TransportError::SocketWriteFailure);
+            }
+            detail::SigpipeGuard guard;
+            return write_records(data);
+        }
+
+        // With kTLS and a VectoredWriteTransport the buffers leave in Inner's sendmsg calls;
+        // otherwise small buffers are packed into full-sized records instead of one record each.
+        [[nodiscard]] auto write_vectored(std::span<const std::span<const std::byte>> buffers) noexcept
+            -> std::expected<size_t, TransportError> {
+            if constexpr (VectoredWriteTransport<Inner>) {
+                if (kernel_tls_send_) {
+                    return inner_.write_vectored(buffers);
+                }
+            }
+            if (!ssl_ && !kernel_tls_send_) {
+                return std::unexpected(TransportError::SocketWriteFailure);
+            }
+            detail::SigpipeGuard guard;
+            size_t total = 0;
+            staging_.clear();
+            for (const auto& part : buffers) {
+                total += part.size();
+                if (staging_.size() + part.size() <= MAX_RECORD_) {
+                    staging_.insert(staging_.end(), part.begin(), part.end());
+                    continue;
+                }
+                if (auto flushed = flush_staging(); !flushed) {
+                    return flushed;
+                }
+                if (part.size() >= MAX_RECORD_) {
+                    if (auto sent = send_all(part); !sent) {
+                        return sent;
+                    }
+                } else {
+                    staging_.assign(part.begin(), part.end());
+                }
+            }
+            if (auto flushed = flush_staging(); !flushed) {
+                return flushed;
+            }
+            return total;
+        }
+
+        [[nodiscard]] auto read(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError> {
+            if (!ssl_) {
+                return std::unexpected(TransportError::SocketReadFailure);
+            }
+            size_t bytes_read = 0;
+            ERR_clear_error();
+            if (SSL_read_ex(ssl_.get(), buffer.data(), buffer.size(), &bytes_read) == 1) {
+                return bytes_read;
+            }
+            const int error = SSL_get_error(ssl_.get(), 0);
+            ERR_clear_error();
+            if (error == SSL_ERROR_ZERO_RETURN) {
+                return std::unexpected(TransportError::ConnectionClosed);
+            }
+            return std::unexpected(TransportError::SocketReadFailure);
+        }
+
+        [[nodiscard]] auto session_reused() const noexcept -> bool {
+            return session_reused_;
+        }
+
+        // Whether the kernel encrypts what this connection sends (kTLS).
+        [[nodiscard]] auto kernel_tls_send() const noexcept -> bool {
+            return kernel_tls_send_;
+        }
+
+    private:
+        // The payload limit of one TLS record.
+        static constexpr size_t MAX_RECORD_ = 16 * 1024;
+
+        [[nodiscard]] auto fail_handshake(TransportError error) noexcept -> std::unexpected<TransportError> {
+            ssl_.reset();
+            ERR_clear_error();
+            session_context_.reset();
+            (void)inner_.close();
+            return std::unexpected(error);
+        }
+
+        [[nodiscard]] auto write_records(std::span<const std::byte> data) noexcept -> std::expected<size_t, TransportError> {
+            size_t written = 0;
+            ERR_clear_error();
+            if (SSL_write_ex(ssl_.get(), data.data(), data.size(), &written) != 1) {
+                ERR_clear_error();
+                return std::unexpected(TransportError::SocketWriteFailure);
+            }
+            return written;
+        }
+
+        // Every byte of `data`, through the kernel or OpenSSL, whichever encrypts.
+        [[nodiscard]] auto send_all(std::span<const std::byte> data) noexcept -> std::expected<size_t, TransportError> {
+            size_t sent = 0;
+            while (sent < data.size()) {
+                auto result = kernel_tls_send_ ? inner_.write(data.subspan(sent)) : write_records(data.subspan(sent));
+                if (!result) {
+                    return result;
+                }
+                sent += *result;
+            }
+            return sent;
+        }
+
+        [[nodiscard]] auto flush_staging() noexcept -> std::expected<size_t, TransportError> {
+            auto sent = send_all(staging_);
+            staging_.clear();
+            return sent;
+        }
+
+        Inner inner_;
+        std::shared_ptr<TlsContext> context_;
+        std::shared_ptr<TlsContext> session_context_;
+        std::unique_ptr<SSL, decltype(&SSL_free)> ssl_{nullptr, &SSL_free};
+        std::string session_key_;
+        std::vector<std::byte> staging_;
+        bool session_reused_ = false;
+        bool kernel_tls_send_ = false;
+    };
+
+} // namespace httpcpp
@@ -21,4 +21,41 @@ namespace httpcpp {
         { t.read(buffer) } noexcept -> std::same_as<std::expected<size_t, TransportError>>;
                                   };
 
+    // Transports that can tell, without blocking, whether an idle connection is still usable:
+    // `is_stale()` is true once the peer has closed or reset it, or sent bytes nobody asked for.
+    template<typename T>
+    concept StaleCheckingTransport = Transport<T> && requires(const T t) {
+        { t.is_stale() } noexcept -> std::same_as<bool>;
+    };
+
+    // Transports that can block until a whole buffer has arrived (recv with MSG_WAITALL), so a
+    // body of known length costs one call instead of one per segment. `read_exact` has `read`'s
+    // contract: it may still return fewer bytes when the peer closes or a signal interrupts it.
+    template<typename T>
+    concept ExactReadTransport = Transport<T> && requires(T t, std::span<std::byte> buffer) {
+        { t.read_exact(buffer) } noexcept -> std::same_as<std::expected<size_t, TransportError>>;
+    };
+
+    // Transports that can send several buffers with one gathering system call (sendmsg), so a
+    // request head and a body held in separate buffers need neither a copy nor a write each.
+    // Unlike `write`, `write_vectored` sends every byte before it returns, or fails.
+    template<typename T>
+    concept VectoredWriteTransport = Transport<T> && requires(T t, std::span<const std::span<const std::byte>> buffers) {
+        { t.write_vectored(buffers) } noexcept -> std::same_as<std::expected<size_t, TransportError>>;
+    };
+
+    // Transports backed by one connected socket whose descriptor others may drive directly, as
+    // TlsTransport does when it hands the socket to OpenSSL and, with kTLS, to the kernel.
+    template<typename T>
+    concept SocketTransport = Transport<T> && requires(T t) {
+        { t.native_handle() } noexcept -> std::same_as<int>;
+    };
+
+    // Transports that encrypt, and so can carry https:// URLs. `session_reused()` tells whether
+    // the last handshake resumed an earlier session instead of running a full one.
+    template<typename T>
+    concept SecureTransport = Transport<T> && requires(const T t) {
+        { t.session_reused() } noexcept -> std::same_as<bool>;
+    };
+
 } // namespace httpcpp
\ No newline at end of file
@@ -17,12 +17,20 @@ namespace httpcpp {
         [[nodiscard]] auto connect(const char* path, uint16_t port) noexcept -> std::expected<void, TransportError>;
         [[nodiscard]] auto close() noexcept -> std::expected<void, TransportError>;
         [[nodiscard]] auto write(std::span<const std::byte> data) noexcept -> std::expected<size_t, TransportError>;
+        [[nodiscard]] auto write_vectored(std::span<const std::span<const std::byte>> buffers) noexcept -> std::expected<size_t, TransportError>;
         [[nodiscard]] auto read(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError>;
+        [[nodiscard]] auto read_exact(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError>;
+        [[nodiscard]] auto is_stale() const noexcept -> bool;
+        // The connected socket, or -1.
+        [[nodiscard]] auto native_handle() noexcept -> int;
 
     private:
         int fd_ = -1;
     };
 
-    static_assert(Transport<UnixTransport>);
+    static_assert(StaleCheckingTransport<UnixTransport>);
+    static_assert(ExactReadTransport<UnixTransport>);
+    static_assert(VectoredWriteTransport<UnixTransport>);
+    static_assert(SocketTransport<UnixTransport>);
 
 } // namespace httpcpp
\ No newline at end of file
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <httpcpp/error.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <string_view>
+
+namespace httpcpp {
+
+    // The parts of an absolute http(s) URL, as views into the parsed string. Nothing is decoded
+    // or copied, so a Url is only valid while the string it came from is.
+    struct Url {
+        std::string_view scheme;    // lower- or upper-case, as written
+        std::string_view authority; // host[:port] as written, for the Host header
+        std::string_view host;      // without the brackets of an IPv6 literal
+        uint16_t port = 0;          // explicit port, or the scheme's default
+        std::string_view path;      // "/" when the URL has none
+        std::string_view query;     // without the '?'
+        std::string_view target;    // path and query as sent in the request line
+    };
+
+    namespace detail {
+        [[nodiscard]] constexpr auto iequals(std::string_view a, std::string_view b) noexcept -> bool {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < a.size(); ++i) {
+                const char ca = (a[i] >= 'A' && a[i] <= 'Z') ? static_cast<char>(a[i] - 'A' + 'a') : a[i];
+                if (ca != b[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // True if `text` holds a byte <= ' ' or DEL. At run time this checks eight bytes per
+        // step, which is most of what keeps parse_url() cheap.
+        [[nodiscard]] constexpr auto has_control_character(std::string_view text) noexcept -> bool {
+            size_t i = 0;
+            if !consteval {
+                constexpr uint64_t ones = 0x0101010101010101ull;
+                constexpr uint64_t highs = 0x8080808080808080ull;
+                for (; i + 8 <= text.size(); i += 8) {
+                    uint64_t word;
+                    std::memcpy(&word, text.data() + i, sizeof(word));
+                    const uint64_t below_bang = (word - ones * '!') & ~word;
+                    const uint64_t del = word ^ (ones * 0x7f);
+                    if (((below_bang | ((del - ones) & ~del)) & highs) != 0) {
+                        return true;
+                    }
+                }
+            }
+            for (; i < text.size(); ++i) {
+                const auto byte = static_cast<unsigned char>(text[i]);
+                if (byte <= ' ' || byte == 0x7f) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    } // namespace detail
+
+    // Parses "scheme://host[:port][/path][?query][#fragment]" for the http and https schemes.
+    // The fragment is dropped, as it never goes on the wire. URLs with user info, an empty host,
+    // a port outside 1..65535, a query without a path, or whitespace and control characters are
+    // rejected. Returns views into `text`, so it never allocates and works in constant expressions.
+    [[nodiscard]] constexpr auto parse_url(std::string_view text) noexcept -> std::expected<Url, HttpClientError> {
+        const auto fail = std::unexpected(HttpClientError::UrlParseFailure);
+        constexpr auto npos = std::string_view::npos;
+
+        if (detail::has_control_character(text)) {
+            return fail;
+        }
+
+        Url url;
+        const size_t colon = text.find(':');
+        url.scheme = text.substr(0, colon);
+        if (detail::iequals(url.scheme, "http")) {
+            url.port = 80;
+        } else if (detail::iequals(url.scheme, "https")) {
+            url.port = 443;
+        } else {
+            return fail;
+        }
+        if (colon == npos || text.substr(colon, 3) != "://") {
+            return fail;
+        }
+        text.remove_prefix(colon + 3);
+        text = text.substr(0, text.find('#'));
+
+        const size_t authority_end = std::min(text.find('/'), text.find('?'));
+        url.authority = text.substr(0, authority_end);
+        if (url.authority.find('@') != npos) {
+            return fail;
+        }
+
+        std::string_view port;
+        if (url.authority.starts_with('[')) {
+            const size_t close = url.authority.find(']');
+            if (close == npos) {
+                return fail;
+            }
+            url.host = url.authority.substr(1, close - 1);
+            const std::string_view rest = url.authority.substr(close + 1);
+            if (!rest.empty()) {
+                if (rest.front() != ':') {
+                    return fail;
+                }
+                port = rest.substr(1);
+                if (port.empty()) {
+                    return fail;
+                }
+            }
+        } else {
+            const size_t port_colon = url.authority.find(':');
+            url.host = url.authority.substr(0, port_colon);
+            if (port_colon != npos) {
+                port = url.authority.substr(port_colon + 1);
+                if (port.empty()) {
+                    return fail;
+                }
+            }
+        }
+        if (url.host.empty()) {
+            return fail;
+        }
+        if (!port.empty()) {
+            uint32_t value = 0;
+            for (const char c : port) {
+                if (c < '0' || c > '9' || value > 6553) {
+                    return fail;
+                }
+                value = value * 10 + static_cast<uint32_t>(c - '0');
+            }
+            if (value == 0 || value > 65535) {
+                return fail;
+            }
+            url.port = static_cast<uint16_t>(value);
+        }
+
+        if (authority_end == npos) {
+            url.path = "/";
+            url.target = "/";
+            return url;
+        }
+        url.target = text.substr(authority_end);
+        if (url.target.front() == '?') {
+            return fail;
+        }
+        const size_t question = url.target.find('?');
+        url.path = url.target.substr(0, question);
+        if (question != npos) {
+            url.query = url.target.substr(question + 1);
+        }
+        return url;
+    }
+
+} // namespace httpcpp
@@ -1,3 +1,3 @@
 #!/usr/bin/env bash
-sudo apt-get update && sudo apt-get install -y llvm lcov hyperfine libcurl4-openssl-dev libboost-all-dev
+sudo apt-get update && sudo apt-get install -y llvm lcov hyperfine libcurl4-openssl-dev libssl-dev libboost-all-dev
 cargo install cargo-llvm-cov
\ No newline at end of file
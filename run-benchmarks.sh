@@ -11,6 +11,10 @@ set -e
 NUM_REQUESTS_THROUGHPUT=50000
 NUM_REQUESTS_LATENCY=300000
 NUM_REQUESTS_MIXED=75000
+NUM_CONNECTIONS_RECONNECT=5000
+NUM_REQUESTS_BALANCER=2000
+BALANCER_THREADS=4
+NUM_REQUESTS_PRIORITY=2000
 WARMUP_RUNS=1
 BENCHMARK_RUNS=30
 
@@ -115,6 +119,103 @@ function run_benchmark_scenario {
     done
 }
 
+# One short-lived connection per request: measures time to first byte with and without TCP Fast Open.
+function run_reconnect_scenario {
+    local scenario_name="reconnect_small"
+    local server_prefix="sudo taskset -c ${SERVER_CORE}"
+    local client_prefix="sudo taskset -c ${CLIENT_CORE}"
+    local server_cmd="$server_prefix ./benchmark/benchmark_server --transport tcp --host $TCP_HOST --port $TCP_PORT --verify false --connections $NUM_CONNECTIONS_RECONNECT --min-length $SMALL_MIN --max-length $SMALL_MAX"
+
+    header "Running Scenario: '$scenario_name' (Transport: tcp) NUM_CONNECTIONS=$NUM_CONNECTIONS_RECONNECT"
+
+    local setup_cmd="$server_cmd & echo \$! > server.pid; sleep 2"
+    local cleanup_cmd="kill \$(cat server.pid) 2>/dev/null || true; rm -f server.pid; sleep 1"
+    local output_prefix="${LATENCY_DIR}/latencies"
+    local common_args="--host ${TCP_HOST} --port ${TCP_PORT} --connections ${NUM_CONNECTIONS_RECONNECT}"
+
+    hyperfine --prepare "$setup_cmd" --cleanup "$cleanup_cmd" \
+        --warmup ${WARMUP_RUNS} --runs ${BENCHMARK_RUNS} \
+        --export-markdown "hyperfine_results_${scenario_name}_tcp.md" \
+        "$client_prefix ./benchmark/reconnect_benchmark ${common_args} --output-file ${output_prefix}_reconnect_handshake.bin" \
+        "$client_prefix ./benchmark/reconnect_benchmark ${common_args} --fast-open --output-file ${output_prefix}_reconnect_fast_open.bin"
+}
+
+# The reconnect scenario over TLS with a self-signed certificate: full handshakes against resumed ones.
+function run_tls_reconnect_scenario {
+    local scenario_name="reconnect_tls_small"
+    local server_prefix="sudo taskset -c ${SERVER_CORE}"
+    local client_prefix="sudo taskset -c ${CLIENT_CORE}"
+    local tls_dir="${LATENCY_DIR}/tls"
+    mkdir -p "$tls_dir"
+    openssl req -x509 -newkey ec -pkeyopt ec_paramgen_curve:P-256 -nodes -days 1 -subj "/CN=localhost" \
+        -addext "subjectAltName=IP:${TCP_HOST},DNS:localhost" \
+        -keyout "${tls_dir}/key.pem" -out "${tls_dir}/cert.pem" &> /dev/null
+    local server_cmd="$server_prefix ./benchmark/benchmark_server --transport tcp --host $TCP_HOST --port $TCP_PORT --verify false --connections $NUM_CONNECTIONS_RECONNECT --min-length $SMALL_MIN --max-length $SMALL_MAX --tls-cert ${tls_dir}/cert.pem --tls-key ${tls_dir}/key.pem"
+
+    header "Running Scenario: '$scenario_name' (Transport: tcp+tls) NUM_CONNECTIONS=$NUM_CONNECTIONS_RECONNECT"
+
+    local setup_cmd="$server_cmd & echo \$! > server.pid; sleep 2"
+    local cleanup_cmd="kill \$(cat server.pid) 2>/dev/null || true; rm -f server.pid; sleep 1"
+    local output_prefix="${LATENCY_DIR}/latencies"
+    local common_args="--host ${TCP_HOST} --port ${TCP_PORT} --connections ${NUM_CONNECTIONS_RECONNECT} --tls --ca-file ${tls_dir}/cert.pem"
+
+    hyperfine --prepare "$setup_cmd" --cleanup "$cleanup_cmd" \
+        --warmup ${WARMUP_RUNS} --runs ${BENCHMARK_RUNS} \
+        --export-markdown "hyperfine_results_${scenario_name}_tcp.md" \
+        "$client_prefix ./benchmark/reconnect_benchmark ${common_args} --resume false --output-file ${output_prefix}_reconnect_tls_full.bin" \
+        "$client_prefix ./benchmark/reconnect_benchmark ${common_args} --resume true --output-file ${output_prefix}_reconnect_tls_resumed.bin"
+}
+
+# Three replicas of differing speed behind one client: compares how each policy spreads the load.
+function run_balancer_scenario {
+    local scenario_name="balancer_small"
+    local server_prefix="sudo taskset -c ${SERVER_CORE}"
+    local client_prefix="sudo taskset -c ${CLIENT_CORE}"
+    local total_requests=$((NUM_REQUESTS_BALANCER * BALANCER_THREADS))
+    local server_args="--transport tcp --host $TCP_HOST --verify false --num-responses $total_requests --min-length $SMALL_MIN --max-length $SMALL_MAX"
+
+    header "Running Scenario: '$scenario_name' (Transport: tcp) NUM_REQUESTS=$total_requests"
+
+    local setup_cmd="rm -f server.pid"
+    local endpoints=""
+    local port=8081
+    for delay_us in 0 200 1000; do
+        setup_cmd="$setup_cmd; $server_prefix ./benchmark/benchmark_server $server_args --port $port --delay-us $delay_us & echo \$! >> server.pid"
+        endpoints="$endpoints ${TCP_HOST}:$port"
+        port=$((port + 1))
+    done
+    setup_cmd="$setup_cmd; sleep 2"
+    local cleanup_cmd="kill \$(cat server.pid) 2>/dev/null || true; rm -f server.pid; sleep 1"
+    local common_args="--endpoint${endpoints} --threads ${BALANCER_THREADS} --requests ${NUM_REQUESTS_BALANCER}"
+
+    hyperfine --prepare "$setup_cmd" --cleanup "$cleanup_cmd" \
+        --warmup ${WARMUP_RUNS} --runs ${BENCHMARK_RUNS} \
+        --export-markdown "hyperfine_results_${scenario_name}_tcp.md" \
+        "$client_prefix ./benchmark/balancer_benchmark ${common_args} --policy round-robin" \
+        "$client_prefix ./benchmark/balancer_benchmark ${common_args} --policy p2c" \
+        "$client_prefix ./benchmark/balancer_benchmark ${common_args} --policy hash"
+}
+
+# Small requests timed while a bulk uploader keeps sending 1 MB bodies: shared connection vs priority lanes.
+function run_priority_lanes_scenario {
+    local scenario_name="priority_lanes_mixed"
+    local server_prefix="sudo taskset -c ${SERVER_CORE}"
+    local client_prefix="sudo taskset -c ${CLIENT_CORE}"
+    local server_cmd="$server_prefix ./benchmark/benchmark_server --transport tcp --host $TCP_HOST --port $TCP_PORT --verify false --concurrent --connections 2 --num-responses $((NUM_REQUESTS_PRIORITY * 2)) --min-length $SMALL_MIN --max-length $SMALL_MAX"
+
+    header "Running Scenario: '$scenario_name' (Transport: tcp) NUM_REQUESTS=$NUM_REQUESTS_PRIORITY"
+
+    local setup_cmd="$server_cmd & echo \$! > server.pid; sleep 2"
+    local cleanup_cmd="kill \$(cat server.pid) 2>/dev/null || true; rm -f server.pid; sleep 1"
+    local common_args="--host ${TCP_HOST} --port ${TCP_PORT} --small-requests ${NUM_REQUESTS_PRIORITY} --small-size ${SMALL_MIN} --bulk-size ${LARGE_MAX}"
+
+    hyperfine --prepare "$setup_cmd" --cleanup "$cleanup_cmd" \
+        --warmup ${WARMUP_RUNS} --runs ${BENCHMARK_RUNS} \
+        --export-markdown "hyperfine_results_${scenario_name}_tcp.md" \
+        "$client_prefix ./benchmark/priority_lanes_benchmark ${common_args} --mode shared" \
+        "$client_prefix ./benchmark/priority_lanes_benchmark ${common_args} --mode lanes"
+}
+
 # --- Main Execution ---
 
 
@@ -123,6 +224,8 @@ function run_benchmark_scenario {
 #set_performance_governor
 #sudo sysctl -w net.core.wmem_max=16777216
 #sudo sysctl -w net.core.rmem_max=16777216
+#sudo sysctl -w net.ipv4.tcp_fastopen=3  # client and server Fast Open, for the reconnect scenario
+#sudo modprobe tls  # kernel TLS, so the TLS reconnect scenario can hand encryption to the kernel
 
 cd "$BUILD_DIR"
 mkdir -p "$LATENCY_DIR"
@@ -143,6 +246,16 @@ run_benchmark_scenario "mixed_server_random"       $SMALL_MIN $SMALL_MAX $MIXED_
 run_benchmark_scenario "mixed_balanced_random"     $MIXED_MIN $MIXED_MAX $MIXED_MIN $MIXED_MAX $NUM_REQUESTS_MIXED
 run_benchmark_scenario "mixed_client_random"       $MIXED_MIN $MIXED_MAX $SMALL_MIN $SMALL_MAX $NUM_REQUESTS_MIXED
 
+# Connection Setup Scenario
+run_reconnect_scenario
+run_tls_reconnect_scenario
+
+# Load Balancing Scenario
+run_balancer_scenario
+
+# Head-of-Line Blocking Scenario
+run_priority_lanes_scenario
+
 header "All benchmarks complete!"
 echo "Latency files are in '${BUILD_DIR}/${LATENCY_DIR}'"
 echo "Hyperfine results are in '${BUILD_DIR}/hyperfine_results_*.md'"
@@ -1,8 +1,16 @@
+#define _GNU_SOURCE // memfd_create, O_TMPFILE
+
 #include <httpc/http1_protocol.h>
+#include <httpc/integrity.h>
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#define HTTP1_SPILL_WINDOW_SIZE (64 * 1024)
 
 static Error growable_buffer_append(Http1Protocol* self, GrowableBuffer* buf, const void* data, size_t len) {
     if (buf->len + len > buf->capacity) {
@@ -97,6 +105,182 @@ static Error build_request_in_buffer(Http1Protocol* self, const HttpRequest* req
     return err;
 }
 
+static Error http1_buffer_reserve(Http1Protocol* self, HttpResponse* response, bool headers_parsed, size_t capacity) {
+    if (self->buffer.capacity >= capacity) {
+        return (Error){ErrorType.NONE, 0};
+    }
+    char* old_data = self->buffer.data;
+    char* new_data = self->syscalls->realloc(self->buffer.data, capacity);
+    if (!new_data) {
+        return (Error){ErrorType.HTTPC, HttpClientErrorCode.HTTP_PARSE_FAILURE};
+    }
+    self->buffer.data = new_data;
+    self->buffer.capacity = capacity;
+
+    // Handle the fact that our pointers may have moved for a large enough realloc
+    if (headers_parsed && old_data != new_data) {
+        ptrdiff_t offset = new_data - old_data;
+        response->status_message += offset;
+        for (size_t i = 0; i < response->num_headers; ++i) {
+            response->headers[i].key += offset;
+            response->headers[i].value += offset;
+        }
+    }
+    return (Error){ErrorType.NONE, 0};
+}
+
+static size_t http1_size_predictor_predict(const HttpSizePredictor* predictor) {
+    return predictor->samples == 0 ? 0 : predictor->mean + 2 * predictor->deviation;
+}
+
+static void http1_size_predictor_observe(HttpSizePredictor* predictor, size_t predicted, size_t actual) {
+    if (predicted > 0) {
+        predictor->predictions++;
+        predictor->hits += actual <= predicted ? 1 : 0;
+    }
+    if (predictor->samples++ == 0) {
+        predictor->mean = actual;
+        predictor->deviation = actual / 4;
+        return;
+    }
+    size_t error = actual > predictor->mean ? actual - predictor->mean : predictor->mean - actual;
+    predictor->deviation = predictor->deviation - predictor->deviation / 4 + error / 4;
+    predictor->mean = predictor->mean - predictor->mean / 8 + actual / 8;
+}
+
+static size_t http1_body_alignment_gap(const Http1Protocol* self, size_t header_len) {
+    if (self->body_alignment == 0) {
+        return 0;
+    }
+    uintptr_t start = (uintptr_t)(self->buffer.data + header_len);
+    return (self->body_alignment - (start & (self->body_alignment - 1))) & (self->body_alignment - 1);
+}
+
+// Folds body bytes that arrived since the last call into the running digest, while they are still
+// hot from the read that delivered them.
+static void http1_integrity_update(Http1Protocol* self, size_t body_offset, size_t body_limit, size_t* hashed, uint32_t* crc) {
+    size_t available = self->buffer.len - body_offset;
+    if (available > body_limit) {
+        available = body_limit;
+    }
+    if (available > *hashed) {
+        *crc = httpc_crc32c_update(*crc, self->buffer.data + body_offset + *hashed, available - *hashed);
+        *hashed = available;
+    }
+}
+
+static Error http1_integrity_verify(const Http1Protocol* self, const HttpResponse* response, uint32_t crc) {
+    for (size_t i = 0; i < response->num_headers; ++i) {
+        if (self->syscalls->strcasecmp(response->headers[i].key, "Content-Digest") == 0) {
+            bool found = false;
+            uint32_t expected = 0;
+            Error err = httpc_parse_crc32c_digest(response->headers[i].value, &found, &expected);
+            if (err.type != ErrorType.NONE) {
+                return err;
+            }
+            if (found && expected != crc) {
+                return (Error){ErrorType.HTTPC, HttpClientErrorCode.INTEGRITY_FAILURE};
+            }
+            break;
+        }
+    }
+    return (Error){ErrorType.NONE, 0};
+}
+
+static void http1_spill_release(Http1Protocol* self) {
+    if (self->spill_mapping) {
+        self->syscalls->munmap(self->spill_mapping, self->spill_mapping_len);
+        self->spill_mapping = nullptr;
+        self->spill_mapping_len = 0;
+    }
+}
+
+static bool http1_spill_write(Http1Protocol* self, int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t written = self->syscalls->write(fd, data, len);
+        if (written < 0) {
+            return false;
+        }
+        data += written;
+        len -= written;
+    }
+    return true;
+}
+
+// Streams the body into an unlinked file through a fixed window after the headers, then maps it
+// read-only with `padding` zeroed bytes after the body. The headers stay in the receive buffer.
+static Error http1_spill_body(Http1Protocol* self, HttpResponse* response, size_t header_len,
+                              int content_length, size_t padding, uint32_t* crc) {
+    const Error spill_failure = {ErrorType.HTTPC, HttpClientErrorCode.SPILL_FAILURE};
+    int fd = self->spill_directory
+        ? self->syscalls->open(self->spill_directory, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600)
+        : self->syscalls->memfd_create("httpc-body", MFD_CLOEXEC);
+    if (fd < 0) {
+        return spill_failure;
+    }
+
+    size_t body_len = self->buffer.len - header_len;
+    if (content_length != -1 && body_len > (size_t)content_length) {
+        body_len = content_length;
+    }
+    if (!http1_spill_write(self, fd, self->buffer.data + header_len, body_len)) {
+        self->syscalls->close(fd);
+        return spill_failure;
+    }
+
+    Error err = http1_buffer_reserve(self, response, true, header_len + HTTP1_SPILL_WINDOW_SIZE);
+    if (err.type != ErrorType.NONE) {
+        self->syscalls->close(fd);
+        return err;
+    }
+    char* window = self->buffer.data + header_len;
+
+    while (content_length == -1 || body_len < (size_t)content_length) {
+        size_t want = HTTP1_SPILL_WINDOW_SIZE;
+        if (content_length != -1 && want > (size_t)content_length - body_len) {
+            want = content_length - body_len;
+        }
+        ssize_t bytes_read = 0;
+        self->read_calls++;
+        err = self->transport->read(self->transport->context, window, want, &bytes_read);
+        if (err.type != ErrorType.NONE) {
+            if (err.code == TransportErrorCode.CONNECTION_CLOSED && content_length == -1) {
+                break;
+            }
+            self->syscalls->close(fd);
+            if (err.code == TransportErrorCode.CONNECTION_CLOSED) {
+                return (Error){ErrorType.HTTPC, HttpClientErrorCode.HTTP_PARSE_FAILURE};
+            }
+            return err;
+        }
+        if (self->integrity_policy == HTTP_INTEGRITY_CRC32C) {
+            *crc = httpc_crc32c_update(*crc, window, bytes_read);
+        }
+        if (!http1_spill_write(self, fd, window, bytes_read)) {
+            self->syscalls->close(fd);
+            return spill_failure;
+        }
+        body_len += bytes_read;
+    }
+    self->buffer.len = header_len;
+
+    size_t mapping_len = body_len + padding;
+    void* mapping = MAP_FAILED;
+    if (self->syscalls->ftruncate(fd, mapping_len) == 0) {
+        mapping = self->syscalls->mmap(nullptr, mapping_len, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    self->syscalls->close(fd);
+    if (mapping == MAP_FAILED) {
+        return spill_failure;
+    }
+
+    self->spill_mapping = mapping;
+    self->spill_mapping_len = mapping_len;
+    response->body = mapping;
+    response->body_len = body_len;
+    return (Error){ErrorType.NONE, 0};
+}
+
 static Error parse_response_unsafe(void* context, HttpResponse* response) {
     Http1Protocol* self = (Http1Protocol*)context;
     Error err = {ErrorType.NONE, 0};
@@ -104,39 +288,55 @@ static Error parse_response_unsafe(void* context, HttpResponse* response) {
 
     int content_length = -1;
     size_t header_len = 0;
+    size_t body_offset = 0;
     bool headers_parsed = false;
+    bool body_placed = false;
+    size_t hashed = 0;
+    uint32_t crc = 0;
+    const size_t padding = self->body_padding > 0 ? self->body_padding : 1;
+    const size_t alignment_slack = self->body_alignment > 0 ? self->body_alignment - 1 : 0;
 
     response->_owned_buffer = nullptr;
+    response->_mapped_body = nullptr;
+    http1_spill_release(self);
+
+    // Reserve the predicted response size so typical responses arrive in one read without regrowth.
+    const size_t predicted = http1_size_predictor_predict(&self->size_predictor);
+    if (predicted > 0) {
+        err = http1_buffer_reserve(self, response, false, predicted);
+        if (err.type != ErrorType.NONE) {
+            return err;
+        }
+    }
 
     while(1) {
-        if (self->buffer.len == self->buffer.capacity) {
+        // Once the body has been placed its length is known and the buffer sized for it, so
+        // HTTP_RECEIVE_WAIT_ALL asks for exactly the rest of it in one call.
+        const bool wait_all = body_placed && self->receive_strategy == HTTP_RECEIVE_WAIT_ALL && self->transport->read_all;
+        if (!wait_all && self->buffer.len == self->buffer.capacity) {
             size_t new_capacity = self->buffer.capacity == 0 ? 2048 : self->buffer.capacity * 2;
-            char* old_data = self->buffer.data;
-            char* new_data = self->syscalls->realloc(self->buffer.data, new_capacity);
-            if (!new_data) {
-                return (Error){ErrorType.HTTPC, HttpClientErrorCode.HTTP_PARSE_FAILURE};
-            }
-            self->buffer.data = new_data;
-            self->buffer.capacity = new_capacity;
-            if (headers_parsed && old_data != new_data) {
-                ptrdiff_t offset = new_data - old_data;
-                response->status_message += offset;
-                for (size_t i = 0; i < response->num_headers; ++i) {
-                    response->headers[i].key += offset;
-                    response->headers[i].value += offset;
-                }
+            Error reserve_err = http1_buffer_reserve(self, response, headers_parsed, new_capacity);
+            if (reserve_err.type != ErrorType.NONE) {
+                return reserve_err;
             }
         }
 
         ssize_t bytes_read = 0;
-        err = self->transport->read(self->transport->context, self->buffer.data + self->buffer.len, self->buffer.capacity - self->buffer.len, &bytes_read);
+        self->read_calls++;
+        if (wait_all) {
+            err = self->transport->read_all(self->transport->context, self->buffer.data + self->buffer.len, body_offset + content_length - self->buffer.len, &bytes_read);
+        } else {
+            err = self->transport->read(self->transport->context, self->buffer.data + self->buffer.len, self->buffer.capacity - self->buffer.len, &bytes_read);
+        }
         if (err.type != ErrorType.NONE && err.code != TransportErrorCode.CONNECTION_CLOSED) {
             return err;
         }
         self->buffer.len += bytes_read;
+        self->response_bytes += bytes_read;
 
         if (!headers_parsed) {
-            char* header_end = self->syscalls->strstr(self->buffer.data, "\r\n\r\n");
+            // Bounded by what was read: past it the buffer still holds the serialized request.
+            char* header_end = self->syscalls->memmem(self->buffer.data, self->buffer.len, "\r\n\r\n", 4);
             if (header_end) {
                 headers_parsed = true;
                 *header_end = '\0';
@@ -153,40 +353,66 @@ static Error parse_response_unsafe(void* context, HttpResponse* response) {
             }
         }
 
+        if (headers_parsed && self->spill_threshold > 0) {
+            size_t expected_len = content_length != -1 ? (size_t)content_length : self->buffer.len - header_len;
+            if (expected_len > self->spill_threshold) {
+                if (self->integrity_policy == HTTP_INTEGRITY_CRC32C) {
+                    http1_integrity_update(self, header_len, expected_len, &hashed, &crc);
+                }
+                err = http1_spill_body(self, response, header_len, content_length, padding, &crc);
+                if (err.type != ErrorType.NONE) {
+                    return err;
+                }
+                break;
+            }
+        }
+
         if (headers_parsed) {
             if (content_length != -1) {
-                size_t total_size = header_len + content_length;
-                if (self->buffer.capacity < total_size + 1) {
-                    char* old_data = self->buffer.data;
-                    char* new_data = self->syscalls->realloc(self->buffer.data, total_size + 1);
-                    if (!new_data) {
-                        return (Error){ErrorType.HTTPC, HttpClientErrorCode.HTTP_PARSE_FAILURE};
+                if (!body_placed) {
+                    // Size the buffer once, then choose an aligned body offset that no later realloc can move.
+                    Error reserve_err = http1_buffer_reserve(self, response, true, header_len + alignment_slack + content_length + padding);
+                    if (reserve_err.type != ErrorType.NONE) {
+                        return reserve_err;
                     }
-                    self->buffer.data = new_data;
-                    self->buffer.capacity = total_size + 1;
-
-                    // Handle the fact that our pointers may have moved for a large enough realloc
-                    // TODO: check this with a test
-                    if (old_data != new_data) {
-                        ptrdiff_t offset = new_data - old_data;
-                        response->status_message += offset;
-                        for (size_t i = 0; i < response->num_headers; ++i) {
-                            response->headers[i].key += offset;
-                            response->headers[i].value += offset;
-                        }
+                    size_t gap = http1_body_alignment_gap(self, header_len);
+                    if (gap > 0) {
+                        self->syscalls->memmove(self->buffer.data + header_len + gap, self->buffer.data + header_len, self->buffer.len - header_len);
+                        self->buffer.len += gap;
                     }
+                    body_offset = header_len + gap;
+                    body_placed = true;
                 }
+                if (self->integrity_policy == HTTP_INTEGRITY_CRC32C) {
+                    http1_integrity_update(self, body_offset, content_length, &hashed, &crc);
+                }
+                size_t total_size = body_offset + content_length;
                 if (self->buffer.len >= total_size) {
-                    response->body = self->buffer.data + header_len;
+                    response->body = self->buffer.data + body_offset;
                     response->body_len = content_length;
-                    self->buffer.data[total_size] = '\0';
+                    self->syscalls->memset(self->buffer.data + total_size, 0, padding);
+                    break;
+                }
+            } else {
+                if (self->integrity_policy == HTTP_INTEGRITY_CRC32C) {
+                    http1_integrity_update(self, header_len, SIZE_MAX, &hashed, &crc);
+                }
+                if (err.code == TransportErrorCode.CONNECTION_CLOSED) {
+                    size_t body_len = self->buffer.len - header_len;
+                    Error reserve_err = http1_buffer_reserve(self, response, true, header_len + alignment_slack + body_len + padding);
+                    if (reserve_err.type != ErrorType.NONE) {
+                        return reserve_err;
+                    }
+                    size_t gap = http1_body_alignment_gap(self, header_len);
+                    if (gap > 0) {
+                        self->syscalls->memmove(self->buffer.data + header_len + gap, self->buffer.data + header_len, body_len);
+                        self->buffer.len += gap;
+                    }
+                    response->body = self->buffer.data + header_len + gap;
+                    response->body_len = body_len;
+                    self->syscalls->memset(self->buffer.data + self->buffer.len, 0, padding);
                     break;
                 }
-            } else if (err.code == TransportErrorCode.CONNECTION_CLOSED) {
-                response->body = self->buffer.data + header_len;
-                response->body_len = self->buffer.len - header_len;
-                self->buffer.data[self->buffer.len] = '\0';
-                break;
             }
         }
 
@@ -198,7 +424,21 @@ static Error parse_response_unsafe(void* context, HttpResponse* response) {
     if (!headers_parsed && self->buffer.len > 0) {
         return (Error){ErrorType.HTTPC, HttpClientErrorCode.HTTP_PARSE_FAILURE};
     }
+    if (!headers_parsed) {
+        // Closed before a single response byte: there is no response to report success for.
+        return (Error){ErrorType.TRANSPORT, TransportErrorCode.CONNECTION_CLOSED};
+    }
+
+    if (headers_parsed && self->integrity_policy == HTTP_INTEGRITY_CRC32C) {
+        err = http1_integrity_verify(self, response, crc);
+        if (err.type != ErrorType.NONE) {
+            return err;
+        }
+    }
 
+    if (headers_parsed && !self->spill_mapping) {
+        http1_size_predictor_observe(&self->size_predictor, predicted, self->buffer.len + padding);
+    }
     return (Error){ErrorType.NONE, 0};
 }
 
@@ -223,17 +463,23 @@ static Error parse_response_safe(void* context, HttpResponse* response) {
     response->_owned_buffer = self->buffer.data;
     self->buffer = original_buffer;
 
+    // The mapping now belongs to the response and is released by http_response_destroy.
+    response->_mapped_body = self->spill_mapping;
+    response->_mapped_len = self->spill_mapping_len;
+    self->spill_mapping = nullptr;
+    self->spill_mapping_len = 0;
+
     return (Error){ErrorType.NONE, 0};
 }
 
 
-static Error http1_protocol_perform_request(void* context,
-                                            const HttpRequest* request,
-                                            HttpResponse* response) {
-    Http1Protocol* self = (Http1Protocol*)context;
+static Error http1_protocol_exchange(Http1Protocol* self,
+                                     const HttpRequest* request,
+                                     HttpResponse* response) {
     Error err = {ErrorType.NONE, 0};
     ssize_t bytes_written = 0;
     size_t body_len = get_content_length_from_request(request);
+    self->response_bytes = 0;
 
     if (request->method == HTTP_POST && self->io_policy == HTTP_IO_VECTORED_WRITE) {
         err = build_request_headers_in_buffer(self, request);
@@ -262,13 +508,63 @@ static Error http1_protocol_perform_request(void* context,
     }
 
     response->content_length = 0;
+    self->read_calls = 0;
     return self->parse_response(self, response);
 }
 
+static Error http1_protocol_reconnect(Http1Protocol* self) {
+    self->transport->close(self->transport->context);
+    Error err = self->transport->connect(self->transport->context, self->reconnect_host, self->reconnect_port);
+    if (err.type == ErrorType.NONE) {
+        self->reconnect_count++;
+    }
+    return err;
+}
+
+static Error http1_protocol_perform_request(void* context,
+                                            const HttpRequest* request,
+                                            HttpResponse* response) {
+    Http1Protocol* self = (Http1Protocol*)context;
+    const bool connected_before = self->reconnect_host[0] != '\0';
+
+    if (self->reconnect_check && connected_before && self->transport->is_stale &&
+        self->transport->is_stale(self->transport->context)) {
+        Error err = http1_protocol_reconnect(self);
+        if (err.type != ErrorType.NONE) {
+            return err;
+        }
+    }
+
+    Error err = http1_protocol_exchange(self, request, response);
+
+    // The connection was closed or reset before a single response byte came back: the server had
+    // closed it, so the request was not processed. Any other outcome is final.
+    const bool dropped = err.type == ErrorType.TRANSPORT && self->response_bytes == 0 &&
+        (err.code == TransportErrorCode.CONNECTION_CLOSED || err.code == TransportErrorCode.SOCKET_READ_FAILURE ||
+         err.code == TransportErrorCode.SOCKET_WRITE_FAILURE);
+    if (dropped && self->reconnect_retry && connected_before && request->method == HTTP_GET) {
+        err = http1_protocol_reconnect(self);
+        if (err.type != ErrorType.NONE) {
+            return err;
+        }
+        err = http1_protocol_exchange(self, request, response);
+    }
+    return err;
+}
+
 
 static Error http1_protocol_connect(void* context, const char* host, int port) {
     Http1Protocol* self = (Http1Protocol*)context;
-    return self->transport->connect(self->transport->context, host, port);
+    Error err = self->transport->connect(self->transport->context, host, port);
+    if (err.type == ErrorType.NONE) {
+        if (self->reconnect_port != port || self->syscalls->strcasecmp(self->reconnect_host, host) != 0) {
+            self->size_predictor = (HttpSizePredictor){ .predictions = self->size_predictor.predictions,
+                                                        .hits = self->size_predictor.hits };
+        }
+        self->syscalls->snprintf(self->reconnect_host, sizeof(self->reconnect_host), "%s", host);
+        self->reconnect_port = port;
+    }
+    return err;
 }
 
 static Error http1_protocol_disconnect(void* context) {
@@ -281,6 +577,7 @@ static void http1_protocol_destroy(void* context) {
         return;
     }
     Http1Protocol* self = (Http1Protocol*)context;
+    http1_spill_release(self);
     if(self->buffer.capacity > 0) {
         self->syscalls->free(self->buffer.data);
     }
@@ -329,3 +626,78 @@ HttpProtocolInterface* http1_protocol_new(
 
     return &self->interface;
 }
+
+Error http1_protocol_set_memory_policy(HttpProtocolInterface* protocol, HttpResponseMemoryPolicy policy) {
+    if (!protocol) {
+        return (Error){ErrorType.HTTPC, HttpClientErrorCode.INVALID_REQUEST_SYNTAX};
+    }
+    Http1Protocol* self = (Http1Protocol*)protocol->context;
+    self->policy = policy;
+    self->parse_response = policy == HTTP_RESPONSE_SAFE_OWNING ? parse_response_safe : parse_response_unsafe;
+    return (Error){ErrorType.NONE, 0};
+}
+
+Error http1_protocol_set_body_layout(HttpProtocolInterface* protocol, size_t padding, size_t alignment) {
+    if (!protocol || (alignment & (alignment - 1)) != 0) {
+        return (Error){ErrorType.HTTPC, HttpClientErrorCode.INVALID_REQUEST_SYNTAX};
+    }
+    Http1Protocol* self = (Http1Protocol*)protocol->context;
+    self->body_padding = padding;
+    self->body_alignment = alignment;
+    return (Error){ErrorType.NONE, 0};
+}
+
+Error http1_protocol_set_integrity(HttpProtocolInterface* protocol, HttpIntegrityPolicy integrity_policy) {
+    if (!protocol) {
+        return (Error){ErrorType.HTTPC, HttpClientErrorCode.INVALID_REQUEST_SYNTAX};
+    }
+    Http1Protocol* self = (Http1Protocol*)protocol->context;
+    self->integrity_policy = integrity_policy;
+    return (Error){ErrorType.NONE, 0};
+}
+
+Error http1_protocol_set_spill(HttpProtocolInterface* protocol, size_t threshold, const char* directory) {
+    if (!protocol) {
+        return (Error){ErrorType.HTTPC, HttpClientErrorCode.INVALID_REQUEST_SYNTAX};
+    }
+    Http1Protocol* self = (Http1Protocol*)protocol->context;
+    self->spill_threshold = threshold;
+    self->spill_directory = directory;
+    return (Error){ErrorType.NONE, 0};
+}
+
+Error http1_protocol_set_reconnect(HttpProtocolInterface* protocol, bool check_before_use, bool retry_idempotent) {
+    if (!protocol) {
+        return (Error){ErrorType.HTTPC, HttpClientErrorCode.INVALID_REQUEST_SYNTAX};
+    }
+    Http1Protocol* self = (Http1Protocol*)protocol->context;
+    self->reconnect_check = check_before_use;
+    self->reconnect_retry = retry_idempotent;
+    return (Error){ErrorType.NONE, 0};
+}
+
+Error http1_protocol_set_receive_strategy(HttpProtocolInterface* protocol, HttpReceiveStrategy strategy) {
+    if (!protocol) {
+        return (Error){ErrorType.HTTPC, HttpClientErrorCode.INVALID_REQUEST_SYNTAX};
+    }
+    Http1Protocol* self = (Http1Protocol*)protocol->context;
+    self->receive_strategy = strategy;
+    return (Error){ErrorType.NONE, 0};
+}
+
+Error http1_protocol_reserve(HttpProtocolInterface* protocol, size_t capacity) {
+    if (!protocol || protocol->perform_request != http1_protocol_perform_request) {
+        return (Error){ErrorType.HTTPC, HttpClientErrorCode.INVALID_REQUEST_SYNTAX};
+    }
+    Http1Protocol* self = (Http1Protocol*)protocol->context;
+    if (capacity > self->buffer.capacity) {
+        char* new_data = self->syscalls->realloc(self->buffer.data, capacity);
+        if (!new_data) {
+            return (Error){ErrorType.HTTPC, HttpClientErrorCode.INIT_FAILURE};
+        }
+        self->buffer.data = new_data;
+        self->buffer.capacity = capacity;
+    }
+    self->syscalls->memset(self->buffer.data + self->buffer.len, 0, self->buffer.capacity - self->buffer.len);
+    return (Error){ErrorType.NONE, 0};
+}
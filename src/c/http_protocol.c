@@ -1,9 +1,14 @@
 #include <httpc/http_protocol.h>
 #include <stdlib.h>
+#include <sys/mman.h>
 
 void http_response_destroy(HttpResponse* response) {
     if (response && response->_owned_buffer) {
         free(response->_owned_buffer);
         response->_owned_buffer = nullptr;
     }
+    if (response && response->_mapped_body) {
+        munmap(response->_mapped_body, response->_mapped_len);
+        response->_mapped_body = nullptr;
+    }
 }
\ No newline at end of file
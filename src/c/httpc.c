@@ -98,4 +98,36 @@ void http_client_destroy(struct HttpClient* self) {
 
     self->protocol->destroy(self->protocol->context);
     transport->destroy(transport->context);
-}
\ No newline at end of file
+}
+
+Error http_client_warm_up(struct HttpClient* self, const char* host, int port, const HttpWarmUpOptions* options) {
+    if (self == nullptr || self->protocol == nullptr || host == nullptr) {
+        return (Error){ErrorType.HTTPC, HttpClientErrorCode.INVALID_REQUEST_SYNTAX};
+    }
+
+    Error err = self->connect(self, host, port);
+    if (err.type != ErrorType.NONE || options == nullptr) {
+        return err;
+    }
+
+    if (options->buffer_size > 0) {
+        err = http1_protocol_reserve(self->protocol, options->buffer_size);
+        if (err.type != ErrorType.NONE) {
+            return err;
+        }
+    }
+
+    for (size_t i = 0; options->request != nullptr && i < options->num_requests; ++i) {
+        HttpResponse response = {};
+        if (options->request->method == HTTP_POST) {
+            err = self->post(self, options->request, &response);
+        } else {
+            err = self->get(self, options->request, &response);
+        }
+        http_response_destroy(&response);
+        if (err.type != ErrorType.NONE) {
+            return err;
+        }
+    }
+    return (Error){ErrorType.NONE, 0};
+}
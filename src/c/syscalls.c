@@ -1,8 +1,12 @@
+#define _GNU_SOURCE // memfd_create, O_TMPFILE, memmem
+
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 
 #include <httpc/syscalls.h>
 
@@ -20,17 +24,27 @@ void httpc_syscalls_init_default(HttpcSyscalls* syscalls) {
     syscalls->write = write;
     syscalls->read = read;
     syscalls->close = close;
+    syscalls->poll = poll;
+    syscalls->recv = recv;
+
+    syscalls->open = open;
+    syscalls->memfd_create = memfd_create;
+    syscalls->ftruncate = ftruncate;
+    syscalls->mmap = mmap;
+    syscalls->munmap = munmap;
 
     syscalls->malloc = malloc;
     syscalls->realloc = realloc;
     syscalls->free = free;
     syscalls->memset = memset;
     syscalls->memcpy = memcpy;
+    syscalls->memmove = memmove;
 
     syscalls->strchr = strchr;
     syscalls->strncpy = strncpy;
     syscalls->strlen = strlen;
     syscalls->strstr = strstr;
+    syscalls->memmem = memmem;
     syscalls->strtok_r = strtok_r;
     syscalls->snprintf = snprintf;
     syscalls->strcasecmp = strcasecmp;
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
 #include <arpa/inet.h>
 #include <netinet/tcp.h>
 
@@ -29,6 +30,12 @@ static Error tcp_transport_connect(void* context, const char* host, int port) {
             continue;
         }
 
+        if (self->fast_open) {
+            int enable = 1;
+            // Best effort: a kernel that rejects the option just performs the normal handshake.
+            self->syscalls->setsockopt(sfd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &enable, sizeof(enable));
+        }
+
         if (self->syscalls->connect(sfd, rp->ai_addr, rp->ai_addrlen) != -1) {
             int flag = 1;
             if (self->syscalls->setsockopt(sfd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) == -1) {
@@ -95,6 +102,25 @@ static Error tcp_transport_read(void* context, void* buffer, size_t len, ssize_t
     return (Error){ErrorType.NONE, 0};
 }
 
+static Error tcp_transport_read_all(void* context, void* buffer, size_t len, ssize_t* bytes_read) {
+    TcpClient* self = (TcpClient*)context;
+    if (self->fd <= 0) {
+        *bytes_read = -1;
+        return (Error){ErrorType.TRANSPORT, TransportErrorCode.SOCKET_READ_FAILURE};
+    }
+    // MSG_WAITALL: block until all `len` bytes are in, unless the peer closes first.
+    do {
+        *bytes_read = self->syscalls->recv(self->fd, buffer, len, MSG_WAITALL);
+    } while (*bytes_read == -1 && errno == EINTR);
+    if (*bytes_read == -1) {
+        return (Error){ErrorType.TRANSPORT, TransportErrorCode.SOCKET_READ_FAILURE};
+    }
+    if (*bytes_read == 0) {
+        return (Error){ErrorType.TRANSPORT, TransportErrorCode.CONNECTION_CLOSED};
+    }
+    return (Error){ErrorType.NONE, 0};
+}
+
 static Error tcp_transport_close(void* context) {
     TcpClient* self = (TcpClient*)context;
     if (self->fd > 0) {
@@ -107,6 +133,26 @@ static Error tcp_transport_close(void* context) {
     return (Error){ErrorType.NONE, 0};
 }
 
+// An idle keep-alive connection has nothing to read, so readiness means EOF, a reset or stray
+// bytes. A non-blocking MSG_PEEK rules out a spurious wakeup without consuming anything.
+static bool tcp_transport_is_stale(void* context) {
+    TcpClient* self = (TcpClient*)context;
+    if (self->fd <= 0) {
+        return true;
+    }
+    struct pollfd pfd = { .fd = self->fd, .events = POLLIN, .revents = 0 };
+    int ready = self->syscalls->poll(&pfd, 1, 0);
+    if (ready == 0) {
+        return false;
+    }
+    if (ready < 0 || (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) {
+        return true;
+    }
+    char probe;
+    ssize_t n = self->syscalls->recv(self->fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+}
+
 void tcp_transport_destroy(void* context) {
     if (!context) {
         return;
@@ -140,8 +186,17 @@ TransportInterface* tcp_transport_new(const HttpcSyscalls* syscalls_override) {
     self->interface.read = tcp_transport_read;
     self->interface.close = tcp_transport_close;
     self->interface.destroy = tcp_transport_destroy;
+    self->interface.is_stale = tcp_transport_is_stale;
+    self->interface.read_all = tcp_transport_read_all;
 
     return &self->interface;
 }
 
-
+Error tcp_transport_set_fast_open(TransportInterface* transport, bool enabled) {
+    if (!transport) {
+        return (Error){ErrorType.TRANSPORT, TransportErrorCode.INIT_FAILURE};
+    }
+    TcpClient* self = (TcpClient*)transport->context;
+    self->fast_open = enabled;
+    return (Error){ErrorType.NONE, 0};
+}
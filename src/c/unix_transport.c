@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
 #include <sys/un.h>
 
 static Error unix_transport_connect(void* context, const char* host, int port) {
@@ -70,6 +71,25 @@ static Error unix_transport_read(void* context, void* buffer, size_t len, ssize_
     return (Error){ErrorType.NONE, 0};
 }
 
+static Error unix_transport_read_all(void* context, void* buffer, size_t len, ssize_t* bytes_read) {
+    UnixClient* self = (UnixClient*)context;
+    if (self->fd <= 0) {
+        *bytes_read = -1;
+        return (Error){ErrorType.TRANSPORT, TransportErrorCode.SOCKET_READ_FAILURE};
+    }
+    // MSG_WAITALL: block until all `len` bytes are in, unless the peer closes first.
+    do {
+        *bytes_read = self->syscalls->recv(self->fd, buffer, len, MSG_WAITALL);
+    } while (*bytes_read == -1 && errno == EINTR);
+    if (*bytes_read == -1) {
+        return (Error){ErrorType.TRANSPORT, TransportErrorCode.SOCKET_READ_FAILURE};
+    }
+    if (*bytes_read == 0) {
+        return (Error){ErrorType.TRANSPORT, TransportErrorCode.CONNECTION_CLOSED};
+    }
+    return (Error){ErrorType.NONE, 0};
+}
+
 static Error unix_transport_close(void* context) {
     UnixClient* self = (UnixClient*)context;
     if (self->fd > 0) {
@@ -82,6 +102,26 @@ static Error unix_transport_close(void* context) {
     return (Error){ErrorType.NONE, 0};
 }
 
+// An idle keep-alive connection has nothing to read, so readiness means EOF, a reset or stray
+// bytes. A non-blocking MSG_PEEK rules out a spurious wakeup without consuming anything.
+static bool unix_transport_is_stale(void* context) {
+    UnixClient* self = (UnixClient*)context;
+    if (self->fd <= 0) {
+        return true;
+    }
+    struct pollfd pfd = { .fd = self->fd, .events = POLLIN, .revents = 0 };
+    int ready = self->syscalls->poll(&pfd, 1, 0);
+    if (ready == 0) {
+        return false;
+    }
+    if (ready < 0 || (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) {
+        return true;
+    }
+    char probe;
+    ssize_t n = self->syscalls->recv(self->fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+}
+
 void unix_transport_destroy(void* context) {
     if (!context) {
         return;
@@ -115,6 +155,8 @@ TransportInterface* unix_transport_new(const HttpcSyscalls* syscalls_override) {
     self->interface.read = unix_transport_read;
     self->interface.close = unix_transport_close;
     self->interface.destroy = unix_transport_destroy;
+    self->interface.is_stale = unix_transport_is_stale;
+    self->interface.read_all = unix_transport_read_all;
 
     return &self->interface;
 }
@@ -0,0 +1,136 @@
+#include <httpcpp/numa.hpp>
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <fstream>
+#include <string>
+
+namespace httpcpp::numa {
+
+// Calls `visit` for every number in a sysfs list such as "0-3,8,10-11"; false if malformed.
+template<typename Visit>
+static auto for_each_in_list(const std::string& list, Visit visit) -> bool {
+    const char* cursor = list.data();
+    const char* end = list.data() + list.size();
+    while (cursor < end && *cursor != '\n') {
+        int first = 0;
+        auto [after_first, ec] = std::from_chars(cursor, end, first);
+        if (ec != std::errc()) {
+            return false;
+        }
+        int last = first;
+        cursor = after_first;
+        if (cursor < end && *cursor == '-') {
+            auto [after_last, ec_last] = std::from_chars(cursor + 1, end, last);
+            if (ec_last != std::errc()) {
+                return false;
+            }
+            cursor = after_last;
+        }
+        for (int i = first; i <= last; ++i) {
+            visit(i);
+        }
+        if (cursor < end && *cursor == ',') {
+            ++cursor;
+        }
+    }
+    return true;
+}
+
+static auto read_line(const std::string& path) -> std::string {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+// Node masks are a single word; machines with more nodes fall back to first touch.
+static constexpr int MASK_BITS = sizeof(unsigned long) * CHAR_BIT;
+
+// The kernel reads one bit fewer than the maxnode it is given (libnuma passes nbits + 1), so
+// passing MASK_BITS itself would drop the highest node.
+static constexpr unsigned long MAX_NODE = MASK_BITS + 1;
+
+auto node_count() noexcept -> int {
+    try {
+        int highest = 0;
+        const std::string online = read_line("/sys/devices/system/node/online");
+        if (online.empty() || !for_each_in_list(online, [&](int node) { highest = std::max(highest, node); })) {
+            return 1;
+        }
+        return highest + 1;
+    } catch (...) {
+        return 1;
+    }
+}
+
+auto current_node() noexcept -> int {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return 0;
+    }
+    return static_cast<int>(node);
+}
+
+auto bind_current_thread(int node) noexcept -> std::expected<void, Error> {
+    if (node < 0 || node >= node_count()) {
+        return std::unexpected(Error{HttpClientError::InvalidRequest});
+    }
+    try {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        const std::string list = read_line("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        bool any = false;
+        if (!for_each_in_list(list, [&](int cpu) {
+                if (cpu < CPU_SETSIZE) {
+                    CPU_SET(cpu, &cpus);
+                    any = true;
+                }
+            })) {
+            return std::unexpected(Error{HttpClientError::InitFailure});
+        }
+        // Without a topology there is nothing to narrow the thread to.
+        if (any && ::sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+            return std::unexpected(Error{HttpClientError::InitFailure});
+        }
+    } catch (...) {
+        return std::unexpected(Error{HttpClientError::InitFailure});
+    }
+    if (node < MASK_BITS) {
+        // Best effort: kernels without NUMA support reject the policy, which changes nothing.
+        const unsigned long mask = 1UL << node;
+        (void)::syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask, MAX_NODE);
+    }
+    return {};
+}
+
+auto allocate_on_node(size_t bytes, int node) noexcept -> void* {
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t length = (bytes + page - 1) / page * page;
+    void* mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    const unsigned long mask = node >= 0 && node < MASK_BITS ? 1UL << node : 0;
+    if (mask == 0 || ::syscall(SYS_mbind, mapping, length, MPOL_PREFERRED, &mask, MAX_NODE, 0) != 0) {
+        auto* bytes_view = static_cast<volatile char*>(mapping);
+        for (size_t offset = 0; offset < length; offset += page) {
+            bytes_view[offset] = 0;
+        }
+    }
+    return mapping;
+}
+
+void deallocate_on_node(void* pointer, size_t bytes) noexcept {
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    ::munmap(pointer, (bytes + page - 1) / page * page);
+}
+
+} // namespace httpcpp::numa
@@ -0,0 +1,88 @@
+#include "socket_io.hpp"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <array>
+#include <cerrno>
+
+namespace httpcpp::socket_io {
+
+// At most MAX_IOVECS buffers per call. MSG_NOSIGNAL: a closed peer is a write error, not SIGPIPE.
+auto send_all_vectored(int fd, std::span<const std::span<const std::byte>> buffers) noexcept
+    -> std::expected<size_t, TransportError> {
+    constexpr size_t MAX_IOVECS = 64;
+    size_t total = 0;
+    size_t index = 0;
+    size_t offset = 0;
+    while (true) {
+        std::array<iovec, MAX_IOVECS> iov;
+        size_t count = 0;
+        for (size_t i = index; i < buffers.size() && count < MAX_IOVECS; ++i) {
+            const auto part = i == index ? buffers[i].subspan(offset) : buffers[i];
+            if (!part.empty()) {
+                iov[count++] = {const_cast<std::byte*>(part.data()), part.size()};
+            }
+        }
+        if (count == 0) {
+            return total;
+        }
+
+        msghdr message{};
+        message.msg_iov = iov.data();
+        message.msg_iovlen = count;
+        ssize_t sent = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+        if (sent == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return std::unexpected(TransportError::SocketWriteFailure);
+        }
+
+        total += static_cast<size_t>(sent);
+        auto remaining = static_cast<size_t>(sent);
+        while (remaining > 0) {
+            const size_t left_in_part = buffers[index].size() - offset;
+            if (remaining < left_in_part) {
+                offset += remaining;
+                break;
+            }
+            remaining -= left_in_part;
+            ++index;
+            offset = 0;
+        }
+    }
+}
+
+auto recv_exact(int fd, std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError> {
+    ssize_t bytes_read;
+    do {
+        bytes_read = ::recv(fd, buffer.data(), buffer.size(), MSG_WAITALL);
+    } while (bytes_read == -1 && errno == EINTR);
+
+    if (bytes_read == -1) {
+        return std::unexpected(TransportError::SocketReadFailure);
+    }
+    if (bytes_read == 0 && !buffer.empty()) {
+        return std::unexpected(TransportError::ConnectionClosed);
+    }
+    return static_cast<size_t>(bytes_read);
+}
+
+// An idle keep-alive connection has nothing to read, so any readiness means EOF, a reset, or
+// stray bytes; a non-blocking MSG_PEEK tells a spurious wakeup apart without consuming data.
+auto is_stale(int fd) noexcept -> bool {
+    pollfd pfd{fd, POLLIN | POLLRDHUP, 0};
+    const int ready = ::poll(&pfd, 1, 0);
+    if (ready == 0) {
+        return false;
+    }
+    if (ready < 0 || (pfd.revents & (POLLERR | POLLHUP | POLLRDHUP | POLLNVAL)) != 0) {
+        return true;
+    }
+    char probe;
+    const ssize_t n = ::recv(fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+}
+
+} // namespace httpcpp::socket_io
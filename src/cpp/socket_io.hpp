@@ -0,0 +1,22 @@
+#pragma once
+
+#include <httpcpp/error.hpp>
+
+#include <cstddef>
+#include <expected>
+#include <span>
+
+// Socket I/O shared by the transports that own a plain connected descriptor.
+namespace httpcpp::socket_io {
+
+    // Sends all of `buffers` with as few sendmsg calls as partial writes allow.
+    [[nodiscard]] auto send_all_vectored(int fd, std::span<const std::span<const std::byte>> buffers) noexcept
+        -> std::expected<size_t, TransportError>;
+
+    // recv with MSG_WAITALL, retried on EINTR; ConnectionClosed when the peer closed first.
+    [[nodiscard]] auto recv_exact(int fd, std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError>;
+
+    // Whether an idle keep-alive connection on `fd` was closed or reset by the peer.
+    [[nodiscard]] auto is_stale(int fd) noexcept -> bool;
+
+} // namespace httpcpp::socket_io
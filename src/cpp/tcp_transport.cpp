@@ -1,6 +1,11 @@
 #include <httpcpp/tcp_transport.hpp>
+#include "socket_io.hpp"
 #include <string>
 
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
 namespace httpcpp {
 
 TcpTransport::TcpTransport() noexcept : socket_(io_context_) {}
@@ -30,6 +35,16 @@ auto TcpTransport::connect(const char* host, uint16_t port) noexcept -> std::exp
         std::error_code close_ec;
         socket_.close(close_ec);
 
+        if (fast_open_) {
+            // Best effort: a kernel without TCP_FASTOPEN_CONNECT rejects the option and the
+            // connect below performs the ordinary handshake.
+            socket_.open(endpoint.endpoint().protocol(), ec);
+            if (!ec) {
+                int enable = 1;
+                (void)::setsockopt(socket_.native_handle(), IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &enable, sizeof(enable));
+            }
+        }
+
         socket_.connect(endpoint.endpoint(), ec);
 
         if (!ec) {
@@ -53,6 +68,10 @@ auto TcpTransport::connect(const char* host, uint16_t port) noexcept -> std::exp
     return {};
 }
 
+void TcpTransport::set_fast_open(bool enabled) noexcept {
+    fast_open_ = enabled;
+}
+
 auto TcpTransport::close() noexcept -> std::expected<void, TransportError> {
     if (!socket_.is_open()) {
         return {};
@@ -74,6 +93,13 @@ auto TcpTransport::write(std::span<const std::byte> data) noexcept -> std::expec
     return bytes_written;
 }
 
+auto TcpTransport::write_vectored(std::span<const std::span<const std::byte>> buffers) noexcept -> std::expected<size_t, TransportError> {
+    if (!socket_.is_open()) {
+        return std::unexpected(TransportError::SocketWriteFailure);
+    }
+    return socket_io::send_all_vectored(socket_.native_handle(), buffers);
+}
+
 auto TcpTransport::read(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError> {
     std::error_code ec;
     size_t bytes_read = socket_.read_some(net::buffer(buffer.data(), buffer.size()), ec);
@@ -92,4 +118,22 @@ auto TcpTransport::read(std::span<std::byte> buffer) noexcept -> std::expected<s
     return bytes_read;
 }
 
+auto TcpTransport::read_exact(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError> {
+    if (!socket_.is_open()) {
+        return std::unexpected(TransportError::SocketReadFailure);
+    }
+    return socket_io::recv_exact(socket_.native_handle(), buffer);
+}
+
+auto TcpTransport::is_stale() const noexcept -> bool {
+    if (!socket_.is_open()) {
+        return true;
+    }
+    return socket_io::is_stale(const_cast<net::ip::tcp::socket&>(socket_).native_handle());
+}
+
+auto TcpTransport::native_handle() noexcept -> int {
+    return socket_.is_open() ? socket_.native_handle() : -1;
+}
+
 } // namespace httpcpp
\ No newline at end of file
@@ -1,9 +1,9 @@
 #include <httpcpp/unix_transport.hpp>
+#include "socket_io.hpp"
 
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
-#include <cerrno>
 #include <cstring>
 
 namespace httpcpp {
@@ -60,7 +60,8 @@ auto UnixTransport::write(std::span<const std::byte> data) noexcept -> std::expe
         return std::unexpected(TransportError::SocketWriteFailure);
     }
 
-    ssize_t bytes_written = ::write(fd_, data.data(), data.size());
+    // MSG_NOSIGNAL: a peer that already closed must show up as a write error, not SIGPIPE.
+    ssize_t bytes_written = ::send(fd_, data.data(), data.size(), MSG_NOSIGNAL);
 
     if (bytes_written == -1) {
         return std::unexpected(TransportError::SocketWriteFailure);
@@ -69,6 +70,13 @@ auto UnixTransport::write(std::span<const std::byte> data) noexcept -> std::expe
     return bytes_written;
 }
 
+auto UnixTransport::write_vectored(std::span<const std::span<const std::byte>> buffers) noexcept -> std::expected<size_t, TransportError> {
+    if (fd_ == -1) {
+        return std::unexpected(TransportError::SocketWriteFailure);
+    }
+    return socket_io::send_all_vectored(fd_, buffers);
+}
+
 auto UnixTransport::read(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError> {
     if (fd_ == -1) {
         return std::unexpected(TransportError::SocketReadFailure);
@@ -87,4 +95,22 @@ auto UnixTransport::read(std::span<std::byte> buffer) noexcept -> std::expected<
     return bytes_read;
 }
 
+auto UnixTransport::read_exact(std::span<std::byte> buffer) noexcept -> std::expected<size_t, TransportError> {
+    if (fd_ == -1) {
+        return std::unexpected(TransportError::SocketReadFailure);
+    }
+    return socket_io::recv_exact(fd_, buffer);
+}
+
+auto UnixTransport::is_stale() const noexcept -> bool {
+    if (fd_ == -1) {
+        return true;
+    }
+    return socket_io::is_stale(fd_);
+}
+
+auto UnixTransport::native_handle() noexcept -> int {
+    return fd_;
+}
+
 } // namespace httpcpp
\ No newline at end of file
@@ -0,0 +1,267 @@
+import asyncio
+
+from .errors import (
+    TransportError,
+    SocketConnectError,
+    ConnectionClosedError,
+    HttpParseError,
+    InvalidRequestError,
+)
+from .http_protocol import HttpRequest, SafeHttpResponse, HttpMethod
+from .tcp_transport import TcpTransport
+from .transport import Transport
+from .unix_transport import UnixTransport
+
+
+class _Http1Connection(asyncio.BufferedProtocol):
+    """One pooled HTTP/1.1 connection.
+
+    The event loop reads straight into `_buffer` through `get_buffer`, and the response is
+    parsed incrementally as bytes arrive. The buffer is reused across responses on the
+    connection. It is only resized or compacted inside `get_buffer`, because the loop may still
+    hold the previously returned view while it calls `buffer_updated`.
+    """
+
+    _HEADER_SEPARATOR = b"\r\n\r\n"
+    _HEADER_SEPARATOR_CL = b"content-length:"
+    _MIN_READ_SIZE = 4096
+
+    def __init__(self) -> None:
+        self._transport: asyncio.Transport | None = None
+        self._buffer = bytearray(self._MIN_READ_SIZE)
+        self._filled = 0
+        self._consumed = 0
+        self._waiter: asyncio.Future[SafeHttpResponse] | None = None
+        self._reset_response_state()
+        self.closed = False
+
+    # --- asyncio.BufferedProtocol ---
+
+    def connection_made(self, transport: asyncio.BaseTransport) -> None:
+        self._transport = transport  # type: ignore[assignment]
+
+    def get_buffer(self, sizehint: int) -> memoryview:
+        if self._consumed:
+            leftover = self._filled - self._consumed
+            self._buffer[:leftover] = self._buffer[self._consumed:self._filled]
+            self._filled = leftover
+            self._scanned = max(0, self._scanned - self._consumed)
+            self._consumed = 0
+
+        wanted = max(sizehint, self._MIN_READ_SIZE)
+        if len(self._buffer) - self._filled < wanted:
+            self._buffer.extend(bytes(max(wanted, len(self._buffer))))
+        return memoryview(self._buffer)[self._filled:]
+
+    def buffer_updated(self, nbytes: int) -> None:
+        self._filled += nbytes
+        if self._waiter is None:
+            return
+        try:
+            if self._parse_progress():
+                self._complete()
+        except HttpParseError as e:
+            self._fail(e)
+
+    def eof_received(self) -> bool | None:
+        return False
+
+    def connection_lost(self, exc: Exception | None) -> None:
+        self.closed = True
+        self._transport = None
+        if self._waiter is None or self._waiter.done():
+            return
+        if self._header_size and self._content_length is None:
+            # No Content-Length: the body runs until the server closes the connection.
+            self._complete()
+        elif exc is not None:
+            self._fail(TransportError(f"Connection lost: {exc}"))
+        else:
+            self._fail(ConnectionClosedError("Connection closed before the full response was received."))
+
+    # --- Request driving ---
+
+    def request(self, head: bytes, body: bytes) -> "asyncio.Future[SafeHttpResponse]":
+        if self._transport is None or self.closed:
+            raise ConnectionClosedError("Cannot send on a closed connection.")
+
+        self._waiter = asyncio.get_running_loop().create_future()
+        self._reset_response_state()
+        if body:
+            self._transport.writelines((head, body))
+        else:
+            self._transport.write(head)
+        return self._waiter
+
+    def close(self) -> None:
+        self.closed = True
+        if self._transport is not None:
+            self._transport.close()
+
+    # --- Incremental parsing ---
+
+    def _reset_response_state(self) -> None:
+        self._header_size = 0
+        self._content_length: int | None = None
+        self._scanned = 0
+        self._keep_alive = True
+
+    def _parse_progress(self) -> bool:
+        start = self._consumed
+        if self._header_size == 0:
+            scan_from = max(start, self._scanned - len(self._HEADER_SEPARATOR) + 1)
+            separator_pos = self._buffer.find(self._HEADER_SEPARATOR, scan_from, self._filled)
+            self._scanned = self._filled
+            if separator_pos == -1:
+                return False
+            self._header_size = separator_pos + len(self._HEADER_SEPARATOR) - start
+
+            headers_block_lower = bytes(self._buffer[start:start + self._header_size]).lower()
+            cl_key_pos = headers_block_lower.find(self._HEADER_SEPARATOR_CL)
+            if cl_key_pos != -1:
+                line_end_pos = headers_block_lower.find(b"\r\n", cl_key_pos)
+                try:
+                    self._content_length = int(headers_block_lower[cl_key_pos + len(self._HEADER_SEPARATOR_CL):line_end_pos])
+                except ValueError:
+                    raise HttpParseError("Invalid Content-Length value")
+            if b"\r\nconnection: close" in headers_block_lower or self._content_length is None:
+                self._keep_alive = False
+
+        if self._content_length is None:
+            return False
+        return self._filled - start >= self._header_size + self._content_length
+
+    def _complete(self) -> None:
+        start = self._consumed
+        body_start = start + self._header_size
+        body_end = self._filled if self._content_length is None else body_start + self._content_length
+        head = bytes(self._buffer[start:body_start - len(self._HEADER_SEPARATOR)]).decode('ascii')
+        body = bytes(self._buffer[body_start:body_end])
+        self._consumed = body_end
+        if not self._keep_alive:
+            self.close()
+
+        status_line, _, header_lines = head.partition("\r\n")
+        parts = status_line.split(" ", 2)
+        if len(parts) < 2:
+            self._fail(HttpParseError("Malformed status line."))
+            return
+        try:
+            status_code = int(parts[1])
+        except ValueError:
+            self._fail(HttpParseError("Invalid status code in status line."))
+            return
+
+        headers = []
+        for line in header_lines.split("\r\n"):
+            key, colon, value = line.partition(":")
+            if colon:
+                headers.append((key, value.strip(" \t")))
+
+        waiter, self._waiter = self._waiter, None
+        if waiter is not None and not waiter.done():
+            waiter.set_result(SafeHttpResponse(
+                status_code=status_code,
+                status_message=parts[2] if len(parts) > 2 else "",
+                body=body,
+                headers=headers,
+                content_length=self._content_length,
+            ))
+
+    def _fail(self, error: Exception) -> None:
+        self.close()
+        waiter, self._waiter = self._waiter, None
+        if waiter is not None and not waiter.done():
+            waiter.set_exception(error)
+
+
+class AsyncHttpClient:
+    """asyncio counterpart of `HttpClient` that keeps a pool of keep-alive connections.
+
+    Each connection carries one request at a time; up to `max_connections` requests run
+    concurrently and further callers wait for a connection to become idle.
+    """
+
+    def __init__(self, transport_class: type[Transport] = TcpTransport, max_connections: int = 10) -> None:
+        if transport_class not in (TcpTransport, UnixTransport):
+            raise InvalidRequestError(f"Unsupported transport {transport_class.__name__}")
+        if max_connections < 1:
+            raise InvalidRequestError("max_connections must be at least 1.")
+        self._transport_class = transport_class
+        self._host = ""
+        self._port = 0
+        self._idle: list[_Http1Connection] = []
+        self._slots: asyncio.Semaphore | None = None
+        self._max_connections = max_connections
+
+    async def connect(self, host: str, port: int) -> None:
+        """Records the endpoint and opens one connection to fail fast on a bad address."""
+        self._host, self._port = host, port
+        self._slots = asyncio.Semaphore(self._max_connections)
+        self._idle.append(await self._open())
+
+    async def disconnect(self) -> None:
+        for conn in self._idle:
+            conn.close()
+        self._idle.clear()
+
+    async def get(self, request: HttpRequest) -> SafeHttpResponse:
+        if request.body:
+            raise InvalidRequestError("GET requests cannot have a body.")
+        request.method = HttpMethod.GET
+        return await self._perform(request)
+
+    async def post(self, request: HttpRequest) -> SafeHttpResponse:
+        if not request.body:
+            raise InvalidRequestError("POST requests must have a body.")
+        if not any(key.lower() == "content-length" for key, _ in request.headers):
+            raise InvalidRequestError("POST requests must include a Content-Length header.")
+        request.method = HttpMethod.POST
+        return await self._perform(request)
+
+    async def __aenter__(self) -> "AsyncHttpClient":
+        return self
+
+    async def __aexit__(self, *exc_info: object) -> None:
+        await self.disconnect()
+
+    async def _perform(self, request: HttpRequest) -> SafeHttpResponse:
+        if self._slots is None:
+            raise TransportError("Client is not connected.")
+
+        head = self._build_request_head(request)
+        async with self._slots:
+            conn = self._acquire_idle() or await self._open()
+            try:
+                response = await conn.request(head, request.body if request.method == HttpMethod.POST else b"")
+            except BaseException:
+                conn.close()
+                raise
+            if not conn.closed:
+                self._idle.append(conn)
+            return response
+
+    def _acquire_idle(self) -> _Http1Connection | None:
+        while self._idle:
+            conn = self._idle.pop()
+            if not conn.closed:
+                return conn
+        return None
+
+    async def _open(self) -> _Http1Connection:
+        loop = asyncio.get_running_loop()
+        try:
+            if self._transport_class is UnixTransport:
+                _, conn = await loop.create_unix_connection(_Http1Connection, self._host)
+            else:
+                _, conn = await loop.create_connection(_Http1Connection, self._host, self._port)
+        except OSError as e:
+            raise SocketConnectError(f"Socket connection failed: {e}") from e
+        return conn
+
+    @staticmethod
+    def _build_request_head(request: HttpRequest) -> bytes:
+        lines = [f"{request.method.value} {request.path} HTTP/1.1\r\n"]
+        lines.extend(f"{key}: {value}\r\n" for key, value in request.headers)
+        lines.append("\r\n")
+        return "".join(lines).encode('ascii')
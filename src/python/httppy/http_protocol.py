@@ -17,7 +17,7 @@ class HttpRequest:
 class SafeHttpResponse:
     status_code: int
     status_message: str
-    body: bytes
+    body: bytes | memoryview
     headers: list[tuple[str, str]]
     content_length: int | None = None
 
@@ -0,0 +1,310 @@
+"""Optional backend that runs the HTTP/1.1 exchange in the C library (``libhttpc_lib.so``).
+
+`NativeHttp1Protocol` implements the same `HttpProtocol` interface as `Http1Protocol`, so it
+plugs into `HttpClient` unchanged. Calls go through ctypes, which releases the GIL for the
+duration of each foreign call, so socket I/O and response parsing of clients on different
+threads overlap. Response bodies are memoryviews straight over the C buffers; nothing is copied.
+"""
+
+import ctypes
+import ctypes.util
+import functools
+import os
+from collections.abc import Iterable
+from ctypes import POINTER, CFUNCTYPE, Structure, byref, c_char_p, c_int, c_size_t, c_void_p
+
+from .errors import (
+    HttpClientError,
+    UrlParseError,
+    HttpParseError,
+    InvalidRequestError,
+    HttpClientInitError,
+    TransportError,
+    DnsFailureError,
+    SocketCreateError,
+    SocketConnectError,
+    SocketWriteError,
+    SocketReadError,
+    ConnectionClosedError,
+    SocketCloseFailure,
+    TransportInitError,
+)
+from .http_protocol import HttpProtocol, HttpRequest, SafeHttpResponse, UnsafeHttpResponse, HttpMethod
+from .tcp_transport import TcpTransport
+from .transport import Transport
+from .unix_transport import UnixTransport
+
+# --- Mirrors of include/httpc ---
+
+_ERROR_TYPE_NONE = 0
+_ERROR_TYPE_TRANSPORT = 1
+
+_HTTP_GET = 0
+_HTTP_POST = 1
+
+_HTTP_RESPONSE_UNSAFE_ZERO_COPY = 0
+_HTTP_RESPONSE_SAFE_OWNING = 1
+
+_HTTP_IO_VECTORED_WRITE = 1
+
+_MAX_HEADERS = 32
+
+
+class _Error(Structure):
+    _fields_ = [("type", c_int), ("code", c_int)]
+
+
+class _HttpHeader(Structure):
+    _fields_ = [("key", c_void_p), ("value", c_void_p)]
+
+
+class _HttpRequest(Structure):
+    _fields_ = [
+        ("method", c_int),
+        ("path", c_char_p),
+        ("body", c_char_p),
+        ("headers", _HttpHeader * _MAX_HEADERS),
+        ("num_headers", c_size_t),
+    ]
+
+
+class _HttpResponse(Structure):
+    _fields_ = [
+        ("status_code", c_int),
+        ("status_message", c_void_p),
+        ("body", c_void_p),
+        ("body_len", c_size_t),
+        ("headers", _HttpHeader * _MAX_HEADERS),
+        ("num_headers", c_size_t),
+        ("content_length", c_size_t),
+        ("_owned_buffer", c_void_p),
+        ("_mapped_body", c_void_p),
+        ("_mapped_len", c_size_t),
+    ]
+
+
+class _TransportInterface(Structure):
+    _fields_ = [
+        ("context", c_void_p),
+        ("connect", c_void_p),
+        ("write", c_void_p),
+        ("writev", c_void_p),
+        ("read", c_void_p),
+        ("close", c_void_p),
+        ("destroy", CFUNCTYPE(None, c_void_p)),
+        ("is_stale", c_void_p),
+        ("read_all", c_void_p),
+    ]
+
+
+class _HttpProtocolInterface(Structure):
+    _fields_ = [
+        ("context", c_void_p),
+        ("transport", POINTER(_TransportInterface)),
+        ("connect", CFUNCTYPE(_Error, c_void_p, c_char_p, c_int)),
+        ("disconnect", CFUNCTYPE(_Error, c_void_p)),
+        ("perform_request", CFUNCTYPE(_Error, c_void_p, POINTER(_HttpRequest), POINTER(_HttpResponse))),
+        ("destroy", CFUNCTYPE(None, c_void_p)),
+    ]
+
+
+_TRANSPORT_ERRORS: dict[int, type[TransportError]] = {
+    1: DnsFailureError,
+    2: SocketCreateError,
+    3: SocketConnectError,
+    4: SocketWriteError,
+    5: SocketReadError,
+    6: ConnectionClosedError,
+    7: SocketCloseFailure,
+    8: TransportInitError,
+}
+
+_HTTP_CLIENT_ERRORS: dict[int, type[HttpClientError]] = {
+    1: UrlParseError,
+    2: HttpParseError,
+    3: InvalidRequestError,
+    4: HttpClientInitError,
+}
+
+
+def _check(err: _Error) -> None:
+    if err.type == _ERROR_TYPE_NONE:
+        return
+    if err.type == _ERROR_TYPE_TRANSPORT:
+        raise _TRANSPORT_ERRORS.get(err.code, TransportError)(f"Native transport error {err.code}")
+    raise _HTTP_CLIENT_ERRORS.get(err.code, HttpClientError)(f"Native client error {err.code}")
+
+
+@functools.cache
+def load_library(path: str | None = None) -> ctypes.CDLL:
+    """Loads the C library from `path`, $HTTPPY_NATIVE_LIB or the dynamic loader's search path."""
+    candidates = [path, os.environ.get("HTTPPY_NATIVE_LIB"), ctypes.util.find_library("httpc_lib"), "libhttpc_lib.so"]
+    last_error: OSError | None = None
+    for candidate in filter(None, candidates):
+        try:
+            lib = ctypes.CDLL(candidate)
+            break
+        except OSError as e:
+            last_error = e
+    else:
+        raise HttpClientInitError(f"Could not load the native httpc library: {last_error}")
+
+    for new in (lib.tcp_transport_new, lib.unix_transport_new):
+        new.argtypes = [c_void_p]
+        new.restype = POINTER(_TransportInterface)
+    lib.http1_protocol_new.argtypes = [POINTER(_TransportInterface), c_void_p, c_int, c_int]
+    lib.http1_protocol_new.restype = POINTER(_HttpProtocolInterface)
+    lib.http1_protocol_set_memory_policy.argtypes = [POINTER(_HttpProtocolInterface), c_int]
+    lib.http1_protocol_set_memory_policy.restype = _Error
+    lib.http_response_destroy.argtypes = [POINTER(_HttpResponse)]
+    lib.http_response_destroy.restype = None
+    lib.strlen.argtypes = [c_void_p]
+    lib.strlen.restype = c_size_t
+    return lib
+
+
+def is_available(path: str | None = None) -> bool:
+    try:
+        load_library(path)
+        return True
+    except HttpClientInitError:
+        return False
+
+
+class _OwnedResponse:
+    """Keeps a safe C response alive for as long as any view into it exists."""
+
+    def __init__(self, lib: ctypes.CDLL, response: _HttpResponse) -> None:
+        self._lib = lib
+        self._response = response
+
+    def view(self, address: int | None, length: int) -> memoryview:
+        if not address or length == 0:
+            return memoryview(b"")
+        array = (ctypes.c_char * length).from_address(address)
+        array._owner = self  # type: ignore[attr-defined]
+        return memoryview(array).cast("B")
+
+    def __del__(self) -> None:
+        self._lib.http_response_destroy(byref(self._response))
+
+
+class NativeHttp1Protocol(HttpProtocol):
+    def __init__(self, transport_class: type[Transport] = TcpTransport, library_path: str | None = None) -> None:
+        self._lib = load_library(library_path)
+        self._protocol: ctypes._Pointer[_HttpProtocolInterface] | None = None
+
+        if transport_class is TcpTransport:
+            transport = self._lib.tcp_transport_new(None)
+        elif transport_class is UnixTransport:
+            transport = self._lib.unix_transport_new(None)
+        else:
+            raise HttpClientInitError(f"No native transport for {transport_class.__name__}")
+        if not transport:
+            raise TransportInitError("Native transport allocation failed.")
+
+        protocol = self._lib.http1_protocol_new(
+            transport, None, _HTTP_RESPONSE_SAFE_OWNING, _HTTP_IO_VECTORED_WRITE)
+        if not protocol:
+            transport.contents.destroy(transport.contents.context)
+            raise HttpClientInitError("Native protocol allocation failed.")
+
+        self._protocol = protocol
+        self._policy = _HTTP_RESPONSE_SAFE_OWNING
+
+    def connect(self, host: str, port: int) -> None:
+        iface = self._interface()
+        _check(iface.connect(iface.context, host.encode('ascii'), port))
+
+    def disconnect(self) -> None:
+        iface = self._interface()
+        _check(iface.disconnect(iface.context))
+
+    def perform_request_safe(self, request: HttpRequest) -> SafeHttpResponse:
+        response = self._perform(request, _HTTP_RESPONSE_SAFE_OWNING)
+        owner = _OwnedResponse(self._lib, response)
+
+        headers = [
+            (ctypes.string_at(h.key).decode('ascii'), ctypes.string_at(h.value).decode('ascii'))
+            for h in response.headers[:response.num_headers]
+        ]
+        return SafeHttpResponse(
+            status_code=response.status_code,
+            status_message=ctypes.string_at(response.status_message).decode('ascii') if response.status_message else "",
+            body=owner.view(response.body, response.body_len),
+            headers=headers,
+            content_length=self._content_length(response, (key for key, _ in headers)),
+        )
+
+    def perform_request_unsafe(self, request: HttpRequest) -> UnsafeHttpResponse:
+        # Views into the protocol's receive buffer: valid until the next request.
+        response = self._perform(request, _HTTP_RESPONSE_UNSAFE_ZERO_COPY)
+
+        headers = [(self._view(h.key), self._view(h.value)) for h in response.headers[:response.num_headers]]
+        return UnsafeHttpResponse(
+            status_code=response.status_code,
+            status_message=self._view(response.status_message),
+            body=self._view(response.body, response.body_len),
+            headers=headers,
+            content_length=self._content_length(response, (bytes(key).decode('ascii') for key, _ in headers)),
+        )
+
+    def close(self) -> None:
+        if self._protocol is not None:
+            iface = self._protocol.contents
+            transport = iface.transport.contents
+            iface.destroy(iface.context)
+            transport.destroy(transport.context)
+            self._protocol = None
+
+    def __del__(self) -> None:
+        self.close()
+
+    def _interface(self) -> _HttpProtocolInterface:
+        if self._protocol is None:
+            raise TransportError("Native protocol has been closed.")
+        return self._protocol.contents
+
+    def _perform(self, request: HttpRequest, policy: int) -> _HttpResponse:
+        iface = self._interface()
+        if policy != self._policy:
+            _check(self._lib.http1_protocol_set_memory_policy(self._protocol, policy))
+            self._policy = policy
+
+        if len(request.headers) > _MAX_HEADERS:
+            raise InvalidRequestError(f"The native backend supports at most {_MAX_HEADERS} headers.")
+
+        c_request = _HttpRequest()
+        c_request.method = _HTTP_POST if request.method == HttpMethod.POST else _HTTP_GET
+        c_request.path = request.path.encode('ascii')
+        # bytes are passed by pointer; the C side takes the length from Content-Length.
+        c_request.body = bytes(request.body) if request.body else None
+        # `encoded` keeps the header bytes alive until the call returns.
+        encoded = [(key.encode('ascii'), value.encode('ascii')) for key, value in request.headers]
+        for i, (key, value) in enumerate(encoded):
+            c_request.headers[i].key = ctypes.cast(c_char_p(key), c_void_p)
+            c_request.headers[i].value = ctypes.cast(c_char_p(value), c_void_p)
+        c_request.num_headers = len(encoded)
+
+        response = _HttpResponse()
+        err = iface.perform_request(iface.context, byref(c_request), byref(response))
+        if err.type != _ERROR_TYPE_NONE:
+            self._lib.http_response_destroy(byref(response))
+        _check(err)
+        return response
+
+    def _view(self, address: int | None, length: int | None = None) -> memoryview:
+        if not address:
+            return memoryview(b"")
+        if length is None:
+            length = self._lib.strlen(address)
+        if length == 0:
+            return memoryview(b"")
+        return memoryview((ctypes.c_char * length).from_address(address)).cast("B")
+
+    @staticmethod
+    def _content_length(response: _HttpResponse, keys: Iterable[str]) -> int | None:
+        # The C response reports 0 both for "Content-Length: 0" and for no header at all.
+        if any(key.lower() == "content-length" for key in keys):
+            return int(response.content_length)
+        return None
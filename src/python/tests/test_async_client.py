@@ -0,0 +1,165 @@
+import asyncio
+import os
+import time
+
+import pytest
+
+from httppy.async_client import AsyncHttpClient
+from httppy.tcp_transport import TcpTransport
+from httppy.unix_transport import UnixTransport
+from httppy.errors import InvalidRequestError, SocketConnectError, ConnectionClosedError
+from httppy.http_protocol import HttpRequest, SafeHttpResponse
+
+
+async def read_request(reader: asyncio.StreamReader) -> tuple[bytes, bytes] | None:
+    try:
+        head = await reader.readuntil(b"\r\n\r\n")
+    except (asyncio.IncompleteReadError, ConnectionError):
+        return None
+    length = 0
+    for line in head.split(b"\r\n"):
+        if line.lower().startswith(b"content-length:"):
+            length = int(line.split(b":", 1)[1])
+    return head, await reader.readexactly(length)
+
+
+async def start_server(transport_class, handler):
+    """Starts a server and returns (server, connect address, accepted-connection counter)."""
+    connections = []
+
+    async def on_client(reader, writer):
+        connections.append(writer)
+        try:
+            await handler(reader, writer)
+        finally:
+            writer.close()
+
+    if transport_class is TcpTransport:
+        server = await asyncio.start_server(on_client, "127.0.0.1", 0)
+        address = server.sockets[0].getsockname()[:2]
+    else:
+        path = f"/tmp/httppy_async_test_{os.getpid()}_{time.time_ns()}.sock"
+        server = await asyncio.start_unix_server(on_client, path)
+        address = (path, 0)
+    return server, address, connections
+
+
+async def echo_path(reader, writer):
+    while (request := await read_request(reader)) is not None:
+        head, body = request
+        payload = head.split(b" ")[1] + body
+        writer.write(b"HTTP/1.1 200 OK\r\nContent-Length: %d\r\n\r\n%s" % (len(payload), payload))
+        await writer.drain()
+
+
+@pytest.mark.parametrize("transport_class", [TcpTransport, UnixTransport])
+def test_get_and_post_over_keep_alive_connection(transport_class):
+    async def scenario():
+        server, address, connections = await start_server(transport_class, echo_path)
+        async with server, AsyncHttpClient(transport_class, max_connections=1) as client:
+            await client.connect(*address)
+
+            res = await client.get(HttpRequest(path="/hello"))
+            assert isinstance(res, SafeHttpResponse)
+            assert res.status_code == 200
+            assert res.status_message == "OK"
+            assert res.headers == [("Content-Length", "6")]
+            assert res.body == b"/hello"
+
+            body = b"key=value"
+            res = await client.post(HttpRequest(path="/submit", body=body,
+                                                headers=[("Content-Length", str(len(body)))]))
+            assert res.body == b"/submitkey=value"
+            assert len(connections) == 1
+
+    asyncio.run(scenario())
+
+
+def test_pool_bounds_concurrent_connections():
+    async def scenario():
+        server, address, connections = await start_server(TcpTransport, echo_path)
+        async with server, AsyncHttpClient(TcpTransport, max_connections=3) as client:
+            await client.connect(*address)
+
+            requests = []
+            for i in range(20):
+                body = b"x" * (i + 1) * 1000
+                requests.append(client.post(HttpRequest(path=f"/{i}", body=body,
+                                                        headers=[("Content-Length", str(len(body)))])))
+            responses = await asyncio.gather(*requests)
+
+            for i, res in enumerate(responses):
+                assert res.body == f"/{i}".encode() + b"x" * (i + 1) * 1000
+            assert len(connections) == 3
+
+    asyncio.run(scenario())
+
+
+def test_parses_response_delivered_byte_by_byte():
+    response = b"HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 5\r\n\r\nHello"
+
+    async def trickle(reader, writer):
+        while await read_request(reader) is not None:
+            for i in range(len(response)):
+                writer.write(response[i:i + 1])
+                await writer.drain()
+                await asyncio.sleep(0)
+
+    async def scenario():
+        server, address, _ = await start_server(TcpTransport, trickle)
+        async with server, AsyncHttpClient(TcpTransport) as client:
+            await client.connect(*address)
+            for _ in range(2):
+                res = await client.get(HttpRequest(path="/"))
+                assert res.content_length == 5
+                assert res.body == b"Hello"
+
+    asyncio.run(scenario())
+
+
+def test_reads_body_until_close_without_content_length():
+    async def until_close(reader, writer):
+        await read_request(reader)
+        writer.write(b"HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nBody until close")
+        await writer.drain()
+
+    async def scenario():
+        server, address, connections = await start_server(TcpTransport, until_close)
+        async with server, AsyncHttpClient(TcpTransport) as client:
+            await client.connect(*address)
+            res = await client.get(HttpRequest(path="/"))
+            assert res.content_length is None
+            assert res.body == b"Body until close"
+
+            # The closed connection is not reused.
+            res = await client.get(HttpRequest(path="/"))
+            assert res.body == b"Body until close"
+            assert len(connections) == 2
+
+    asyncio.run(scenario())
+
+
+def test_errors():
+    async def truncated(reader, writer):
+        await read_request(reader)
+        writer.write(b"HTTP/1.1 200 OK\r\nContent-Length: 100\r\n\r\nshort")
+        await writer.drain()
+
+    async def scenario():
+        client = AsyncHttpClient(TcpTransport)
+        with pytest.raises(InvalidRequestError):
+            await client.get(HttpRequest(body=b"not allowed"))
+        with pytest.raises(InvalidRequestError):
+            await client.post(HttpRequest(body=b"no length"))
+
+        server, address, _ = await start_server(TcpTransport, truncated)
+        async with server:
+            await client.connect(*address)
+            with pytest.raises(ConnectionClosedError):
+                await client.get(HttpRequest(path="/"))
+            await client.disconnect()
+
+        with pytest.raises(SocketConnectError):
+            await AsyncHttpClient(TcpTransport).connect(*address)
+
+    asyncio.run(scenario())
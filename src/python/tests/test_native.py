@@ -0,0 +1,169 @@
+import os
+import socket
+import threading
+import time
+
+import pytest
+
+from contextlib import contextmanager
+from typing import Callable, Type
+
+from httppy import native
+from httppy.httppy import HttpClient
+from httppy.tcp_transport import TcpTransport
+from httppy.unix_transport import UnixTransport
+from httppy.transport import Transport
+from httppy.errors import SocketConnectError, HttpParseError
+from httppy.http_protocol import HttpRequest, SafeHttpResponse, UnsafeHttpResponse
+
+if not native.is_available():
+    pytest.skip("native httpc library not found (set HTTPPY_NATIVE_LIB)", allow_module_level=True)
+
+
+@contextmanager
+def serve(transport_class: Type[Transport], handler: Callable[[socket.socket], None], connections: int = 1):
+    if transport_class is TcpTransport:
+        listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        listener.bind(("127.0.0.1", 0))
+        address = listener.getsockname()
+    else:
+        path = f"/tmp/httppy_native_test_{os.getpid()}_{time.time_ns()}.sock"
+        listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        listener.bind(path)
+        address = (path, 0)
+    listener.listen()
+
+    def accept_loop():
+        workers = []
+        for _ in range(connections):
+            client_sock, _ = listener.accept()
+            worker = threading.Thread(target=lambda s=client_sock: (handler(s), s.close()))
+            worker.start()
+            workers.append(worker)
+        for worker in workers:
+            worker.join()
+
+    thread = threading.Thread(target=accept_loop)
+    thread.start()
+    try:
+        yield address
+    finally:
+        thread.join(timeout=5.0)
+        listener.close()
+        if transport_class is UnixTransport:
+            os.remove(address[0])
+
+
+def reply(response: bytes, requests: int = 1, delay: float = 0.0) -> Callable[[socket.socket], None]:
+    def handler(sock: socket.socket):
+        for _ in range(requests):
+            if not sock.recv(65536):
+                return
+            time.sleep(delay)
+            sock.sendall(response)
+    return handler
+
+
+@pytest.mark.parametrize("transport_class", [TcpTransport, UnixTransport])
+def test_safe_get_returns_zero_copy_body(transport_class):
+    response = b"HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 7\r\n\r\nsuccess"
+
+    with serve(transport_class, reply(response)) as address:
+        client = HttpClient(native.NativeHttp1Protocol(transport_class))
+        client.connect(*address)
+
+        res = client.get_safe(HttpRequest(path="/test"))
+
+        assert isinstance(res, SafeHttpResponse)
+        assert res.status_code == 200
+        assert res.status_message == "OK"
+        assert res.headers == [("Content-Type", "text/plain"), ("Content-Length", "7")]
+        assert res.content_length == 7
+        assert isinstance(res.body, memoryview)
+        assert res.body == b"success"
+        client.disconnect()
+
+
+@pytest.mark.parametrize("transport_class", [TcpTransport, UnixTransport])
+def test_unsafe_post_returns_views(transport_class):
+    response = b"HTTP/1.1 201 Created\r\nContent-Length: 2\r\n\r\nok"
+
+    with serve(transport_class, reply(response)) as address:
+        client = HttpClient(native.NativeHttp1Protocol(transport_class))
+        client.connect(*address)
+
+        body = b"key=value"
+        res = client.post_unsafe(HttpRequest(path="/submit", body=body,
+                                             headers=[("Content-Length", str(len(body)))]))
+
+        assert isinstance(res, UnsafeHttpResponse)
+        assert res.status_code == 201
+        assert res.status_message.tobytes() == b"Created"
+        assert res.headers[0][0].tobytes() == b"Content-Length"
+        assert res.body.tobytes() == b"ok"
+        client.disconnect()
+
+
+def test_safe_body_outlives_later_requests_and_protocol():
+    responses = [b"HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nfirst",
+                 b"HTTP/1.1 200 OK\r\nContent-Length: 6\r\n\r\nsecond"]
+
+    def handler(sock: socket.socket):
+        for response in responses:
+            sock.recv(65536)
+            sock.sendall(response)
+
+    with serve(TcpTransport, handler) as address:
+        protocol = native.NativeHttp1Protocol(TcpTransport)
+        client = HttpClient(protocol)
+        client.connect(*address)
+
+        first = client.get_safe(HttpRequest(path="/1")).body
+        second = client.get_unsafe(HttpRequest(path="/2")).body.tobytes()
+        client.disconnect()
+        protocol.close()
+
+        assert first == b"first"
+        assert second == b"second"
+
+
+def test_native_errors_map_to_python_exceptions():
+    with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as probe:
+        probe.bind(("127.0.0.1", 0))
+        port = probe.getsockname()[1]
+
+    client = HttpClient(native.NativeHttp1Protocol(TcpTransport))
+    with pytest.raises(SocketConnectError):
+        client.connect("127.0.0.1", port)
+
+    malformed = b"garbage without a header separator"
+    with serve(TcpTransport, reply(malformed)) as address:
+        client.connect(*address)
+        with pytest.raises(HttpParseError):
+            client.get_safe(HttpRequest(path="/"))
+
+
+def test_requests_on_separate_threads_overlap():
+    delay = 0.3
+    threads = 4
+    response = b"HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok"
+    results = []
+
+    with serve(TcpTransport, reply(response, delay=delay), connections=threads) as address:
+        def worker():
+            client = HttpClient(native.NativeHttp1Protocol(TcpTransport))
+            client.connect(*address)
+            results.append(client.get_safe(HttpRequest(path="/slow")).body == b"ok")
+            client.disconnect()
+
+        start = time.monotonic()
+        workers = [threading.Thread(target=worker) for _ in range(threads)]
+        for w in workers:
+            w.start()
+        for w in workers:
+            w.join()
+        elapsed = time.monotonic() - start
+
+    assert results == [True] * threads
+    # Serialized on the GIL this would take threads * delay.
+    assert elapsed < delay * threads / 2
@@ -129,15 +129,17 @@ fn run_benchmark<T: Transport + Default>(
             client_receive_time = get_nanoseconds();
             if res.status_code != 200 { return Err(format!("Request failed with status: {}", res.status_code).into()); }
 
+            let body = res.body();
             if config.verify {
-                let res_payload = &res.body[..res.body.len() - 35];
-                let res_checksum_hex = std::str::from_utf8(&res.body[res.body.len() - 35..res.body.len() - 19])?;
+                let res_payload = &body[..body.len() - 35];
+                let res_checksum_hex = std::str::from_utf8(&body[body.len() - 35..body.len() - 19])?;
                 if xor_checksum(res_payload) != u64::from_str_radix(res_checksum_hex, 16)? {
                     eprintln!("Warning: Checksum mismatch on request {}", i);
                 }
             }
-            let server_timestamp_str = std::str::from_utf8(&res.body[res.body.len() - 19..])?;
+            let server_timestamp_str = std::str::from_utf8(&body[body.len() - 19..])?;
             server_timestamp = server_timestamp_str.parse::<u64>()?;
+            client.recycle(res);
         }
 
         latencies[i as usize] = (client_receive_time - server_timestamp) as i64;
@@ -15,6 +15,7 @@ pub enum TransportError {
     ConnectionClosed,
     SocketCloseFailure,
     InitFailure,
+    WouldBlock,
 }
 
 impl fmt::Display for TransportError {
@@ -57,6 +58,10 @@ impl std::error::Error for Error {}
 
 impl From<std::io::Error> for Error {
     fn from(err: std::io::Error) -> Self {
+        // Expected on non-blocking sockets; not worth reporting.
+        if err.kind() == std::io::ErrorKind::WouldBlock {
+            return Error::Transport(TransportError::WouldBlock);
+        }
         eprintln!("\nCaught underlying std::io::Error: {:?}\n", err);
         let kind = match err.kind() {
             std::io::ErrorKind::NotFound => TransportError::DnsFailure,
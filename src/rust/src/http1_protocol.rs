@@ -1,19 +1,45 @@
-use std::io::Write;
-use std::cmp::max;
+use std::io::{IoSlice, Write};
+use std::mem::MaybeUninit;
+use std::ops::Range;
 use std::sync::atomic::{AtomicUsize, Ordering};
 use std::default::Default;
 
 use crate::error::{Error, HttpClientError, Result, TransportError};
-use crate::http_protocol::{HttpHeaderView, HttpOwnedHeader, HttpMethod, HttpProtocol, HttpRequest, SafeHttpResponse, UnsafeHttpResponse};
+use crate::http_protocol::{str_at, HeaderRange, HttpHeaderView, HttpMethod, HttpProtocol, HttpRequest, SafeHttpResponse, UnsafeHttpResponse};
 use crate::transport::Transport;
 
 static TEST_COUNTER: AtomicUsize = AtomicUsize::new(0);
 
+// Where the parts of a received response live in the receive buffer.
+struct ResponseLayout {
+    status_code: u16,
+    status_message: Range<usize>,
+    headers: Vec<HeaderRange>,
+    body: Range<usize>,
+    content_length: Option<usize>,
+}
+
 pub struct Http1Protocol<T: Transport> {
     transport: T,
     buffer: Vec<u8>,
+    // Replacement for `buffer` when a safe response takes ownership of it.
+    spare: Vec<u8>,
     header_size: usize,
     content_length: Option<usize>,
+    scanned: usize,
+    // Bytes at the start of `buffer`'s allocation known to be initialized; past `len` they are
+    // left over from earlier reads or zeroed by `read_step`, so they can be lent out as `&mut [u8]`.
+    initialized: usize,
+    // The allocation `initialized` describes, as (address, capacity). Capacity only grows, so an
+    // unchanged pair means `buffer` was neither swapped nor reallocated since.
+    initialized_for: (usize, usize),
+    // The same watermark for `spare`, carried over from the response it was recycled from.
+    spare_initialized: usize,
+    // A POST body queued by `start_request`, kept out of `buffer` so `poll_write` sends it
+    // after the head in the same vectored writes.
+    request_body: Vec<u8>,
+    // Bytes of head and body together that `poll_write` has sent.
+    write_pos: usize,
 }
 
 impl<T: Transport + Default> Default for Http1Protocol<T> {
@@ -21,8 +47,15 @@ impl<T: Transport + Default> Default for Http1Protocol<T> {
         Self {
             transport: T::default(),
             buffer: Vec::new(), // or Vec::default()
+            spare: Vec::new(),
             header_size: 0,
             content_length: None,
+            scanned: 0,
+            initialized: 0,
+            initialized_for: (0, 0),
+            spare_initialized: 0,
+            request_body: Vec::new(),
+            write_pos: 0,
         }
     }
 }
@@ -30,19 +63,104 @@ impl<T: Transport + Default> Default for Http1Protocol<T> {
 impl<T: Transport> Http1Protocol<T> {
     const HEADER_SEPARATOR: &'static [u8] = b"\r\n\r\n";
     const HEADER_SEPARATOR_CL: &'static [u8] = b"Content-Length:";
+    const MIN_READ_SIZE: usize = 1024;
+    const MAX_READ_WINDOW: usize = 64 * 1024;
 
     pub fn new(transport: T) -> Self {
         Self {
             transport,
             buffer: Vec::with_capacity(1024),
+            spare: Vec::new(),
             header_size: 0,
             content_length: None,
+            scanned: 0,
+            initialized: 0,
+            initialized_for: (0, 0),
+            spare_initialized: 0,
+            request_body: Vec::new(),
+            write_pos: 0,
+        }
+    }
+
+    pub fn transport(&self) -> &T {
+        &self.transport
+    }
+
+    // --- Non-blocking Request Driving ---
+    //
+    // For transports whose reads and writes fail with `TransportError::WouldBlock`, a driver such
+    // as `MultiClient` calls `start_request` once and then `poll_write` / `poll_read` whenever the
+    // socket is ready; each returns `Ok(true)` when its phase is complete.
+    //
+    // The write usually outlives `request`, so a POST body is handed over as `body` rather than
+    // borrowed from `request.body`, which is not read here.
+
+    pub fn start_request(&mut self, request: &HttpRequest, body: Vec<u8>) {
+        self.build_request_head(request);
+        self.request_body = if request.method == HttpMethod::Post { body } else { Vec::new() };
+        self.write_pos = 0;
+    }
+
+    pub fn poll_write(&mut self) -> Result<bool> {
+        let head_len = self.buffer.len();
+        while self.write_pos < head_len + self.request_body.len() {
+            let slices = [
+                IoSlice::new(&self.buffer[self.write_pos.min(head_len)..]),
+                IoSlice::new(&self.request_body[self.write_pos.saturating_sub(head_len)..]),
+            ];
+            match self.transport.write_vectored(&slices) {
+                Ok(0) => return Err(Error::Transport(TransportError::SocketWriteFailure)),
+                Ok(n) => self.write_pos += n,
+                Err(Error::Transport(TransportError::WouldBlock)) => return Ok(false),
+                Err(e) => return Err(e),
+            }
         }
+        self.request_body = Vec::new();
+        self.reset_response_state();
+        Ok(true)
+    }
+
+    pub fn poll_read(&mut self) -> Result<bool> {
+        loop {
+            match self.read_step() {
+                Ok(true) => {
+                    self.finish_response()?;
+                    return Ok(true);
+                }
+                Ok(false) => {}
+                Err(Error::Transport(TransportError::WouldBlock)) => return Ok(false),
+                Err(e) => return Err(e),
+            }
+        }
+    }
+
+    // Parses the response completed by `poll_read` into an owning response.
+    pub fn take_safe_response(&mut self) -> Result<SafeHttpResponse> {
+        let layout = self.parse_layout()?;
+        let initialized = self.buffer_initialized();
+        let replacement = std::mem::take(&mut self.spare);
+        let mut buffer = std::mem::replace(&mut self.buffer, replacement);
+        let replacement_initialized = std::mem::take(&mut self.spare_initialized);
+        self.adopt_watermark(replacement_initialized);
+        buffer.truncate(layout.body.end);
+        self.reset_response_state();
+
+        Ok(SafeHttpResponse::from_buffer(
+            buffer,
+            layout.status_code,
+            layout.status_message,
+            layout.headers,
+            layout.body,
+            layout.content_length,
+        )
+        .with_initialized(initialized))
     }
 
     // --- Private Helper Methods ---
 
-    fn build_request_string(&mut self, request: &HttpRequest) {
+    // Serializes the request line and headers only; a POST body is sent straight from the
+    // caller's slice by `write_request`.
+    fn build_request_head(&mut self, request: &HttpRequest) {
         self.buffer.clear();
 
         let method_str = match request.method {
@@ -57,58 +175,115 @@ impl<T: Transport> Http1Protocol<T> {
         }
 
         self.buffer.extend_from_slice(b"\r\n");
+    }
+
+    fn write_request(&mut self, request: &HttpRequest) -> Result<()> {
+        if request.body.is_empty() || request.method != HttpMethod::Post {
+            self.transport.write(&self.buffer)?;
+            return Ok(());
+        }
 
-        if !request.body.is_empty() && request.method == HttpMethod::Post {
-            self.buffer.extend_from_slice(request.body);
+        let mut slices = [IoSlice::new(&self.buffer), IoSlice::new(request.body)];
+        let mut remaining: &mut [IoSlice] = &mut slices;
+        while !remaining.is_empty() {
+            let written = self.transport.write_vectored(remaining)?;
+            if written == 0 {
+                return Err(Error::Transport(TransportError::SocketWriteFailure));
+            }
+            IoSlice::advance_slices(&mut remaining, written);
         }
+        Ok(())
     }
 
-    fn read_full_response(&mut self) -> Result<()> {
+    fn reset_response_state(&mut self) {
         self.buffer.clear();
         self.header_size = 0;
         self.content_length = None;
+        self.scanned = 0;
+    }
 
-        loop {
-            let available_capacity = self.buffer.capacity() - self.buffer.len();
-            let read_amount = max(available_capacity, 1024);
-            let old_len = self.buffer.len();
-            self.buffer.resize(old_len + read_amount, 0);
-
-            let bytes_read = match self.transport.read(&mut self.buffer[old_len..]) {
-                Ok(n) => n,
-                Err(Error::Transport(TransportError::ConnectionClosed)) => {
-                    self.buffer.truncate(old_len);
-                    if self.content_length.is_some() && self.buffer.len() < self.header_size + self.content_length.unwrap() {
-                        return Err(Error::Http(HttpClientError::HttpParseFailure));
-                    }
-                    break;
-                }
-                Err(e) => {
-                    self.buffer.truncate(old_len);
-                    return Err(e);
+    // How much of `buffer`'s allocation is initialized: the watermark while it still describes
+    // this allocation, otherwise only what `len` covers (all a reallocation copies over).
+    fn buffer_initialized(&self) -> usize {
+        if (self.buffer.as_ptr() as usize, self.buffer.capacity()) == self.initialized_for {
+            self.initialized
+        } else {
+            self.buffer.len()
+        }
+    }
+
+    // Makes `initialized` describe the allocation `buffer` holds now.
+    fn adopt_watermark(&mut self, initialized: usize) {
+        self.initialized = initialized.max(self.buffer.len());
+        self.initialized_for = (self.buffer.as_ptr() as usize, self.buffer.capacity());
+    }
+
+    fn read_full_response(&mut self) -> Result<()> {
+        self.reset_response_state();
+        while !self.read_step()? {}
+        self.finish_response()
+    }
+
+    // Performs one transport read and folds it into the response state. Returns `Ok(true)` once
+    // the response is complete (by Content-Length or connection close).
+    fn read_step(&mut self) -> Result<bool> {
+        if self.buffer.capacity() - self.buffer.len() < Self::MIN_READ_SIZE {
+            self.buffer.reserve(Self::MIN_READ_SIZE);
+        }
+        self.adopt_watermark(self.buffer_initialized());
+        let old_len = self.buffer.len();
+        let spare = self.buffer.spare_capacity_mut();
+        let window = spare.len().min(Self::MAX_READ_WINDOW);
+        let spare = &mut spare[..window];
+        // Zero whatever part of the window no earlier read or zeroing has initialized, as
+        // `read_to_end` does; each byte of an allocation is zeroed at most once, however many
+        // responses it receives.
+        let already_initialized = self.initialized.saturating_sub(old_len).min(window);
+        spare[already_initialized..].fill(MaybeUninit::new(0));
+        self.initialized = self.initialized.max(old_len + window);
+        // SAFETY: every byte of `spare` was initialized above or before, and `MaybeUninit<u8>` has
+        // the layout of `u8`.
+        let read_area = unsafe { &mut *(spare as *mut [MaybeUninit<u8>] as *mut [u8]) };
+
+        let bytes_read = match self.transport.read(read_area) {
+            Ok(n) => n,
+            Err(Error::Transport(TransportError::ConnectionClosed)) => {
+                if self.content_length.is_some() && self.buffer.len() < self.header_size + self.content_length.unwrap() {
+                    return Err(Error::Http(HttpClientError::HttpParseFailure));
                 }
-            };
-
-            self.buffer.truncate(old_len + bytes_read);
-
-            if self.header_size == 0 {
-                if let Some(pos) = self.buffer.windows(4).position(|window| window == Self::HEADER_SEPARATOR) {
-                    self.header_size = pos + 4;
-                    let headers_view = &self.buffer[..self.header_size];
-
-                    for line in headers_view.split(|&b| b == b'\n').skip(1) {
-                        let line = if line.ends_with(b"\r") { &line[..line.len() - 1] } else { line };
-                        if line.is_empty() { break; }
-
-                        if line.len() >= 15 && line[..15].eq_ignore_ascii_case(Self::HEADER_SEPARATOR_CL) {
-                            if let Some(colon_pos) = line.iter().position(|&b| b == b':') {
-                                let value_slice = &line[colon_pos + 1..];
-                                if let Some(start) = value_slice.iter().position(|&b| !b.is_ascii_whitespace()) {
-                                    if let Ok(s) = std::str::from_utf8(&value_slice[start..]) {
-                                        if let Ok(len) = s.parse::<usize>() {
-                                            self.content_length = Some(len);
-                                            break;
-                                        }
+                return Ok(true);
+            }
+            Err(e) => return Err(e),
+        };
+        // `Transport::read` is safe to implement, so its count is checked rather than trusted.
+        if bytes_read > window {
+            return Err(Error::Transport(TransportError::SocketReadFailure));
+        }
+
+        // SAFETY: `bytes_read <= window`, and the first `window` bytes past `old_len` are initialized.
+        unsafe { self.buffer.set_len(old_len + bytes_read) };
+
+        if self.header_size == 0 {
+            // Only rescan the bytes that arrived since the last read, plus enough overlap to
+            // catch a separator split across reads.
+            let scan_start = self.scanned.saturating_sub(Self::HEADER_SEPARATOR.len() - 1);
+            self.scanned = self.buffer.len();
+            if let Some(pos) = self.buffer[scan_start..].windows(4).position(|window| window == Self::HEADER_SEPARATOR) {
+                self.header_size = scan_start + pos + 4;
+                let headers_view = &self.buffer[..self.header_size];
+
+                for line in headers_view.split(|&b| b == b'\n').skip(1) {
+                    let line = if line.ends_with(b"\r") { &line[..line.len() - 1] } else { line };
+                    if line.is_empty() { break; }
+
+                    if line.len() >= 15 && line[..15].eq_ignore_ascii_case(Self::HEADER_SEPARATOR_CL) {
+                        if let Some(colon_pos) = line.iter().position(|&b| b == b':') {
+                            let value_slice = &line[colon_pos + 1..];
+                            if let Some(start) = value_slice.iter().position(|&b| !b.is_ascii_whitespace()) {
+                                if let Ok(s) = std::str::from_utf8(&value_slice[start..]) {
+                                    if let Ok(len) = s.parse::<usize>() {
+                                        self.content_length = Some(len);
+                                        break;
                                     }
                                 }
                             }
@@ -116,26 +291,31 @@ impl<T: Transport> Http1Protocol<T> {
                     }
                 }
             }
+        }
 
-            if let Some(content_len) = self.content_length {
-                if self.buffer.len() >= self.header_size + content_len {
-                    break;
-                }
+        if let Some(content_len) = self.content_length {
+            if self.buffer.len() >= self.header_size + content_len {
+                return Ok(true);
             }
         }
+        Ok(false)
+    }
 
+    fn finish_response(&self) -> Result<()> {
         if self.header_size == 0 && !self.buffer.is_empty() {
             return Err(Error::Http(HttpClientError::HttpParseFailure));
         }
-
         Ok(())
     }
 
-    fn parse_unsafe_response<'a>(&'a self) -> Result<UnsafeHttpResponse<'a>> {
+    fn parse_layout(&self) -> Result<ResponseLayout> {
         if self.header_size == 0 {
             return Err(Error::Http(HttpClientError::HttpParseFailure));
         }
 
+        let offset_of = |part: &[u8]| part.as_ptr() as usize - self.buffer.as_ptr() as usize;
+        let range_of = |part: &[u8]| offset_of(part)..offset_of(part) + part.len();
+
         let headers_block = &self.buffer[..self.header_size - Self::HEADER_SEPARATOR.len()];
 
         let mut parts = headers_block.splitn(2, |&b| b == b'\n');
@@ -147,7 +327,7 @@ impl<T: Transport> Http1Protocol<T> {
 
         let _http_version = status_parts.next();
         let status_code_str = status_parts.next().ok_or(Error::Http(HttpClientError::HttpParseFailure))?;
-        let status_message = status_parts.next().unwrap_or("");
+        let status_message = status_parts.next().map_or(0..0, |m| range_of(m.as_bytes()));
         let status_code = status_code_str.parse::<u16>()?;
 
         let headers = rest_of_headers_bytes
@@ -163,21 +343,29 @@ impl<T: Transport> Http1Protocol<T> {
                 let key = std::str::from_utf8(key_bytes).ok()?;
                 let value = std::str::from_utf8(value_bytes).ok()?.trim();
 
-                Some(HttpHeaderView { key, value })
+                Some(HeaderRange { key: range_of(key.as_bytes()), value: range_of(value.as_bytes()) })
             })
             .collect();
 
         let body = if let Some(len) = self.content_length {
-            &self.buffer[self.header_size..self.header_size + len]
+            self.header_size..self.header_size + len
         } else {
-            &self.buffer[self.header_size..]
+            self.header_size..self.buffer.len()
         };
 
+        Ok(ResponseLayout { status_code, status_message, headers, body, content_length: self.content_length })
+    }
+
+    fn parse_unsafe_response<'a>(&'a self) -> Result<UnsafeHttpResponse<'a>> {
+        let layout = self.parse_layout()?;
         Ok(UnsafeHttpResponse {
-            status_code,
-            status_message,
-            headers,
-            body,
+            status_code: layout.status_code,
+            status_message: str_at(&self.buffer, &layout.status_message),
+            headers: layout.headers
+                .iter()
+                .map(|h| HttpHeaderView { key: str_at(&self.buffer, &h.key), value: str_at(&self.buffer, &h.value) })
+                .collect(),
+            body: &self.buffer[layout.body],
             content_length: self.content_length,
         })
     }
@@ -205,34 +393,39 @@ impl<T: Transport> HttpProtocol for Http1Protocol<T> {
     }
 
     fn perform_request_unsafe<'a, 'b>(&'a mut self, request: &'b HttpRequest) -> Result<UnsafeHttpResponse<'a>> {
-        self.build_request_string(request);
-        self.transport.write(&self.buffer)?;
+        self.build_request_head(request);
+        self.write_request(request)?;
         self.read_full_response()?;
         self.parse_unsafe_response()
     }
 
     fn perform_request_safe<'a>(&mut self, request: &'a HttpRequest) -> Result<SafeHttpResponse> {
-        let unsafe_res = self.perform_request_unsafe(request)?;
-
-        let headers = unsafe_res.headers
-            .iter()
-            .map(|h| HttpOwnedHeader {
-                key: h.key.to_string(),
-                value: h.value.to_string(),
-            })
-            .collect();
+        self.build_request_head(request);
+        self.write_request(request)?;
+        self.read_full_response()?;
+        self.take_safe_response()
+    }
 
-        Ok(SafeHttpResponse {
-            status_code: unsafe_res.status_code,
-            status_message: unsafe_res.status_message.to_string(),
-            body: unsafe_res.body.to_vec(),
-            headers,
-            content_length: unsafe_res.content_length,
-        })
+    fn recycle(&mut self, response: SafeHttpResponse) {
+        let (mut buffer, mut initialized) = response.into_recycled();
+        buffer.clear();
+        // An empty receive buffer holds no request in flight, so the larger allocation can
+        // take its place right away; otherwise keep it for the next hand-over.
+        if self.buffer.is_empty() && buffer.capacity() > self.buffer.capacity() {
+            let current = self.buffer_initialized();
+            std::mem::swap(&mut self.buffer, &mut buffer);
+            self.adopt_watermark(initialized);
+            initialized = current;
+        }
+        if buffer.capacity() > self.spare.capacity() {
+            self.spare = buffer;
+            self.spare_initialized = initialized;
+        }
     }
 }
 
 
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -576,6 +769,72 @@ mod tests {
                 ));
             }
 
+            #[test]
+            fn writes_large_post_body_with_vectored_writes() {
+                let (tx, rx) = mpsc::channel();
+                let body: Vec<u8> = (0..4 * 1024 * 1024).map(|i| (i % 251) as u8).collect();
+                let content_length = body.len().to_string();
+                let head = format!("POST /upload HTTP/1.1\r\nContent-Length: {}\r\n\r\n", content_length);
+                let total_len = head.len() + body.len();
+
+                let server_handle = $server_logic(move |mut stream| {
+                    let mut received = Vec::new();
+                    let mut buffer = vec![0; 64 * 1024];
+                    while received.len() < total_len {
+                        let n = stream.read(&mut buffer).unwrap();
+                        if n == 0 { break; }
+                        received.extend_from_slice(&buffer[..n]);
+                    }
+                    stream.write_all(b"HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n").unwrap();
+                    tx.send(received).unwrap();
+                });
+
+                let mut protocol = Http1Protocol::new(<$transport_type>::new());
+                protocol.connect(&server_handle.addr, server_handle.port).unwrap();
+
+                let request = HttpRequest {
+                    method: HttpMethod::Post,
+                    path: "/upload",
+                    body: &body,
+                    headers: vec![HttpHeaderView { key: "Content-Length", value: &content_length }],
+                };
+
+                let result = protocol.perform_request_unsafe(&request);
+                assert!(result.is_ok());
+
+                let captured = rx.recv().unwrap();
+                assert_eq!(&captured[..head.len()], head.as_bytes());
+                assert_eq!(&captured[head.len()..], body.as_slice());
+            }
+
+            #[test]
+            fn finds_header_separator_split_across_reads() {
+                let server_handle = $server_logic(|mut stream| {
+                    let mut buffer = vec![0; 1024];
+                    stream.read(&mut buffer).unwrap();
+                    stream.write_all(b"HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r").unwrap();
+                    stream.flush().unwrap();
+                    thread::sleep(std::time::Duration::from_millis(20));
+                    stream.write_all(b"\nHello").unwrap();
+                });
+
+                let mut protocol = Http1Protocol::new(<$transport_type>::new());
+                protocol.connect(&server_handle.addr, server_handle.port).unwrap();
+
+                let request = HttpRequest {
+                    method: HttpMethod::Get,
+                    path: "/",
+                    body: &[],
+                    headers: vec![],
+                };
+
+                let res = protocol.perform_request_unsafe(&request).unwrap();
+
+                assert_eq!(res.status_code, 200);
+                assert_eq!(res.content_length, Some(5));
+                assert_eq!(res.body, b"Hello");
+            }
+
             #[test]
             fn safe_request_returns_owning_deep_copy() {
                 let canned_response = b"HTTP/1.1 200 OK\r\n\
@@ -606,13 +865,90 @@ mod tests {
                 let res = result.unwrap();
 
                 assert_eq!(res.status_code, 200);
-                assert_eq!(res.body, b"Safe Buffer");
+                assert_eq!(res.body(), b"Safe Buffer");
 
                 assert_ne!(
-                    res.body.as_ptr(),
+                    res.body().as_ptr(),
                     protocol.get_internal_buffer_ptr_for_test()
                 );
             }
+
+            #[test]
+            fn safe_response_takes_over_receive_buffer() {
+                let canned_response = b"HTTP/1.1 404 Not Found\r\n\
+                                       Content-Type: text/plain\r\n\
+                                       X-Request-ID: abc-123\r\n\
+                                       Content-Length: 7\r\n\
+                                       \r\n\
+                                       Missing";
+
+                let server_handle = $server_logic(|mut stream| {
+                    let mut buffer = vec![0; 1024];
+                    stream.read(&mut buffer).unwrap();
+                    stream.write_all(canned_response).unwrap();
+                    stream.shutdown(Shutdown::Write).unwrap();
+                });
+
+                let mut protocol = Http1Protocol::new(<$transport_type>::new());
+                protocol.connect(&server_handle.addr, server_handle.port).unwrap();
+                let receive_buffer = protocol.get_internal_buffer_ptr_for_test();
+
+                let request = HttpRequest {
+                    method: HttpMethod::Get,
+                    path: "/",
+                    body: &[],
+                    headers: vec![],
+                };
+
+                let res = protocol.perform_request_safe(&request).unwrap();
+
+                assert_eq!(res.status_code, 404);
+                assert_eq!(res.status_message(), "Not Found");
+                assert_eq!(res.content_length, Some(7));
+                assert_eq!(res.headers().len(), 3);
+                let headers: Vec<HttpHeaderView> = res.headers().collect();
+                assert_eq!(headers[1], HttpHeaderView { key: "X-Request-ID", value: "abc-123" });
+                assert_eq!(res.header("content-type"), Some("text/plain"));
+                assert_eq!(res.header("Missing"), None);
+                assert_eq!(res.body(), b"Missing");
+
+                // The response fits the initial capacity, so it still lives in the protocol's
+                // original receive buffer: it was moved out, not copied.
+                let buffer = res.into_buffer();
+                assert_eq!(buffer.as_ptr(), receive_buffer);
+            }
+
+            #[test]
+            fn recycled_buffer_backs_the_next_request() {
+                const RESPONSE: &[u8] = b"HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+                const HEAD_LEN: usize = RESPONSE.len() - 2;
+
+                let server_handle = $server_logic(|mut stream| {
+                    let mut buffer = vec![0; 1024];
+                    for _ in 0..2 {
+                        if stream.read(&mut buffer).unwrap() == 0 { return; }
+                        stream.write_all(RESPONSE).unwrap();
+                    }
+                });
+
+                let mut protocol = Http1Protocol::new(<$transport_type>::new());
+                protocol.connect(&server_handle.addr, server_handle.port).unwrap();
+
+                let request = HttpRequest {
+                    method: HttpMethod::Get,
+                    path: "/",
+                    body: &[],
+                    headers: vec![],
+                };
+
+                let first = protocol.perform_request_safe(&request).unwrap();
+                let first_buffer = first.body().as_ptr().wrapping_sub(HEAD_LEN);
+                protocol.recycle(first);
+
+                let second = protocol.perform_request_safe(&request).unwrap();
+                assert_eq!(second.body(), b"ok");
+                assert_eq!(second.body().as_ptr().wrapping_sub(HEAD_LEN), first_buffer);
+            }
         };
     }
 
@@ -666,4 +1002,73 @@ mod tests {
 
         generate_http1_protocol_tests!(UnixTransport, setup_unix_server);
     }
-}
\ No newline at end of file
+
+    // Answers every read with a canned response, optionally claiming more bytes than it was given.
+    struct ScriptedTransport {
+        response: &'static [u8],
+        overreport: bool,
+    }
+
+    impl Transport for ScriptedTransport {
+        fn connect(&mut self, _host: &str, _port: u16) -> Result<()> { Ok(()) }
+        fn write(&mut self, buf: &[u8]) -> Result<usize> { Ok(buf.len()) }
+        fn write_vectored(&mut self, bufs: &[IoSlice<'_>]) -> Result<usize> { Ok(bufs.iter().map(|b| b.len()).sum()) }
+        fn read(&mut self, buf: &mut [u8]) -> Result<usize> {
+            // A careless implementation may look at the whole slice; it has to be initialized.
+            assert!(buf.iter().all(|&b| b == 0));
+            let n = self.response.len().min(buf.len());
+            buf[..n].copy_from_slice(&self.response[..n]);
+            Ok(if self.overreport { buf.len() + 1 } else { n })
+        }
+        fn close(&mut self) -> Result<()> { Ok(()) }
+    }
+
+    #[test]
+    fn read_count_beyond_the_read_area_is_rejected() {
+        let request = HttpRequest { method: HttpMethod::Get, path: "/", body: &[], headers: vec![] };
+        let response: &'static [u8] = b"HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+
+        let mut honest = Http1Protocol::new(ScriptedTransport { response, overreport: false });
+        assert_eq!(honest.perform_request_unsafe(&request).unwrap().body, b"ok");
+
+        let mut lying = Http1Protocol::new(ScriptedTransport { response, overreport: true });
+        assert!(matches!(
+            lying.perform_request_unsafe(&request).unwrap_err(),
+            Error::Transport(TransportError::SocketReadFailure)
+        ));
+    }
+
+    // Records whether each read area arrived zeroed, then scribbles over it past the response.
+    struct MarkingTransport {
+        zeroed_reads: Vec<bool>,
+    }
+
+    impl Transport for MarkingTransport {
+        fn connect(&mut self, _host: &str, _port: u16) -> Result<()> { Ok(()) }
+        fn write(&mut self, buf: &[u8]) -> Result<usize> { Ok(buf.len()) }
+        fn write_vectored(&mut self, bufs: &[IoSlice<'_>]) -> Result<usize> { Ok(bufs.iter().map(|b| b.len()).sum()) }
+        fn read(&mut self, buf: &mut [u8]) -> Result<usize> {
+            const RESPONSE: &[u8] = b"HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+            self.zeroed_reads.push(buf.iter().all(|&b| b == 0));
+            buf[..RESPONSE.len()].copy_from_slice(RESPONSE);
+            buf[RESPONSE.len()..].fill(0xAB);
+            Ok(RESPONSE.len())
+        }
+        fn close(&mut self) -> Result<()> { Ok(()) }
+    }
+
+    #[test]
+    fn read_area_is_zeroed_once_per_allocation() {
+        let request = HttpRequest { method: HttpMethod::Get, path: "/", body: &[], headers: vec![] };
+        let mut protocol = Http1Protocol::new(MarkingTransport { zeroed_reads: Vec::new() });
+
+        protocol.perform_request_unsafe(&request).unwrap();
+        protocol.perform_request_unsafe(&request).unwrap();
+        // The safe response takes the allocation along with its watermark, and brings both back.
+        let response = protocol.perform_request_safe(&request).unwrap();
+        protocol.recycle(response);
+        protocol.perform_request_unsafe(&request).unwrap();
+
+        assert_eq!(protocol.transport().zeroed_reads, vec![true, false, false, false]);
+    }
+}
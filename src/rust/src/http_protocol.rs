@@ -1,3 +1,5 @@
+use std::ops::Range;
+
 use crate::error::Result;
 use crate::transport::Transport;
 
@@ -27,13 +29,84 @@ pub struct HttpRequest<'a> {
     pub headers: Vec<HttpHeaderView<'a>>,
 }
 
+#[derive(Debug, PartialEq, Clone)]
+pub struct HeaderRange {
+    pub key: Range<usize>,
+    pub value: Range<usize>,
+}
+
+/// An owning response that keeps the protocol's receive buffer instead of copying out of it.
+/// The status message, headers and body are ranges into `buffer`, so producing one allocates
+/// nothing proportional to the body size.
 #[derive(Debug, PartialEq)]
 pub struct SafeHttpResponse {
     pub status_code: u16,
-    pub status_message: String,
-    pub body: Vec<u8>,
-    pub headers: Vec<HttpOwnedHeader>,
     pub content_length: Option<usize>,
+    buffer: Vec<u8>,
+    status_message: Range<usize>,
+    headers: Vec<HeaderRange>,
+    body: Range<usize>,
+    // Bytes of `buffer`'s allocation known to be initialized, including spare capacity the
+    // parser read into. Nothing here hands out the buffer mutably, so it holds until `recycle`.
+    initialized: usize,
+}
+
+impl SafeHttpResponse {
+    /// `buffer` must hold valid UTF-8 in `status_message` and every header range; the parser
+    /// checks this before handing the buffer over.
+    pub(crate) fn from_buffer(
+        buffer: Vec<u8>,
+        status_code: u16,
+        status_message: Range<usize>,
+        headers: Vec<HeaderRange>,
+        body: Range<usize>,
+        content_length: Option<usize>,
+    ) -> Self {
+        let initialized = buffer.len();
+        Self { status_code, content_length, buffer, status_message, headers, body, initialized }
+    }
+
+    /// Records that the first `initialized` bytes of the buffer's allocation are initialized,
+    /// beyond `len` as well; the protocol reads into them again without zeroing once recycled.
+    pub(crate) fn with_initialized(mut self, initialized: usize) -> Self {
+        self.initialized = initialized.max(self.buffer.len());
+        self
+    }
+
+    pub fn status_message(&self) -> &str {
+        str_at(&self.buffer, &self.status_message)
+    }
+
+    pub fn body(&self) -> &[u8] {
+        &self.buffer[self.body.clone()]
+    }
+
+    pub fn headers(&self) -> impl ExactSizeIterator<Item = HttpHeaderView<'_>> {
+        self.headers.iter().map(|h| HttpHeaderView {
+            key: str_at(&self.buffer, &h.key),
+            value: str_at(&self.buffer, &h.value),
+        })
+    }
+
+    /// Case-insensitive lookup of the first header named `key`.
+    pub fn header(&self, key: &str) -> Option<&str> {
+        self.headers().find(|h| h.key.eq_ignore_ascii_case(key)).map(|h| h.value)
+    }
+
+    /// Releases the underlying receive buffer, e.g. to hand it back via `recycle`.
+    pub fn into_buffer(self) -> Vec<u8> {
+        self.buffer
+    }
+
+    pub(crate) fn into_recycled(self) -> (Vec<u8>, usize) {
+        (self.buffer, self.initialized)
+    }
+}
+
+pub(crate) fn str_at<'a>(buffer: &'a [u8], range: &Range<usize>) -> &'a str {
+    // SAFETY: ranges are only produced by the response parser after `str::from_utf8` succeeded
+    // on exactly these bytes, and the buffer is not mutated afterwards.
+    unsafe { std::str::from_utf8_unchecked(&buffer[range.clone()]) }
 }
 
 #[derive(Debug, PartialEq)]
@@ -63,19 +136,23 @@ impl<'a> ParsableResponse<'a> for SafeHttpResponse {
         body: &'a [u8],
         content_length: Option<usize>,
     ) -> Result<Self> {
-        Ok(SafeHttpResponse {
-            status_code,
-            status_message: status_message.to_string(),
-            headers: headers
-                .iter()
-                .map(|h| HttpOwnedHeader {
-                    key: h.key.to_string(),
-                    value: h.value.to_string(),
-                })
-                .collect(),
-            body: body.to_vec(),
-            content_length,
-        })
+        // Views into some other storage: lay them out in a fresh buffer of our own.
+        let mut buffer = Vec::new();
+        let mut append = |bytes: &[u8]| {
+            let start = buffer.len();
+            buffer.extend_from_slice(bytes);
+            start..buffer.len()
+        };
+        let status_message = append(status_message.as_bytes());
+        let headers = headers
+            .iter()
+            .map(|h| HeaderRange {
+                key: append(h.key.as_bytes()),
+                value: append(h.value.as_bytes()),
+            })
+            .collect();
+        let body = append(body);
+        Ok(SafeHttpResponse::from_buffer(buffer, status_code, status_message, headers, body, content_length))
     }
 }
 
@@ -107,4 +184,7 @@ pub trait HttpProtocol {
     fn perform_request_unsafe<'a, 'b>(&'a mut self, request: &'b HttpRequest) -> Result<UnsafeHttpResponse<'a>>;
 
     fn perform_request_safe<'a>(&mut self, request: &'a HttpRequest) -> Result<SafeHttpResponse>;
+
+    /// Hands a finished response's buffer back so a later safe request can reuse its capacity.
+    fn recycle(&mut self, _response: SafeHttpResponse) {}
 }
\ No newline at end of file
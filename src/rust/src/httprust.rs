@@ -63,6 +63,11 @@ impl<P: HttpProtocol> HttpClient<P>
         self.protocol.perform_request_unsafe(request)
     }
 
+    /// Returns a safe response's buffer to the protocol for reuse by later requests.
+    pub fn recycle(&mut self, response: SafeHttpResponse) {
+        self.protocol.recycle(response)
+    }
+
     fn validate_post_request(&self, request: &HttpRequest) -> Result<()> {
         if request.body.is_empty() {
             return Err(Error::Http(HttpClientError::InvalidRequest));
@@ -209,7 +214,7 @@ mod tests {
                     let res = result.unwrap();
 
                     assert_eq!(res.status_code, 200);
-                    assert_eq!(res.body, b"success");
+                    assert_eq!(res.body(), b"success");
 
                     let captured_request = rx.recv().unwrap();
                     assert!(String::from_utf8_lossy(&captured_request).contains("GET /test HTTP/1.1"));
@@ -301,7 +306,7 @@ mod tests {
                     let res = result.unwrap();
 
                     assert_eq!(res.status_code, 200);
-                    assert_eq!(res.body, b"success");
+                    assert_eq!(res.body(), b"success");
 
                     let captured_request = rx.recv().unwrap();
                     let captured_str = String::from_utf8_lossy(&captured_request);
@@ -583,9 +588,10 @@ mod tests {
                             if use_safe {
                                 let res = client.post_safe(&mut request).unwrap();
                                 assert_eq!(res.status_code, 200);
-                                assert!(res.body.len() >= 16);
-                                let payload = &res.body[..res.body.len() - 16];
-                                let checksum_hex = String::from_utf8_lossy(&res.body[res.body.len() - 16..]);
+                                let body = res.body();
+                                assert!(body.len() >= 16);
+                                let payload = &body[..body.len() - 16];
+                                let checksum_hex = String::from_utf8_lossy(&body[body.len() - 16..]);
                                 let calculated = xor_checksum(payload);
                                 let received = u64::from_str_radix(&checksum_hex, 16).unwrap();
                                 assert_eq!(calculated, received, "Client-side checksum mismatch on iteration (safe) {}", i);
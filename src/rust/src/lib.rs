@@ -5,10 +5,16 @@ pub mod unix_transport;
 pub mod http_protocol;
 pub mod http1_protocol;
 pub mod httprust;
+pub mod reactor;
+pub mod nonblocking_transport;
+pub mod multi_client;
 
 pub use transport::Transport;
 pub use tcp_transport::TcpTransport;
 pub use unix_transport::UnixTransport;
 pub use http_protocol::{HttpProtocol, HttpMethod, HttpRequest, HttpHeaderView, SafeHttpResponse, UnsafeHttpResponse};
 pub use http1_protocol::Http1Protocol;
-pub use httprust::HttpClient;
\ No newline at end of file
+pub use httprust::HttpClient;
+pub use reactor::Reactor;
+pub use nonblocking_transport::{NonBlockingTransport, NonBlockingTcpTransport, NonBlockingUnixTransport};
+pub use multi_client::MultiClient;
\ No newline at end of file
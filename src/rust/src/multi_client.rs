@@ -0,0 +1,305 @@
+use std::collections::VecDeque;
+use std::os::unix::io::AsRawFd;
+use std::time::Duration;
+
+use crate::error::{Error, HttpClientError, Result};
+use crate::http1_protocol::Http1Protocol;
+use crate::http_protocol::{HttpHeaderView, HttpMethod, HttpOwnedHeader, HttpProtocol, HttpRequest, SafeHttpResponse};
+use crate::reactor::{Event, Reactor};
+use crate::transport::Transport;
+
+pub type Completion = Box<dyn FnOnce(Result<SafeHttpResponse>)>;
+
+struct QueuedRequest {
+    method: HttpMethod,
+    path: String,
+    headers: Vec<HttpOwnedHeader>,
+    body: Vec<u8>,
+    completion: Completion,
+}
+
+enum Phase {
+    Idle,
+    Writing,
+    Reading,
+}
+
+struct Connection<T: Transport> {
+    protocol: Http1Protocol<T>,
+    phase: Phase,
+    completion: Option<Completion>,
+    queue: VecDeque<QueuedRequest>,
+}
+
+/// Drives many `Http1Protocol` connections from a single thread on top of an epoll `Reactor`.
+///
+/// Each connection carries one request at a time; further submissions to a busy connection are
+/// queued and sent in order. Completions run on the thread calling `run_once` / `run`.
+pub struct MultiClient<T: Transport + AsRawFd> {
+    reactor: Reactor,
+    connections: Vec<Connection<T>>,
+    events: Vec<Event>,
+    pending: usize,
+}
+
+impl<T: Transport + AsRawFd + Default> MultiClient<T> {
+    pub fn new() -> Result<Self> {
+        Ok(Self {
+            reactor: Reactor::new(256)?,
+            connections: Vec::new(),
+            events: Vec::new(),
+            pending: 0,
+        })
+    }
+
+    /// Opens a connection and returns its id for `submit`.
+    pub fn connect(&mut self, host: &str, port: u16) -> Result<usize> {
+        let mut protocol = Http1Protocol::new(T::default());
+        protocol.connect(host, port)?;
+        let id = self.connections.len();
+        self.reactor.register(protocol.transport().as_raw_fd(), id as u64)?;
+        self.connections.push(Connection {
+            protocol,
+            phase: Phase::Idle,
+            completion: None,
+            queue: VecDeque::new(),
+        });
+        Ok(id)
+    }
+
+    pub fn submit<F>(&mut self, connection: usize, request: &HttpRequest, completion: F) -> Result<()>
+    where
+        F: FnOnce(Result<SafeHttpResponse>) + 'static,
+    {
+        let conn = self.connections.get_mut(connection).ok_or(Error::Http(HttpClientError::InvalidRequest))?;
+        self.pending += 1;
+
+        if matches!(conn.phase, Phase::Idle) {
+            conn.protocol.start_request(request, request.body.to_vec());
+            conn.completion = Some(Box::new(completion));
+            conn.phase = Phase::Writing;
+            // Optimistically write now; most requests fit in the socket buffer.
+            self.drive(connection);
+        } else {
+            conn.queue.push_back(QueuedRequest {
+                method: match request.method {
+                    HttpMethod::Get => HttpMethod::Get,
+                    HttpMethod::Post => HttpMethod::Post,
+                },
+                path: request.path.to_string(),
+                headers: request.headers.iter()
+                    .map(|h| HttpOwnedHeader { key: h.key.to_string(), value: h.value.to_string() })
+                    .collect(),
+                body: request.body.to_vec(),
+                completion: Box::new(completion),
+            });
+        }
+        Ok(())
+    }
+
+    /// Requests submitted but not yet completed.
+    pub fn pending(&self) -> usize {
+        self.pending
+    }
+
+    /// Waits for readiness once and advances every ready connection. Returns the number of
+    /// requests completed.
+    pub fn run_once(&mut self, timeout: Option<Duration>) -> Result<usize> {
+        let mut events = std::mem::take(&mut self.events);
+        events.clear();
+        self.reactor.poll(&mut events, timeout)?;
+
+        let before = self.pending;
+        for event in &events {
+            self.drive(event.token as usize);
+        }
+        self.events = events;
+        Ok(before - self.pending)
+    }
+
+    /// Runs until every submitted request has completed.
+    pub fn run(&mut self) -> Result<()> {
+        while self.pending > 0 {
+            self.run_once(None)?;
+        }
+        Ok(())
+    }
+
+    // Advances one connection until its socket would block or it has nothing left to do.
+    fn drive(&mut self, id: usize) {
+        let Some(conn) = self.connections.get_mut(id) else { return };
+        loop {
+            let progress = match conn.phase {
+                Phase::Idle => {
+                    let Some(next) = conn.queue.pop_front() else { return };
+                    let request = HttpRequest {
+                        method: next.method,
+                        path: &next.path,
+                        body: &[],
+                        headers: next.headers.iter()
+                            .map(|h| HttpHeaderView { key: &h.key, value: &h.value })
+                            .collect(),
+                    };
+                    conn.protocol.start_request(&request, next.body);
+                    conn.completion = Some(next.completion);
+                    conn.phase = Phase::Writing;
+                    continue;
+                }
+                Phase::Writing => conn.protocol.poll_write(),
+                Phase::Reading => conn.protocol.poll_read(),
+            };
+
+            let result = match progress {
+                Ok(false) => return,
+                Ok(true) if matches!(conn.phase, Phase::Writing) => {
+                    conn.phase = Phase::Reading;
+                    continue;
+                }
+                Ok(true) => conn.protocol.take_safe_response(),
+                Err(e) => Err(e),
+            };
+
+            conn.phase = Phase::Idle;
+            self.pending -= 1;
+            if let Some(completion) = conn.completion.take() {
+                completion(result);
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::nonblocking_transport::{NonBlockingTcpTransport, NonBlockingUnixTransport};
+    use std::cell::RefCell;
+    use std::io::{Read, Write};
+    use std::net::TcpListener;
+    use std::os::unix::net::UnixListener;
+    use std::rc::Rc;
+    use std::thread;
+
+    // Answers every request with its own path as the body.
+    fn serve_echo_path<S: Read + Write>(mut stream: S) {
+        let mut pending = Vec::new();
+        let mut buffer = [0u8; 1024];
+        loop {
+            while let Some(end) = pending.windows(4).position(|w| w == b"\r\n\r\n") {
+                let head = String::from_utf8_lossy(&pending[..end]).to_string();
+                pending.drain(..end + 4);
+                let path = head.split(' ').nth(1).unwrap_or("").to_string();
+                let response = format!("HTTP/1.1 200 OK\r\nContent-Length: {}\r\n\r\n{}", path.len(), path);
+                if stream.write_all(response.as_bytes()).is_err() {
+                    return;
+                }
+            }
+            match stream.read(&mut buffer) {
+                Ok(0) | Err(_) => return,
+                Ok(n) => pending.extend_from_slice(&buffer[..n]),
+            }
+        }
+    }
+
+    fn get(path: &str) -> HttpRequest<'_> {
+        HttpRequest { method: HttpMethod::Get, path, body: &[], headers: vec![] }
+    }
+
+    #[test]
+    fn completes_queued_requests_across_tcp_connections() {
+        let listener = TcpListener::bind("127.0.0.1:0").unwrap();
+        let addr = listener.local_addr().unwrap();
+        thread::spawn(move || {
+            for stream in listener.incoming().take(4) {
+                let stream = stream.unwrap();
+                thread::spawn(move || serve_echo_path(stream));
+            }
+        });
+
+        let mut client = MultiClient::<NonBlockingTcpTransport>::new().unwrap();
+        let connections: Vec<usize> = (0..4)
+            .map(|_| client.connect(&addr.ip().to_string(), addr.port()).unwrap())
+            .collect();
+
+        let results = Rc::new(RefCell::new(Vec::new()));
+        for round in 0..3 {
+            for &conn in &connections {
+                let path = format!("/c{}/r{}", conn, round);
+                let results = Rc::clone(&results);
+                let expected = path.clone();
+                client.submit(conn, &get(&path), move |res| {
+                    let res = res.unwrap();
+                    assert_eq!(res.status_code, 200);
+                    results.borrow_mut().push((expected, String::from_utf8(res.body().to_vec()).unwrap()));
+                }).unwrap();
+            }
+        }
+        assert_eq!(client.pending(), 12);
+
+        client.run().unwrap();
+
+        assert_eq!(client.pending(), 0);
+        let results = results.borrow();
+        assert_eq!(results.len(), 12);
+        for (expected, body) in results.iter() {
+            assert_eq!(expected, body);
+        }
+    }
+
+    #[test]
+    fn completes_large_post_over_unix_socket() {
+        let socket_path = format!("/tmp/httpc_rust_multi_{}", std::process::id());
+        let _ = std::fs::remove_file(&socket_path);
+        let listener = UnixListener::bind(&socket_path).unwrap();
+        let body_len = 1024 * 1024;
+        // Not one repeated byte, so a misplaced slice of head or body shows.
+        let body: Vec<u8> = (0..body_len).map(|i| (i % 251) as u8).collect();
+        let expected = body.clone();
+        thread::spawn(move || {
+            let (mut stream, _) = listener.accept().unwrap();
+            let mut received = Vec::new();
+            let mut buffer = vec![0u8; 64 * 1024];
+            loop {
+                if let Some(end) = received.windows(4).position(|w| w == b"\r\n\r\n") {
+                    if received.len() >= end + 4 + body_len {
+                        let status = if received[end + 4..] == expected[..] { "201 Created" } else { "400 Bad Request" };
+                        let response = format!("HTTP/1.1 {}\r\nContent-Length: 2\r\n\r\nok", status);
+                        stream.write_all(response.as_bytes()).unwrap();
+                        return;
+                    }
+                }
+                let n = stream.read(&mut buffer).unwrap();
+                if n == 0 { return; }
+                received.extend_from_slice(&buffer[..n]);
+            }
+        });
+
+        let mut client = MultiClient::<NonBlockingUnixTransport>::new().unwrap();
+        let conn = client.connect(&socket_path, 0).unwrap();
+
+        let content_length = body.len().to_string();
+        let request = HttpRequest {
+            method: HttpMethod::Post,
+            path: "/upload",
+            body: &body,
+            headers: vec![HttpHeaderView { key: "Content-Length", value: &content_length }],
+        };
+        let status = Rc::new(RefCell::new(0));
+        let status_for_completion = Rc::clone(&status);
+        client.submit(conn, &request, move |res| {
+            *status_for_completion.borrow_mut() = res.unwrap().status_code;
+        }).unwrap();
+
+        client.run().unwrap();
+        let _ = std::fs::remove_file(&socket_path);
+
+        assert_eq!(*status.borrow(), 201);
+    }
+
+    #[test]
+    fn submit_rejects_unknown_connection() {
+        let mut client = MultiClient::<NonBlockingTcpTransport>::new().unwrap();
+        let result = client.submit(3, &get("/"), |_| {});
+        assert_eq!(result, Err(Error::Http(HttpClientError::InvalidRequest)));
+        assert_eq!(client.pending(), 0);
+    }
+}
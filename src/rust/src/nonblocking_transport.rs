@@ -0,0 +1,157 @@
+use std::io::{IoSlice, Read, Write};
+use std::net::{Shutdown, TcpStream};
+use std::os::unix::io::{AsRawFd, RawFd};
+use std::os::unix::net::UnixStream;
+
+use crate::error::{Error, Result, TransportError};
+use crate::transport::Transport;
+
+/// Stream types `NonBlockingTransport` can drive.
+pub trait NonBlockingStream: Read + Write + AsRawFd + Sized {
+    fn open(host: &str, port: u16) -> Result<Self>;
+    fn enable_nonblocking(&self) -> std::io::Result<()>;
+    fn shutdown_both(&self) -> std::io::Result<()>;
+}
+
+impl NonBlockingStream for TcpStream {
+    fn open(host: &str, port: u16) -> Result<Self> {
+        let stream = TcpStream::connect(format!("{}:{}", host, port))?;
+        stream.set_nodelay(true)?;
+        Ok(stream)
+    }
+
+    fn enable_nonblocking(&self) -> std::io::Result<()> {
+        self.set_nonblocking(true)
+    }
+
+    fn shutdown_both(&self) -> std::io::Result<()> {
+        self.shutdown(Shutdown::Both)
+    }
+}
+
+impl NonBlockingStream for UnixStream {
+    fn open(path: &str, _port: u16) -> Result<Self> {
+        match UnixStream::connect(path) {
+            Ok(stream) => Ok(stream),
+            Err(e) if e.kind() == std::io::ErrorKind::NotFound => {
+                Err(Error::Transport(TransportError::SocketConnectFailure))
+            }
+            Err(e) => Err(e.into()),
+        }
+    }
+
+    fn enable_nonblocking(&self) -> std::io::Result<()> {
+        self.set_nonblocking(true)
+    }
+
+    fn shutdown_both(&self) -> std::io::Result<()> {
+        self.shutdown(Shutdown::Both)
+    }
+}
+
+/// A transport whose reads and writes never block: when the socket is not ready they fail with
+/// `TransportError::WouldBlock`. The connect itself is blocking; the socket is switched to
+/// non-blocking mode once established. Intended to be driven by a `Reactor`.
+pub struct NonBlockingTransport<S: NonBlockingStream> {
+    stream: Option<S>,
+}
+
+pub type NonBlockingTcpTransport = NonBlockingTransport<TcpStream>;
+pub type NonBlockingUnixTransport = NonBlockingTransport<UnixStream>;
+
+impl<S: NonBlockingStream> NonBlockingTransport<S> {
+    pub fn new() -> Self {
+        Self { stream: None }
+    }
+}
+
+impl<S: NonBlockingStream> Default for NonBlockingTransport<S> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl<S: NonBlockingStream> AsRawFd for NonBlockingTransport<S> {
+    fn as_raw_fd(&self) -> RawFd {
+        self.stream.as_ref().map_or(-1, |s| s.as_raw_fd())
+    }
+}
+
+impl<S: NonBlockingStream> Transport for NonBlockingTransport<S> {
+    fn connect(&mut self, host: &str, port: u16) -> Result<()> {
+        let stream = S::open(host, port)?;
+        stream.enable_nonblocking()?;
+        self.stream = Some(stream);
+        Ok(())
+    }
+
+    fn write(&mut self, buf: &[u8]) -> Result<usize> {
+        if let Some(stream) = &mut self.stream {
+            Ok(stream.write(buf)?)
+        } else {
+            Err(Error::Transport(TransportError::SocketWriteFailure))
+        }
+    }
+
+    fn write_vectored(&mut self, bufs: &[IoSlice<'_>]) -> Result<usize> {
+        if let Some(stream) = &mut self.stream {
+            Ok(stream.write_vectored(bufs)?)
+        } else {
+            Err(Error::Transport(TransportError::SocketWriteFailure))
+        }
+    }
+
+    fn read(&mut self, buf: &mut [u8]) -> Result<usize> {
+        if let Some(stream) = &mut self.stream {
+            let bytes_read = stream.read(buf)?;
+            if bytes_read == 0 && !buf.is_empty() {
+                return Err(Error::Transport(TransportError::ConnectionClosed));
+            }
+            Ok(bytes_read)
+        } else {
+            Err(Error::Transport(TransportError::SocketReadFailure))
+        }
+    }
+
+    fn close(&mut self) -> Result<()> {
+        if let Some(stream) = self.stream.take() {
+            stream.shutdown_both()?;
+        }
+        Ok(())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::net::TcpListener;
+
+    #[test]
+    fn read_reports_would_block_instead_of_blocking() {
+        let listener = TcpListener::bind("127.0.0.1:0").unwrap();
+        let addr = listener.local_addr().unwrap();
+
+        let mut transport = NonBlockingTcpTransport::new();
+        transport.connect(&addr.ip().to_string(), addr.port()).unwrap();
+        let (mut server, _) = listener.accept().unwrap();
+
+        let mut buf = [0u8; 16];
+        assert_eq!(transport.read(&mut buf), Err(Error::Transport(TransportError::WouldBlock)));
+
+        server.write_all(b"ready").unwrap();
+        let mut n = Err(Error::Transport(TransportError::WouldBlock));
+        for _ in 0..100 {
+            n = transport.read(&mut buf);
+            if n.is_ok() { break; }
+            std::thread::sleep(std::time::Duration::from_millis(5));
+        }
+        assert_eq!(n, Ok(5));
+        assert_eq!(&buf[..5], b"ready");
+    }
+
+    #[test]
+    fn raw_fd_is_invalid_until_connected() {
+        let transport = NonBlockingUnixTransport::new();
+        assert_eq!(transport.as_raw_fd(), -1);
+    }
+}
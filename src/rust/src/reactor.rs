@@ -0,0 +1,124 @@
+use std::os::unix::io::RawFd;
+use std::time::Duration;
+
+use crate::error::{Error, Result, TransportError};
+
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct Event {
+    pub token: u64,
+    pub readable: bool,
+    pub writable: bool,
+}
+
+/// Thin wrapper around an edge-triggered epoll instance. Registered descriptors report both
+/// readiness directions; consumers must drain a descriptor until it would block.
+pub struct Reactor {
+    epoll_fd: RawFd,
+    events: Vec<libc::epoll_event>,
+}
+
+impl Reactor {
+    pub fn new(capacity: usize) -> Result<Self> {
+        let epoll_fd = unsafe { libc::epoll_create1(libc::EPOLL_CLOEXEC) };
+        if epoll_fd < 0 {
+            return Err(Error::Transport(TransportError::InitFailure));
+        }
+        Ok(Self {
+            epoll_fd,
+            events: vec![libc::epoll_event { events: 0, u64: 0 }; capacity.max(1)],
+        })
+    }
+
+    pub fn register(&mut self, fd: RawFd, token: u64) -> Result<()> {
+        let mut event = libc::epoll_event {
+            events: (libc::EPOLLIN | libc::EPOLLOUT | libc::EPOLLRDHUP | libc::EPOLLET) as u32,
+            u64: token,
+        };
+        if unsafe { libc::epoll_ctl(self.epoll_fd, libc::EPOLL_CTL_ADD, fd, &mut event) } < 0 {
+            return Err(std::io::Error::last_os_error().into());
+        }
+        Ok(())
+    }
+
+    pub fn deregister(&mut self, fd: RawFd) -> Result<()> {
+        if unsafe { libc::epoll_ctl(self.epoll_fd, libc::EPOLL_CTL_DEL, fd, std::ptr::null_mut()) } < 0 {
+            return Err(std::io::Error::last_os_error().into());
+        }
+        Ok(())
+    }
+
+    /// Waits for readiness and appends the ready events to `out`. `None` blocks indefinitely.
+    pub fn poll(&mut self, out: &mut Vec<Event>, timeout: Option<Duration>) -> Result<usize> {
+        let timeout_ms = timeout.map_or(-1, |t| t.as_millis().min(i32::MAX as u128) as i32);
+        let n = loop {
+            let n = unsafe {
+                libc::epoll_wait(self.epoll_fd, self.events.as_mut_ptr(), self.events.len() as i32, timeout_ms)
+            };
+            if n >= 0 {
+                break n as usize;
+            }
+            let err = std::io::Error::last_os_error();
+            if err.kind() != std::io::ErrorKind::Interrupted {
+                return Err(err.into());
+            }
+        };
+
+        for event in &self.events[..n] {
+            let flags = event.events as i32;
+            // Errors and hang-ups are surfaced as readiness so the next read reports them.
+            let hangup = flags & (libc::EPOLLERR | libc::EPOLLHUP | libc::EPOLLRDHUP) != 0;
+            out.push(Event {
+                token: event.u64,
+                readable: flags & libc::EPOLLIN != 0 || hangup,
+                writable: flags & libc::EPOLLOUT != 0 || hangup,
+            });
+        }
+        Ok(n)
+    }
+}
+
+impl Drop for Reactor {
+    fn drop(&mut self) {
+        unsafe { libc::close(self.epoll_fd) };
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::io::Write;
+    use std::os::unix::io::AsRawFd;
+    use std::os::unix::net::UnixStream;
+
+    #[test]
+    fn reports_readiness_with_registered_token() {
+        let (mut a, b) = UnixStream::pair().unwrap();
+        b.set_nonblocking(true).unwrap();
+
+        let mut reactor = Reactor::new(8).unwrap();
+        reactor.register(b.as_raw_fd(), 42).unwrap();
+
+        let mut events = Vec::new();
+        reactor.poll(&mut events, Some(Duration::from_millis(100))).unwrap();
+        assert_eq!(events, vec![Event { token: 42, readable: false, writable: true }]);
+
+        a.write_all(b"ping").unwrap();
+        events.clear();
+        reactor.poll(&mut events, Some(Duration::from_millis(100))).unwrap();
+        assert_eq!(events.len(), 1);
+        assert!(events[0].readable);
+    }
+
+    #[test]
+    fn poll_times_out_without_events() {
+        let (_a, b) = UnixStream::pair().unwrap();
+        let mut reactor = Reactor::new(8).unwrap();
+        reactor.register(b.as_raw_fd(), 1).unwrap();
+
+        let mut events = Vec::new();
+        reactor.poll(&mut events, Some(Duration::from_millis(100))).unwrap();
+        events.clear();
+        assert_eq!(reactor.poll(&mut events, Some(Duration::from_millis(10))).unwrap(), 0);
+        assert!(events.is_empty());
+    }
+}
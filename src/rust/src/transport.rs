@@ -1,3 +1,5 @@
+use std::io::IoSlice;
+
 use crate::error::Result;
 
 pub trait Transport {
@@ -5,7 +7,9 @@ pub trait Transport {
 
     fn write(&mut self, buf: &[u8]) -> Result<usize>;
 
+    fn write_vectored(&mut self, bufs: &[IoSlice<'_>]) -> Result<usize>;
+
     fn read(&mut self, buf: &mut [u8]) -> Result<usize>;
 
     fn close(&mut self) -> Result<()>;
-}
\ No newline at end of file
+}
@@ -1,6 +1,6 @@
 use crate::error::{Error, Result, TransportError};
 use crate::transport::Transport;
-use std::io::{Read, Write};
+use std::io::{IoSlice, Read, Write};
 use std::os::unix::net::UnixStream;
 use std::net::Shutdown;
 
@@ -38,6 +38,15 @@ impl Transport for UnixTransport {
         }
     }
 
+    fn write_vectored(&mut self, bufs: &[IoSlice<'_>]) -> Result<usize> {
+        if let Some(stream) = &mut self.stream {
+            let bytes_written = stream.write_vectored(bufs)?;
+            Ok(bytes_written)
+        } else {
+            Err(Error::Transport(TransportError::SocketWriteFailure))
+        }
+    }
+
     fn read(&mut self, buf: &mut [u8]) -> Result<usize> {
         if let Some(stream) = &mut self.stream {
             let bytes_read = stream.read(buf)?;
@@ -6,6 +6,7 @@
 
 extern "C" {
 #include <httpc/http1_protocol.h>
+#include <httpc/integrity.h>
 }
 
 namespace {
@@ -29,11 +30,19 @@ struct MockTransportState {
     bool should_fail_write = false;
     bool should_fail_read = false;
     bool should_fail_close = false;
+
+    int connect_count = 0;
+    bool stale = false;
+    bool drop_next_read = false;
+    std::vector<size_t> read_lengths;
+    size_t max_read_chunk = SIZE_MAX;
 };
 
 Error mock_transport_connect(void* context, const char* host, int port) {
     auto* state = static_cast<MockTransportState*>(context);
     state->connect_called = true;
+    state->connect_count++;
+    state->stale = false;
     state->host_received = host;
     state->port_received = port;
     if (state->should_fail_connect) {
@@ -73,13 +82,19 @@ Error mock_transport_writev(void* context, const struct iovec* iov, int iovcnt,
 Error mock_transport_read(void* context, void* buffer, size_t len, ssize_t* bytes_read) {
     auto* state = static_cast<MockTransportState*>(context);
     state->read_called = true;
+    state->read_lengths.push_back(len);
     if (state->should_fail_read) {
         *bytes_read = -1;
         return {ErrorType.TRANSPORT, TransportErrorCode.SOCKET_READ_FAILURE};
     }
+    if (state->drop_next_read) {
+        state->drop_next_read = false;
+        *bytes_read = 0;
+        return {ErrorType.TRANSPORT, TransportErrorCode.CONNECTION_CLOSED};
+    }
 
     size_t remaining = state->read_buffer.size() - state->read_pos;
-    size_t to_read = std::min(len, remaining);
+    size_t to_read = std::min({len, remaining, state->max_read_chunk});
 
     if (to_read == 0) {
         *bytes_read = 0;
@@ -92,6 +107,19 @@ Error mock_transport_read(void* context, void* buffer, size_t len, ssize_t* byte
     return {ErrorType.NONE, 0};
 }
 
+Error mock_transport_read_all(void* context, void* buffer, size_t len, ssize_t* bytes_read) {
+    auto* state = static_cast<MockTransportState*>(context);
+    const size_t max_read_chunk = state->max_read_chunk;
+    state->max_read_chunk = SIZE_MAX;
+    Error err = mock_transport_read(context, buffer, len, bytes_read);
+    state->max_read_chunk = max_read_chunk;
+    return err;
+}
+
+bool mock_transport_is_stale(void* context) {
+    return static_cast<MockTransportState*>(context)->stale;
+}
+
 Error mock_transport_close(void* context) {
     auto* state = static_cast<MockTransportState*>(context);
     state->close_called = true;
@@ -123,6 +151,8 @@ protected:
         mock_transport_interface.write = mock_transport_write;
         mock_transport_interface.read = mock_transport_read;
         mock_transport_interface.close = mock_transport_close;
+        mock_transport_interface.is_stale = mock_transport_is_stale;
+        mock_transport_interface.read_all = mock_transport_read_all;
 
         protocol = http1_protocol_new(&mock_transport_interface, &mock_syscalls, HTTP_RESPONSE_UNSAFE_ZERO_COPY, HTTP_IO_COPY_WRITE);
         ASSERT_NE(protocol, nullptr);
@@ -607,4 +637,486 @@ TEST_F(HttpProtocolTest, PerformRequestUsesVectoredWriteForPost) {
     const std::string actual(mock_transport_state.write_buffer.begin(),
                              mock_transport_state.write_buffer.end());
     ASSERT_EQ(actual, expected);
-}
\ No newline at end of file
+}
+TEST_F(HttpProtocolTest, BodyLayoutAlignsBodyAndZeroesPadding) {
+    ASSERT_EQ(http1_protocol_set_body_layout(protocol, 64, 64).type, ErrorType.NONE);
+
+    g_response_chunks = {
+        "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nHello",
+        " Body"
+    };
+    g_read_chunk_index = 0;
+    mock_transport_interface.read = mock_read_in_chunks;
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(response.body_len, 10);
+    ASSERT_EQ(std::string(response.body, response.body_len), "Hello Body");
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(response.body) % 64, 0u);
+    ASSERT_STREQ(response.headers[0].key, "Content-Length");
+    for (size_t i = 0; i < 64; ++i) {
+        ASSERT_EQ(response.body[response.body_len + i], '\0');
+    }
+}
+
+TEST_F(HttpProtocolTest, BodyLayoutAppliesWithoutContentLength) {
+    ASSERT_EQ(http1_protocol_set_body_layout(protocol, 32, 64).type, ErrorType.NONE);
+
+    const std::string mock_response_str =
+        "HTTP/1.1 200 OK\r\n"
+        "Connection: close\r\n"
+        "\r\n"
+        "Body until close";
+    mock_transport_state.read_buffer.assign(
+        mock_response_str.begin(), mock_response_str.end());
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(std::string(response.body, response.body_len), "Body until close");
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(response.body) % 64, 0u);
+    ASSERT_STREQ(response.headers[0].value, "close");
+    for (size_t i = 0; i < 32; ++i) {
+        ASSERT_EQ(response.body[response.body_len + i], '\0');
+    }
+}
+
+TEST_F(HttpProtocolTest, BodyLayoutRejectsNonPowerOfTwoAlignment) {
+    Error err = http1_protocol_set_body_layout(protocol, 0, 48);
+
+    ASSERT_EQ(err.type, ErrorType.HTTPC);
+    ASSERT_EQ(err.code, HttpClientErrorCode.INVALID_REQUEST_SYNTAX);
+}
+
+TEST_F(HttpProtocolTest, IntegrityVerifiesDigestAcrossChunks) {
+    ASSERT_EQ(http1_protocol_set_integrity(protocol, HTTP_INTEGRITY_CRC32C).type, ErrorType.NONE);
+
+    g_response_chunks = {
+        "HTTP/1.1 200 OK\r\nContent-Digest: crc32c=:+jGMoQ==:\r\nContent-Length: 12\r\n\r\nHello",
+        " Client"
+    };
+    g_read_chunk_index = 0;
+    mock_transport_interface.read = mock_read_in_chunks;
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(std::string(response.body, response.body_len), "Hello Client");
+}
+
+TEST_F(HttpProtocolTest, IntegrityVerifiesDigestWithoutContentLength) {
+    ASSERT_EQ(http1_protocol_set_integrity(protocol, HTTP_INTEGRITY_CRC32C).type, ErrorType.NONE);
+
+    const std::string mock_response_str =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Digest: crc32c=:lHzDkg==:\r\n"
+        "\r\n"
+        "Body until close";
+    mock_transport_state.read_buffer.assign(
+        mock_response_str.begin(), mock_response_str.end());
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(std::string(response.body, response.body_len), "Body until close");
+}
+
+TEST_F(HttpProtocolTest, IntegrityRejectsDigestMismatch) {
+    ASSERT_EQ(http1_protocol_set_integrity(protocol, HTTP_INTEGRITY_CRC32C).type, ErrorType.NONE);
+
+    const std::string mock_response_str =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Digest: crc32c=:+jGMoQ==:\r\n"
+        "Content-Length: 12\r\n"
+        "\r\n"
+        "Hello Clienz";
+    mock_transport_state.read_buffer.assign(
+        mock_response_str.begin(), mock_response_str.end());
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.HTTPC);
+    ASSERT_EQ(err.code, HttpClientErrorCode.INTEGRITY_FAILURE);
+}
+
+TEST_F(HttpProtocolTest, Crc32cMatchesCastagnoliCheckValue) {
+    ASSERT_EQ(httpc_crc32c_update(0, "123456789", 9), 0xE3069283u);
+    ASSERT_EQ(httpc_crc32c_update(httpc_crc32c_update(0, "1234", 4), "56789", 5), 0xE3069283u);
+    bool found = false;
+    uint32_t crc = 0;
+    ASSERT_EQ(httpc_parse_crc32c_digest("sha-256=:abc=:, crc32c=:4waSgw==:", &found, &crc).type, ErrorType.NONE);
+    ASSERT_TRUE(found);
+    ASSERT_EQ(crc, 0xE3069283u);
+}
+
+TEST_F(HttpProtocolTest, DigestMembersAreMatchedByExactKey) {
+    bool found = false;
+    uint32_t crc = 0;
+    ASSERT_EQ(httpc_parse_crc32c_digest("crc32c=:AAAAAA==:, crc32c=:4waSgw==:;note=1", &found, &crc).type, ErrorType.NONE);
+    ASSERT_TRUE(found);
+    ASSERT_EQ(crc, 0xE3069283u);
+
+    for (const char* value : {"xcrc32c=:4waSgw==:", "sha-256=:abc=:", ""}) {
+        ASSERT_EQ(httpc_parse_crc32c_digest(value, &found, &crc).type, ErrorType.NONE) << value;
+        ASSERT_FALSE(found) << value;
+    }
+}
+
+TEST_F(HttpProtocolTest, MalformedCrc32cMemberIsAnIntegrityFailure) {
+    for (const char* value : {"crc32c=:4waSgw=:", "crc32c=:4wa!gw==:", "crc32c=4waSgw==", "crc32c",
+                              "crc32c=:4waSgw==:x", "sha-256=:abc=:, crc32c=:4waSgwAA==:"}) {
+        bool found = false;
+        uint32_t crc = 0;
+        Error err = httpc_parse_crc32c_digest(value, &found, &crc);
+        ASSERT_EQ(err.type, ErrorType.HTTPC) << value;
+        ASSERT_EQ(err.code, HttpClientErrorCode.INTEGRITY_FAILURE) << value;
+    }
+}
+
+TEST_F(HttpProtocolTest, IntegrityRejectsMalformedDigest) {
+    ASSERT_EQ(http1_protocol_set_integrity(protocol, HTTP_INTEGRITY_CRC32C).type, ErrorType.NONE);
+
+    const std::string mock_response_str =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Digest: crc32c=:+jGMoQ=:\r\n"
+        "Content-Length: 12\r\n"
+        "\r\n"
+        "Hello Client";
+    mock_transport_state.read_buffer.assign(
+        mock_response_str.begin(), mock_response_str.end());
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.HTTPC);
+    ASSERT_EQ(err.code, HttpClientErrorCode.INTEGRITY_FAILURE);
+}
+
+static size_t memcpy_bytes = 0;
+
+static void* mock_memcpy_counting(void* dest, const void* src, size_t n) {
+    memcpy_bytes += n;
+    return memcpy(dest, src, n);
+}
+
+TEST_F(HttpProtocolTest, LargePostBodyIsCopiedThroughInjectedMemcpy) {
+    memcpy_bytes = 0;
+    mock_syscalls.memcpy = mock_memcpy_counting;
+
+    std::string body(256 * 1024 + 37, '\0');
+    for (size_t i = 0; i < body.size(); ++i) {
+        body[i] = static_cast<char>('a' + i % 26);
+    }
+    const std::string content_length = std::to_string(body.size());
+
+    HttpRequest request = {};
+    request.method = HTTP_POST;
+    request.path = "/upload";
+    request.body = body.c_str();
+    request.headers[0] = {"Content-Length", content_length.c_str()};
+    request.num_headers = 1;
+
+    HttpResponse response = {};
+    protocol->perform_request(protocol->context, &request, &response);
+    ASSERT_GE(memcpy_bytes, body.size());
+
+    const std::string expected = "POST /upload HTTP/1.1\r\n"
+                                 "Content-Length: " + content_length + "\r\n"
+                                 "\r\n" + body;
+    const std::string actual(mock_transport_state.write_buffer.begin(),
+                             mock_transport_state.write_buffer.end());
+    ASSERT_EQ(actual, expected);
+}
+
+TEST_F(HttpProtocolTest, SpillMapsLargeBodyOutsideReceiveBuffer) {
+    ASSERT_EQ(http1_protocol_set_spill(protocol, 4096, nullptr).type, ErrorType.NONE);
+
+    std::string body(100 * 1024, '\0');
+    for (size_t i = 0; i < body.size(); ++i) {
+        body[i] = static_cast<char>('a' + i % 26);
+    }
+    const std::string mock_response_str =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        "\r\n" + body;
+    mock_transport_state.read_buffer.assign(
+        mock_response_str.begin(), mock_response_str.end());
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(response.content_length, body.size());
+    ASSERT_EQ(std::string(response.body, response.body_len), body);
+    ASSERT_EQ(response.body[response.body_len], '\0');
+    ASSERT_EQ(response.body, protocol_impl->spill_mapping);
+    ASSERT_STREQ(response.headers[0].key, "Content-Length");
+}
+
+TEST_F(HttpProtocolTest, SpillHandlesBodyUntilCloseWithIntegrity) {
+    ASSERT_EQ(http1_protocol_set_spill(protocol, 8, nullptr).type, ErrorType.NONE);
+    ASSERT_EQ(http1_protocol_set_integrity(protocol, HTTP_INTEGRITY_CRC32C).type, ErrorType.NONE);
+
+    g_response_chunks = {
+        "HTTP/1.1 200 OK\r\nContent-Digest: crc32c=:lHzDkg==:\r\n\r\nBody",
+        " until",
+        " close"
+    };
+    g_read_chunk_index = 0;
+    mock_transport_interface.read = mock_read_in_chunks;
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(std::string(response.body, response.body_len), "Body until close");
+    ASSERT_EQ(response.body, protocol_impl->spill_mapping);
+}
+
+TEST_F(HttpProtocolTest, SpillKeepsSmallBodiesInMemory) {
+    ASSERT_EQ(http1_protocol_set_spill(protocol, 4096, nullptr).type, ErrorType.NONE);
+
+    const std::string mock_response_str =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 5\r\n"
+        "\r\n"
+        "Hello";
+    mock_transport_state.read_buffer.assign(
+        mock_response_str.begin(), mock_response_str.end());
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(std::string(response.body, response.body_len), "Hello");
+    ASSERT_EQ(protocol_impl->spill_mapping, nullptr);
+}
+
+TEST_F(HttpProtocolTest, SpillFailsWhenFileCannotBeCreated) {
+    ASSERT_EQ(http1_protocol_set_spill(protocol, 4, nullptr).type, ErrorType.NONE);
+    mock_syscalls.memfd_create = [](const char*, unsigned int) -> int { return -1; };
+
+    const std::string mock_response_str =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 10\r\n"
+        "\r\n"
+        "0123456789";
+    mock_transport_state.read_buffer.assign(
+        mock_response_str.begin(), mock_response_str.end());
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.HTTPC);
+    ASSERT_EQ(err.code, HttpClientErrorCode.SPILL_FAILURE);
+}
+
+TEST_F(HttpProtocolTest, MemoryPolicyCanBeSwitchedAfterCreation) {
+    ASSERT_EQ(http1_protocol_set_memory_policy(protocol, HTTP_RESPONSE_SAFE_OWNING).type, ErrorType.NONE);
+    ASSERT_EQ(http1_protocol_set_memory_policy(nullptr, HTTP_RESPONSE_SAFE_OWNING).code,
+              HttpClientErrorCode.INVALID_REQUEST_SYNTAX);
+
+    const std::string mock_response_str =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 4\r\n"
+        "\r\n"
+        "body";
+    mock_transport_state.read_buffer.assign(
+        mock_response_str.begin(), mock_response_str.end());
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_STREQ(response.body, "body");
+    ASSERT_NE(response._owned_buffer, nullptr);
+    ASSERT_NE(response.body, protocol_impl->buffer.data);
+
+    http_response_destroy(&response);
+}
+
+TEST_F(HttpProtocolTest, ReconnectCheckReplacesStaleConnectionBeforeUse) {
+    ASSERT_EQ(http1_protocol_set_reconnect(nullptr, true, false).code, HttpClientErrorCode.INVALID_REQUEST_SYNTAX);
+    ASSERT_EQ(http1_protocol_set_reconnect(protocol, true, false).type, ErrorType.NONE);
+    ASSERT_EQ(protocol->connect(protocol->context, "localhost", 8080).type, ErrorType.NONE);
+
+    const std::string mock_response_str =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 5\r\n"
+        "\r\n"
+        "Hello";
+    mock_transport_state.read_buffer.assign(
+        mock_response_str.begin(), mock_response_str.end());
+    mock_transport_state.stale = true;
+
+    HttpRequest request = {};
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_TRUE(mock_transport_state.close_called);
+    ASSERT_EQ(mock_transport_state.connect_count, 2);
+    ASSERT_EQ(mock_transport_state.host_received, "localhost");
+    ASSERT_EQ(mock_transport_state.port_received, 8080);
+    ASSERT_EQ(protocol_impl->reconnect_count, 1u);
+    ASSERT_EQ(std::string(response.body, response.body_len), "Hello");
+}
+
+TEST_F(HttpProtocolTest, ReconnectRetriesDroppedGetButNotPost) {
+    ASSERT_EQ(http1_protocol_set_reconnect(protocol, false, true).type, ErrorType.NONE);
+    ASSERT_EQ(protocol->connect(protocol->context, "localhost", 8080).type, ErrorType.NONE);
+
+    const std::string mock_response_str =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 5\r\n"
+        "\r\n"
+        "Hello";
+    mock_transport_state.read_buffer.assign(
+        mock_response_str.begin(), mock_response_str.end());
+    mock_transport_state.drop_next_read = true;
+
+    HttpRequest request = {};
+    request.method = HTTP_GET;
+    request.path = "/";
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(mock_transport_state.connect_count, 2);
+    ASSERT_EQ(protocol_impl->reconnect_count, 1u);
+    ASSERT_EQ(std::string(response.body, response.body_len), "Hello");
+    ASSERT_EQ(std::string(mock_transport_state.write_buffer.begin(), mock_transport_state.write_buffer.end()),
+              "GET / HTTP/1.1\r\n\r\nGET / HTTP/1.1\r\n\r\n");
+
+    mock_transport_state.drop_next_read = true;
+    HttpRequest post = {};
+    post.method = HTTP_POST;
+    post.path = "/";
+    post.body = "x";
+    post.headers[0] = {"Content-Length", "1"};
+    post.num_headers = 1;
+    response = {};
+    protocol->perform_request(protocol->context, &post, &response);
+
+    ASSERT_EQ(mock_transport_state.connect_count, 2);
+    ASSERT_EQ(protocol_impl->reconnect_count, 1u);
+}
+
+TEST_F(HttpProtocolTest, ConnectionClosedBeforeAnyResponseByteIsAnError) {
+    ASSERT_EQ(protocol->connect(protocol->context, "localhost", 8080).type, ErrorType.NONE);
+
+    HttpRequest request = {};
+    request.method = HTTP_GET;
+    request.path = "/";
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.TRANSPORT);
+    ASSERT_EQ(err.code, TransportErrorCode.CONNECTION_CLOSED);
+    ASSERT_EQ(mock_transport_state.connect_count, 1);
+}
+
+TEST_F(HttpProtocolTest, ReconnectRetriesADroppedGetOnlyOnce) {
+    ASSERT_EQ(http1_protocol_set_reconnect(protocol, false, true).type, ErrorType.NONE);
+    ASSERT_EQ(protocol->connect(protocol->context, "localhost", 8080).type, ErrorType.NONE);
+
+    // Every connection closes without answering.
+    HttpRequest request = {};
+    request.method = HTTP_GET;
+    request.path = "/";
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.TRANSPORT);
+    ASSERT_EQ(err.code, TransportErrorCode.CONNECTION_CLOSED);
+    ASSERT_EQ(mock_transport_state.connect_count, 2);
+    ASSERT_EQ(protocol_impl->reconnect_count, 1u);
+}
+
+TEST_F(HttpProtocolTest, ReconnectDoesNotRetryAfterAProtocolError) {
+    ASSERT_EQ(http1_protocol_set_reconnect(protocol, false, true).type, ErrorType.NONE);
+    ASSERT_EQ(protocol->connect(protocol->context, "localhost", 8080).type, ErrorType.NONE);
+    mock_syscalls.realloc = mock_realloc_fails;
+
+    HttpRequest request = {};
+    request.method = HTTP_GET;
+    request.path = "/";
+    HttpResponse response = {};
+    Error err = protocol->perform_request(protocol->context, &request, &response);
+
+    ASSERT_EQ(err.type, ErrorType.HTTPC);
+    ASSERT_EQ(mock_transport_state.connect_count, 1);
+    ASSERT_EQ(protocol_impl->reconnect_count, 0u);
+}
+
+TEST_F(HttpProtocolTest, SizePredictorPresizesSafeResponsesFromRecentSizes) {
+    ASSERT_EQ(http1_protocol_set_memory_policy(protocol, HTTP_RESPONSE_SAFE_OWNING).type, ErrorType.NONE);
+    ASSERT_EQ(protocol->connect(protocol->context, "localhost", 8080).type, ErrorType.NONE);
+
+    const std::string body(5000, 'x');
+    const std::string mock_response_str = "HTTP/1.1 200 OK\r\nContent-Length: 5000\r\n\r\n" + body;
+
+    HttpRequest request = {};
+    for (int i = 0; i < 3; ++i) {
+        mock_transport_state.read_buffer.assign(mock_response_str.begin(), mock_response_str.end());
+        mock_transport_state.read_pos = 0;
+        mock_transport_state.read_lengths.clear();
+
+        HttpResponse response = {};
+        ASSERT_EQ(protocol->perform_request(protocol->context, &request, &response).type, ErrorType.NONE);
+        ASSERT_EQ(std::string(response.body, response.body_len), body);
+        http_response_destroy(&response);
+    }
+
+    // Once a size has been seen, a response arrives in a single read into a buffer sized for it.
+    ASSERT_EQ(mock_transport_state.read_lengths.size(), 1u);
+    ASSERT_GE(mock_transport_state.read_lengths[0], mock_response_str.size());
+    ASSERT_EQ(protocol_impl->size_predictor.predictions, 2u);
+    ASSERT_EQ(protocol_impl->size_predictor.hits, 2u);
+
+    // A different endpoint starts over but keeps the counters.
+    ASSERT_EQ(protocol->connect(protocol->context, "example.com", 8080).type, ErrorType.NONE);
+    ASSERT_EQ(protocol_impl->size_predictor.samples, 0u);
+    ASSERT_EQ(protocol_impl->size_predictor.predictions, 2u);
+}
+
+TEST_F(HttpProtocolTest, WaitAllReceivesRestOfBodyInOneRead) {
+    const std::string body(5000, 'x');
+    const std::string mock_response_str = "HTTP/1.1 200 OK\r\nContent-Length: 5000\r\n\r\n" + body;
+    HttpRequest request = {};
+
+    // The transport hands out at most 100 bytes per plain read, like a stream of small segments.
+    mock_transport_state.max_read_chunk = 100;
+    mock_transport_state.read_buffer.assign(mock_response_str.begin(), mock_response_str.end());
+    HttpResponse response = {};
+    ASSERT_EQ(protocol->perform_request(protocol->context, &request, &response).type, ErrorType.NONE);
+    ASSERT_EQ(std::string(response.body, response.body_len), body);
+    ASSERT_EQ(protocol_impl->read_calls, 51u);
+
+    ASSERT_EQ(http1_protocol_set_receive_strategy(nullptr, HTTP_RECEIVE_WAIT_ALL).code, HttpClientErrorCode.INVALID_REQUEST_SYNTAX);
+    ASSERT_EQ(http1_protocol_set_receive_strategy(protocol, HTTP_RECEIVE_WAIT_ALL).type, ErrorType.NONE);
+    mock_transport_state.read_pos = 0;
+    mock_transport_state.read_lengths.clear();
+    response = {};
+    ASSERT_EQ(protocol->perform_request(protocol->context, &request, &response).type, ErrorType.NONE);
+    ASSERT_EQ(std::string(response.body, response.body_len), body);
+    ASSERT_EQ(protocol_impl->read_calls, 2u);
+    ASSERT_EQ(mock_transport_state.read_lengths.back(), mock_response_str.size() - 100);
+}
@@ -19,6 +19,7 @@
 
 extern "C" {
 #include <httpc/httpc.h>
+#include <httpc/http1_protocol.h>
 }
 
 
@@ -309,6 +310,49 @@ TEST_F(HttpClientIntegrationTest, TcpClientGetRequestSucceeds) {
     http_client_destroy(&client);
 }
 
+TEST_F(HttpClientIntegrationTest, TcpClientWarmUpPresizesBufferAndRunsRequests) {
+    int served = 0;
+    StartTcpServer([this, &served](int client_fd) {
+        std::vector<char> buffer(4096, 0);
+        while (read(client_fd, buffer.data(), buffer.size() - 1) > 0) {
+            served++;
+            write(client_fd, canned_response.c_str(), canned_response.length());
+        }
+    });
+
+    HttpClient client = {};
+    Error err = http_client_init(&client, HttpTransportType.TCP, HttpProtocolType.HTTP1, HTTP_RESPONSE_SAFE_OWNING, HTTP_IO_COPY_WRITE);
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(http_client_warm_up(nullptr, "127.0.0.1", tcp_port, nullptr).code, HttpClientErrorCode.INVALID_REQUEST_SYNTAX);
+
+    HttpRequest warm_request = {};
+    warm_request.path = "/warm";
+    HttpWarmUpOptions options = {};
+    options.buffer_size = 256 * 1024;
+    options.request = &warm_request;
+    options.num_requests = 2;
+    err = http_client_warm_up(&client, "127.0.0.1", tcp_port, &options);
+    ASSERT_EQ(err.type, ErrorType.NONE);
+
+    const auto* protocol = (const Http1Protocol*)client.protocol->context;
+    ASSERT_GE(protocol->buffer.capacity, 256u * 1024);
+    const char* buffer_after_warm_up = protocol->buffer.data;
+
+    HttpRequest request = {};
+    request.path = "/real";
+    HttpResponse response = {};
+    err = client.get(&client, &request, &response);
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(std::string(response.body, response.body_len), "success");
+    ASSERT_EQ(protocol->buffer.data, buffer_after_warm_up);
+    http_response_destroy(&response);
+
+    client.disconnect(&client);
+    http_client_destroy(&client);
+    StopServer();
+    ASSERT_EQ(served, 3);
+}
+
 TEST_F(HttpClientIntegrationTest, TcpClientPostRequestSucceeds) {
     StartTcpServer();
 
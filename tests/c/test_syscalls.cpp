@@ -4,6 +4,8 @@ extern "C" {
 #include <httpc/syscalls.h>
 }
 
+#include <sys/mman.h>
+
 #include <gtest/gtest.h>
 
 extern "C" {
@@ -23,6 +25,14 @@ TEST(Syscalls, DefaultInitialization) {
     ASSERT_EQ(syscalls.writev, writev);
     ASSERT_EQ(syscalls.read, read);
     ASSERT_EQ(syscalls.close, close);
+    ASSERT_EQ(syscalls.poll, poll);
+    ASSERT_EQ(syscalls.recv, recv);
+
+    ASSERT_NE(syscalls.open, nullptr);
+    ASSERT_EQ(syscalls.memfd_create, memfd_create);
+    ASSERT_EQ(syscalls.ftruncate, ftruncate);
+    ASSERT_EQ(syscalls.mmap, mmap);
+    ASSERT_EQ(syscalls.munmap, munmap);
 
     ASSERT_EQ(syscalls.malloc, malloc);
     ASSERT_EQ(syscalls.realloc, realloc);
@@ -35,6 +45,7 @@ TEST(Syscalls, DefaultInitialization) {
     ASSERT_NE(syscalls.strstr, nullptr);
 
     ASSERT_EQ(syscalls.strlen, strlen);
+    ASSERT_EQ(syscalls.memmem, memmem);
     ASSERT_EQ(syscalls.strncpy, strncpy);
     ASSERT_EQ(syscalls.strtok_r, strtok_r);
     ASSERT_EQ(syscalls.snprintf, snprintf);
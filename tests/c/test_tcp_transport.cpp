@@ -286,6 +286,48 @@ TEST_F(TcpTransportTest, ReadReturnsConnectionClosedOnPeerShutdown) {
     close(svr_sock);
 }
 
+TEST_F(TcpTransportTest, ReadAllWaitsForEveryRequestedByte) {
+    int svr_sock = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_NE(svr_sock, -1);
+
+    struct sockaddr_in serv_addr;
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    serv_addr.sin_port = 0;
+    ASSERT_EQ(bind(svr_sock, (struct sockaddr*)&serv_addr, sizeof(serv_addr)), 0);
+
+    socklen_t len = sizeof(serv_addr);
+    ASSERT_EQ(getsockname(svr_sock, (struct sockaddr*)&serv_addr, &len), 0);
+    int port = ntohs(serv_addr.sin_port);
+    ASSERT_EQ(listen(svr_sock, 1), 0);
+
+    std::thread server_thread([svr_sock]() {
+        int client_fd = accept(svr_sock, nullptr, nullptr);
+        if (client_fd >= 0) {
+            write(client_fd, "hello ", 6);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            write(client_fd, "world", 5);
+            close(client_fd);
+        }
+    });
+
+    ASSERT_NE(transport->read_all, nullptr);
+    Error connect_err = transport->connect(transport->context, "127.0.0.1", port);
+    ASSERT_EQ(connect_err.type, ErrorType.NONE);
+
+    char buffer[32] = {0};
+    ssize_t bytes_read = 0;
+    Error read_err = transport->read_all(transport->context, buffer, 11, &bytes_read);
+
+    ASSERT_EQ(read_err.type, ErrorType.NONE);
+    ASSERT_EQ(bytes_read, 11);
+    ASSERT_STREQ(buffer, "hello world");
+
+    server_thread.join();
+    close(svr_sock);
+}
+
 static ssize_t mock_read_fails(int, void*, size_t) {
     return -1;
 }
@@ -457,6 +499,38 @@ TEST_F(TcpTransportTest, ConnectSetsTcpNoDelay) {
     ASSERT_TRUE(setsockopt_called_with_nodelay);
 }
 
+static int fast_open_requests = 0;
+static int mock_setsockopt_rejects_fast_open(int, int level, int optname, const void*, socklen_t) {
+    if (level == IPPROTO_TCP && optname == TCP_FASTOPEN_CONNECT) {
+        fast_open_requests++;
+        errno = ENOPROTOOPT;
+        return -1;
+    }
+    return 0;
+}
+
+TEST_F(TcpTransportTest, FastOpenIsOptInAndFallsBackWithoutKernelSupport) {
+    fast_open_requests = 0;
+    mock_syscalls.setsockopt = mock_setsockopt_rejects_fast_open;
+    ReinitializeWithMocks();
+
+    ASSERT_EQ(transport->connect(transport->context, "127.0.0.1", listener_port).type, ErrorType.NONE);
+    ASSERT_EQ(fast_open_requests, 0);
+    transport->close(transport->context);
+
+    ASSERT_EQ(tcp_transport_set_fast_open(nullptr, true).code, TransportErrorCode.INIT_FAILURE);
+    ASSERT_EQ(tcp_transport_set_fast_open(transport, true).type, ErrorType.NONE);
+    Error err = transport->connect(transport->context, "127.0.0.1", listener_port);
+
+    ASSERT_EQ(err.type, ErrorType.NONE);
+    ASSERT_EQ(fast_open_requests, 1);
+
+    char buffer[64] = {0};
+    ssize_t bytes_read = 0;
+    ASSERT_EQ(transport->read(transport->context, buffer, sizeof(buffer) - 1, &bytes_read).type, ErrorType.NONE);
+    ASSERT_STREQ(buffer, test_message);
+}
+
 static ssize_t mock_write_fails_with_epipe(int, const void*, size_t) {
     errno = EPIPE; // Set the specific "Broken Pipe" error
     return -1;
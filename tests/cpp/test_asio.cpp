@@ -0,0 +1,295 @@
+#include <gtest/gtest.h>
+#include <httpcpp/asio_connection.hpp>
+#include <httpcpp/asio_transport.hpp>
+#include <httpcpp/httpcpp.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_future.hpp>
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+
+namespace {
+
+    // Answers every request on every connection, each on its own thread, with whatever the
+    // responder returns for the request's path and body. Closes the connection after a
+    // response that has no Content-Length.
+    class ScriptedServer {
+    public:
+        using Responder = std::function<std::string(const std::string& path, const std::string& body)>;
+
+        explicit ScriptedServer(Responder responder) : responder_(std::move(responder)) {
+            listener_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            bind(listener_fd_, (struct sockaddr*)&addr, sizeof(addr));
+            listen(listener_fd_, 16);
+            socklen_t len = sizeof(addr);
+            getsockname(listener_fd_, (struct sockaddr*)&addr, &len);
+            port_ = ntohs(addr.sin_port);
+            accept_thread_ = std::thread([this] { AcceptLoop(); });
+        }
+
+        ~ScriptedServer() {
+            shutdown(listener_fd_, SHUT_RDWR);
+            accept_thread_.join();
+            {
+                std::lock_guard lock(mutex_);
+                for (int fd : client_fds_) {
+                    shutdown(fd, SHUT_RDWR);
+                }
+            }
+            for (auto& thread : session_threads_) {
+                thread.join();
+            }
+            for (int fd : client_fds_) {
+                close(fd);
+            }
+            close(listener_fd_);
+        }
+
+        uint16_t port() const { return port_; }
+
+        size_t connections() {
+            std::lock_guard lock(mutex_);
+            return client_fds_.size();
+        }
+
+    private:
+        void AcceptLoop() {
+            while (true) {
+                int fd = accept(listener_fd_, nullptr, nullptr);
+                if (fd < 0) return;
+                std::lock_guard lock(mutex_);
+                client_fds_.push_back(fd);
+                session_threads_.emplace_back([this, fd] { Serve(fd); });
+            }
+        }
+
+        void Serve(int fd) {
+            std::string pending;
+            std::vector<char> buffer(64 * 1024);
+            while (true) {
+                const size_t head_end = pending.find("\r\n\r\n");
+                if (head_end == std::string::npos) {
+                    ssize_t bytes_read = read(fd, buffer.data(), buffer.size());
+                    if (bytes_read <= 0) return;
+                    pending.append(buffer.data(), bytes_read);
+                    continue;
+                }
+                size_t content_length = 0;
+                if (size_t cl = pending.find("Content-Length: "); cl != std::string::npos && cl < head_end) {
+                    content_length = std::stoul(pending.substr(cl + 16));
+                }
+                while (pending.size() < head_end + 4 + content_length) {
+                    ssize_t bytes_read = read(fd, buffer.data(), buffer.size());
+                    if (bytes_read <= 0) return;
+                    pending.append(buffer.data(), bytes_read);
+                }
+                const size_t path_start = pending.find(' ') + 1;
+                const std::string path = pending.substr(path_start, pending.find(' ', path_start) - path_start);
+                const std::string body = pending.substr(head_end + 4, content_length);
+                pending.erase(0, head_end + 4 + content_length);
+
+                const std::string response = responder_(path, body);
+                if (write(fd, response.data(), response.size()) < 0) return;
+                if (response.find("Content-Length:") == std::string::npos) {
+                    shutdown(fd, SHUT_WR);
+                    return;
+                }
+            }
+        }
+
+        Responder responder_;
+        int listener_fd_ = -1;
+        uint16_t port_ = 0;
+        std::thread accept_thread_;
+        std::mutex mutex_;
+        std::vector<int> client_fds_;
+        std::vector<std::thread> session_threads_;
+    };
+
+    auto Ok(const std::string& body) -> std::string {
+        return "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+    }
+
+    auto BodyOf(const httpcpp::SafeHttpResponse& response) -> std::string {
+        return {reinterpret_cast<const char*>(response.body.data()), response.body.size()};
+    }
+
+} // namespace
+
+TEST(AsioTransportTest, HttpClientRunsOverAdoptedSocket) {
+    ScriptedServer server([](const std::string& path, const std::string&) { return Ok("you asked for " + path); });
+    asio::io_context io_context;
+    tcp::socket socket(io_context);
+    socket.connect({asio::ip::make_address("127.0.0.1"), server.port()});
+
+    httpcpp::HttpClient<httpcpp::Http1Protocol<httpcpp::AsioTransport<tcp::socket>>> client;
+    client.protocol().transport().adopt(std::move(socket));
+
+    httpcpp::HttpRequest request{};
+    request.path = "/adopted";
+    auto response = client.get_safe(request);
+    ASSERT_TRUE(response.has_value());
+    ASSERT_EQ(response->status_code, 200);
+    ASSERT_EQ(BodyOf(*response), "you asked for /adopted");
+}
+
+TEST(AsioTransportTest, ConnectNeedsAnAdoptedSocket) {
+    ScriptedServer server([](const std::string&, const std::string&) { return Ok("ok"); });
+    httpcpp::AsioTransport<tcp::socket> transport;
+    auto refused = transport.connect("127.0.0.1", server.port());
+    ASSERT_FALSE(refused.has_value());
+    ASSERT_EQ(refused.error(), httpcpp::TransportError::InitFailure);
+
+    asio::io_context io_context;
+    transport.adopt(tcp::socket(io_context));
+    ASSERT_TRUE(transport.connect("127.0.0.1", server.port()).has_value());
+    ASSERT_NE(transport.native_handle(), -1);
+    ASSERT_TRUE(transport.close().has_value());
+}
+
+TEST(AsioHttpConnectionTest, ConnectionsShareOneEventLoopThread) {
+    ScriptedServer server([](const std::string& path, const std::string&) { return Ok(path); });
+    asio::io_context io_context;
+
+    constexpr int CONNECTIONS = 4;
+    constexpr int REQUESTS = 3;
+    std::vector<std::unique_ptr<httpcpp::AsioHttpConnection<tcp::socket>>> connections;
+    std::vector<std::string> paths;
+    std::vector<std::vector<std::string>> received(CONNECTIONS);
+    for (int c = 0; c < CONNECTIONS; ++c) {
+        tcp::socket socket(io_context);
+        socket.connect({asio::ip::make_address("127.0.0.1"), server.port()});
+        connections.push_back(std::make_unique<httpcpp::AsioHttpConnection<tcp::socket>>(std::move(socket)));
+        for (int r = 0; r < REQUESTS; ++r) {
+            paths.push_back("/c" + std::to_string(c) + "/r" + std::to_string(r));
+        }
+    }
+
+    // Each connection issues its next request from the completion of the previous one.
+    std::function<void(int, int)> issue = [&](int c, int r) {
+        httpcpp::HttpRequest request{};
+        request.path = paths[c * REQUESTS + r];
+        connections[c]->async_request(request, [&, c, r](httpcpp::AsioHttpConnection<tcp::socket>::Result result) {
+            received[c].push_back(result ? BodyOf(*result) : "error");
+            if (r + 1 < REQUESTS) {
+                issue(c, r + 1);
+            }
+        });
+    };
+    for (int c = 0; c < CONNECTIONS; ++c) {
+        issue(c, 0);
+    }
+    io_context.run();
+
+    for (int c = 0; c < CONNECTIONS; ++c) {
+        ASSERT_EQ(received[c].size(), static_cast<size_t>(REQUESTS));
+        for (int r = 0; r < REQUESTS; ++r) {
+            ASSERT_EQ(received[c][r], paths[c * REQUESTS + r]);
+        }
+    }
+    ASSERT_EQ(server.connections(), static_cast<size_t>(CONNECTIONS));
+}
+
+TEST(AsioHttpConnectionTest, PostsBodyAndReadsResponseUntilClose) {
+    ScriptedServer server([](const std::string&, const std::string& body) {
+        return "HTTP/1.1 201 Created\r\nX-Echo: yes\r\n\r\n" + body;
+    });
+    asio::io_context io_context;
+    tcp::socket socket(io_context);
+    socket.connect({asio::ip::make_address("127.0.0.1"), server.port()});
+    httpcpp::AsioHttpConnection<tcp::socket> connection(std::move(socket));
+
+    const std::string body(100000, 'b');
+    const std::string content_length = std::to_string(body.size());
+    httpcpp::HttpRequest request{};
+    request.method = httpcpp::HttpMethod::Post;
+    request.path = "/echo";
+    request.body = std::as_bytes(std::span(body));
+    request.headers = {{"Content-Length", content_length}};
+
+    auto future = connection.async_request(request, asio::use_future);
+    io_context.run();
+    auto response = future.get();
+
+    ASSERT_TRUE(response.has_value());
+    ASSERT_EQ(response->status_code, 201);
+    ASSERT_EQ(response->status_message, "Created");
+    ASSERT_FALSE(response->content_length.has_value());
+    ASSERT_EQ(response->headers.size(), 1u);
+    ASSERT_EQ(response->headers[0].first, "X-Echo");
+    ASSERT_EQ(response->headers[0].second, "yes");
+    ASSERT_EQ(BodyOf(*response), body);
+    ASSERT_FALSE(connection.socket().is_open());
+}
+
+TEST(AsioHttpConnectionTest, AppliesTheProtocolsIntegrityPolicy) {
+    ScriptedServer server([](const std::string& path, const std::string&) {
+        const std::string body = path == "/intact" ? "Hello Client" : "Hello Clienz";
+        return "HTTP/1.1 200 OK\r\nContent-Digest: crc32c=:+jGMoQ==:\r\nContent-Length: 12\r\n\r\n" + body;
+    });
+    asio::io_context io_context;
+    tcp::socket socket(io_context);
+    socket.connect({asio::ip::make_address("127.0.0.1"), server.port()});
+    using Protocol = httpcpp::Http1Protocol<httpcpp::AsioTransport<tcp::socket>, httpcpp::HeadersPolicy::Full,
+                                            httpcpp::StatusPolicy::Full, httpcpp::ValidationPolicy::Lenient,
+                                            httpcpp::IntegrityPolicy::Crc32c>;
+    httpcpp::AsioHttpConnection<tcp::socket, Protocol> connection(std::move(socket));
+
+    httpcpp::HttpRequest request{};
+    request.path = "/intact";
+    auto intact = connection.async_request(request, asio::use_future);
+    io_context.run();
+    auto response = intact.get();
+    ASSERT_TRUE(response.has_value());
+    ASSERT_EQ(BodyOf(*response), "Hello Client");
+
+    request.path = "/corrupt";
+    auto corrupt = connection.async_request(request, asio::use_future);
+    io_context.restart();
+    io_context.run();
+    auto rejected = corrupt.get();
+    ASSERT_FALSE(rejected.has_value());
+    auto* error = std::get_if<httpcpp::HttpClientError>(&rejected.error());
+    ASSERT_NE(error, nullptr);
+    ASSERT_EQ(*error, httpcpp::HttpClientError::IntegrityFailure);
+    ASSERT_FALSE(connection.socket().is_open());
+}
+
+TEST(AsioHttpConnectionTest, SpillsLargeBodiesPerTheProtocolsPolicy) {
+    std::string body(300000, '\0');
+    for (size_t i = 0; i < body.size(); ++i) {
+        body[i] = static_cast<char>('a' + i % 26);
+    }
+    ScriptedServer server([&body](const std::string&, const std::string&) { return Ok(body); });
+    asio::io_context io_context;
+    tcp::socket socket(io_context);
+    socket.connect({asio::ip::make_address("127.0.0.1"), server.port()});
+    httpcpp::AsioHttpConnection<tcp::socket> connection(std::move(socket));
+    connection.protocol().set_spill_policy({.threshold = 64 * 1024});
+
+    httpcpp::HttpRequest request{};
+    request.path = "/large";
+    auto future = connection.async_request(request, asio::use_future);
+    io_context.run();
+    auto response = future.get();
+
+    ASSERT_TRUE(response.has_value());
+    ASSERT_EQ(response->content_length, body.size());
+    ASSERT_EQ(BodyOf(*response), body);
+    ASSERT_TRUE(connection.socket().is_open());
+}
@@ -2,6 +2,8 @@
 #include <sys/un.h>
 #include <netinet/in.h>
 #include <unistd.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
 
 #include <thread>
 #include <atomic>
@@ -14,6 +16,7 @@
 #include <httpcpp/http1_protocol.hpp>
 #include <httpcpp/tcp_transport.hpp>
 #include <httpcpp/unix_transport.hpp>
+#include <httpcpp/numa.hpp>
 
 using TransportTypes = ::testing::Types<httpcpp::TcpTransport, httpcpp::UnixTransport>;
 
@@ -26,8 +29,9 @@ protected:
         StopServer();
     }
 
-    void StartServer(std::function<void(int)> server_logic) {
+    void StartServer(std::function<void(int)> server_logic, int connections = 1) {
         server_logic_ = std::move(server_logic);
+        connections_ = connections;
 
         if constexpr (std::is_same_v<TransportType, httpcpp::TcpTransport>) {
             SetupTcpServer();
@@ -93,21 +97,24 @@ private:
     }
 
     void AcceptLoop() {
-        int client_fd = accept(listener_fd_, nullptr, nullptr);
-        if (client_fd < 0) return;
+        for (int i = 0; i < connections_; ++i) {
+            int client_fd = accept(listener_fd_, nullptr, nullptr);
+            if (client_fd < 0) return;
 
-        // Run the test-specific logic
-        if (server_logic_) {
-            server_logic_(client_fd);
-        }
+            // Run the test-specific logic
+            if (server_logic_) {
+                server_logic_(client_fd);
+            }
 
-        close(client_fd);
+            close(client_fd);
+        }
     }
 
     std::thread server_thread_;
     std::atomic<bool> should_stop_{false};
     int listener_fd_ = -1;
     std::function<void(int)> server_logic_;
+    int connections_ = 1;
 };
 
 TYPED_TEST_SUITE(Http1ProtocolIntegrationTest, TransportTypes);
@@ -498,3 +505,956 @@ TYPED_TEST(Http1ProtocolIntegrationTest, SafeRequestReturnsOwningDeepCopy) {
         reinterpret_cast<const void*>(this->protocol_.get_internal_buffer_ptr_for_test())
     );
 }
+
+TYPED_TEST(Http1ProtocolIntegrationTest, HeadersPolicyNoneSkipsHeadersButKeepsFraming) {
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/plain\r\n"
+        "Content-Length: 5\r\n"
+        "\r\n"
+        "Hello";
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    httpcpp::Http1Protocol<typename TestFixture::TransportType,
+                           httpcpp::HeadersPolicy::None,
+                           httpcpp::StatusPolicy::CodeOnly> protocol;
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)protocol.connect("127.0.0.1", this->port_);
+    } else {
+        (void)protocol.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = protocol.perform_request_unsafe(req);
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->status_code, 200);
+    ASSERT_TRUE(result->status_message.empty());
+    ASSERT_TRUE(result->headers.empty());
+    ASSERT_EQ(result->content_length, 5);
+    std::string body_str(reinterpret_cast<const char*>(result->body.data()), result->body.size());
+    ASSERT_EQ(body_str, "Hello");
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, HeadersPolicyFramingOnlyKeepsFramingHeaders) {
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/plain\r\n"
+        "X-Request-ID: abc-123\r\n"
+        "content-length: 5\r\n"
+        "\r\n"
+        "Hello";
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    httpcpp::Http1Protocol<typename TestFixture::TransportType, httpcpp::HeadersPolicy::FramingOnly> protocol;
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)protocol.connect("127.0.0.1", this->port_);
+    } else {
+        (void)protocol.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = protocol.perform_request_unsafe(req);
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->status_message, "OK");
+    ASSERT_EQ(result->headers.size(), 1);
+    ASSERT_EQ(result->headers[0].first, "content-length");
+    ASSERT_EQ(result->headers[0].second, "5");
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, StrictValidationRejectsMalformedContentLength) {
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 5abc\r\n"
+        "\r\n"
+        "Hello";
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    httpcpp::Http1Protocol<typename TestFixture::TransportType,
+                           httpcpp::HeadersPolicy::Full,
+                           httpcpp::StatusPolicy::Full,
+                           httpcpp::ValidationPolicy::Strict> protocol;
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)protocol.connect("127.0.0.1", this->port_);
+    } else {
+        (void)protocol.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = protocol.perform_request_unsafe(req);
+
+    ASSERT_FALSE(result.has_value());
+    auto* err_ptr = std::get_if<httpcpp::HttpClientError>(&result.error());
+    ASSERT_NE(err_ptr, nullptr);
+    ASSERT_EQ(*err_ptr, httpcpp::HttpClientError::HttpParseFailure);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, StrictValidationRejectsHeaderWithoutColon) {
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 5\r\n"
+        "NotAHeaderLine\r\n"
+        "\r\n"
+        "Hello";
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    httpcpp::Http1Protocol<typename TestFixture::TransportType,
+                           httpcpp::HeadersPolicy::Full,
+                           httpcpp::StatusPolicy::Full,
+                           httpcpp::ValidationPolicy::Strict> protocol;
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)protocol.connect("127.0.0.1", this->port_);
+    } else {
+        (void)protocol.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = protocol.perform_request_unsafe(req);
+
+    ASSERT_FALSE(result.has_value());
+    auto* err_ptr = std::get_if<httpcpp::HttpClientError>(&result.error());
+    ASSERT_NE(err_ptr, nullptr);
+    ASSERT_EQ(*err_ptr, httpcpp::HttpClientError::HttpParseFailure);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, BodyLayoutAlignsBodyAndZeroesPadding) {
+    const std::string large_body(3000, 'b');
+
+    std::ostringstream oss;
+    oss << "HTTP/1.1 200 OK\r\n"
+        << "Content-Length: " << large_body.size() << "\r\n"
+        << "\r\n"
+        << large_body;
+    const std::string canned_response = oss.str();
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    ASSERT_TRUE(this->protocol_.set_body_layout({.padding = 64, .alignment = 64}).has_value());
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)this->protocol_.connect("127.0.0.1", this->port_);
+    } else {
+        (void)this->protocol_.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = this->protocol_.perform_request_unsafe(req);
+
+    ASSERT_TRUE(result.has_value());
+    const auto& res = *result;
+    std::string body_str(reinterpret_cast<const char*>(res.body.data()), res.body.size());
+    ASSERT_EQ(body_str, large_body);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(res.body.data()) % 64, 0u);
+    for (size_t i = 0; i < 64; ++i) {
+        ASSERT_EQ(res.body.data()[res.body.size() + i], std::byte{0});
+    }
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, BodyLayoutAppliesWithoutContentLength) {
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Connection: close\r\n"
+        "\r\n"
+        "Full body.";
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    ASSERT_TRUE(this->protocol_.set_body_layout({.padding = 32, .alignment = 64}).has_value());
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)this->protocol_.connect("127.0.0.1", this->port_);
+    } else {
+        (void)this->protocol_.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = this->protocol_.perform_request_unsafe(req);
+
+    ASSERT_TRUE(result.has_value());
+    const auto& res = *result;
+    std::string body_str(reinterpret_cast<const char*>(res.body.data()), res.body.size());
+    ASSERT_EQ(body_str, "Full body.");
+    ASSERT_EQ(res.headers[0].second, "close");
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(res.body.data()) % 64, 0u);
+    for (size_t i = 0; i < 32; ++i) {
+        ASSERT_EQ(res.body.data()[res.body.size() + i], std::byte{0});
+    }
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, BodyLayoutRejectsNonPowerOfTwoAlignment) {
+    auto result = this->protocol_.set_body_layout({.padding = 0, .alignment = 48});
+
+    ASSERT_FALSE(result.has_value());
+    auto* err_ptr = std::get_if<httpcpp::HttpClientError>(&result.error());
+    ASSERT_NE(err_ptr, nullptr);
+    ASSERT_EQ(*err_ptr, httpcpp::HttpClientError::InvalidRequest);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, SizePredictorPresizesRepeatedResponses) {
+    const std::string body(5000, 'x');
+    const std::string canned_response = "HTTP/1.1 200 OK\r\nContent-Length: 5000\r\n\r\n" + body;
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        while (read(client_fd, buffer, sizeof(buffer)) > 0) {
+            write(client_fd, canned_response.c_str(), canned_response.length());
+        }
+    });
+
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        ASSERT_TRUE(this->protocol_.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(this->protocol_.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    httpcpp::HttpRequest req{};
+    for (int i = 0; i < 4; ++i) {
+        auto result = this->protocol_.perform_request_unsafe(req);
+        ASSERT_TRUE(result.has_value());
+        ASSERT_EQ(std::string(reinterpret_cast<const char*>(result->body.data()), result->body.size()), body);
+    }
+
+    // The first response has nothing to predict from; the rest fit the reserved buffer.
+    auto stats = this->protocol_.size_prediction_stats();
+    ASSERT_EQ(stats.predictions, 3u);
+    ASSERT_EQ(stats.hits, 3u);
+    (void)this->protocol_.disconnect();
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, WaitAllReceivesRestOfBodyInOneRead) {
+    const std::string body(64 * 1024, 'x');
+    const std::string head = "HTTP/1.1 200 OK\r\nContent-Length: 65536\r\n\r\n";
+
+    // The body trickles in as many separate segments after the header block.
+    this->StartServer([head, body](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, head.c_str(), head.length());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        for (size_t sent = 0; sent < body.size(); sent += 4096) {
+            write(client_fd, body.data() + sent, 4096);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    this->protocol_.set_receive_strategy(httpcpp::ReceiveStrategy::WaitAll);
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        ASSERT_TRUE(this->protocol_.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(this->protocol_.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = this->protocol_.perform_request_unsafe(req);
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->body.size(), body.size());
+    ASSERT_EQ(std::memcmp(result->body.data(), body.data(), body.size()), 0);
+    ASSERT_EQ(this->protocol_.read_calls(), 2u);
+}
+
+// Records the largest read window the protocol hands to the transport.
+class WindowRecordingTransport : public httpcpp::TcpTransport {
+public:
+    [[nodiscard]] auto read(std::span<std::byte> buffer) noexcept -> std::expected<size_t, httpcpp::TransportError> {
+        largest_window = std::max(largest_window, buffer.size());
+        return httpcpp::TcpTransport::read(buffer);
+    }
+
+    size_t largest_window = 0;
+};
+
+TEST(Http1ProtocolReadWindowTest, PredictedLargeResponseIsReadInBoundedWindows) {
+    const std::string body(1 << 20, 'p');
+    const std::string canned_response = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+
+    int listener_fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_NE(listener_fd, -1);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(bind(listener_fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+    ASSERT_EQ(listen(listener_fd, 1), 0);
+    socklen_t len = sizeof(addr);
+    ASSERT_EQ(getsockname(listener_fd, (struct sockaddr*)&addr, &len), 0);
+
+    std::thread server([&] {
+        int client_fd = accept(listener_fd, nullptr, nullptr);
+        char buffer[1024];
+        while (read(client_fd, buffer, sizeof(buffer)) > 0) {
+            write(client_fd, canned_response.data(), canned_response.size());
+        }
+        close(client_fd);
+    });
+
+    httpcpp::Http1Protocol<WindowRecordingTransport> protocol;
+    ASSERT_TRUE(protocol.connect("127.0.0.1", ntohs(addr.sin_port)).has_value());
+    httpcpp::HttpRequest req{};
+    for (int i = 0; i < 3; ++i) {
+        auto result = protocol.perform_request_unsafe(req);
+        ASSERT_TRUE(result.has_value());
+        ASSERT_EQ(result->body.size(), body.size());
+    }
+
+    // The later responses were predicted and reserved, yet each read still resized only one window.
+    ASSERT_EQ(protocol.size_prediction_stats().hits, 2u);
+    ASSERT_LE(protocol.transport().largest_window, 64u * 1024);
+
+    (void)protocol.disconnect();
+    server.join();
+    close(listener_fd);
+}
+
+TEST(ResponseSizePredictorTest, TracksRecentSizesAndScoresPredictions) {
+    httpcpp::ResponseSizePredictor predictor;
+    ASSERT_EQ(predictor.predict(), 0u);
+
+    predictor.observe(predictor.predict(), 1000);
+    ASSERT_EQ(predictor.predict(), 1500u);
+    ASSERT_EQ(predictor.stats().predictions, 0u);
+
+    predictor.observe(predictor.predict(), 1000);
+    ASSERT_GE(predictor.predict(), 1000u);
+    ASSERT_LT(predictor.predict(), 1500u);
+
+    predictor.observe(predictor.predict(), 5000);
+    ASSERT_EQ(predictor.stats().predictions, 2u);
+    ASSERT_EQ(predictor.stats().hits, 1u);
+    ASSERT_GT(predictor.predict(), 1500u);
+
+    predictor.reset();
+    ASSERT_EQ(predictor.predict(), 0u);
+    ASSERT_EQ(predictor.stats().predictions, 2u);
+}
+
+TEST(Crc32cTest, MatchesCastagnoliCheckValue) {
+    std::string_view input = "123456789";
+    auto bytes = std::as_bytes(std::span(input.data(), input.size()));
+    ASSERT_EQ(httpcpp::crc32c_update(0, bytes), 0xE3069283u);
+    ASSERT_EQ(httpcpp::crc32c_update(httpcpp::crc32c_update(0, bytes.first(4)), bytes.subspan(4)), 0xE3069283u);
+    ASSERT_EQ(httpcpp::parse_crc32c_digest("sha-256=:abc=:, crc32c=:4waSgw==:").value(), 0xE3069283u);
+}
+
+TEST(Crc32cTest, DigestMembersAreMatchedByExactKey) {
+    ASSERT_EQ(httpcpp::parse_crc32c_digest("crc32c=:4waSgw==:;note=1").value(), 0xE3069283u);
+    ASSERT_EQ(httpcpp::parse_crc32c_digest("crc32c=:AAAAAA==:,crc32c=:4waSgw==:").value(), 0xE3069283u);
+    ASSERT_EQ(httpcpp::parse_crc32c_digest("xcrc32c=:4waSgw==:").value(), std::nullopt);
+    ASSERT_EQ(httpcpp::parse_crc32c_digest("sha-256=:abc=:").value(), std::nullopt);
+    ASSERT_EQ(httpcpp::parse_crc32c_digest("").value(), std::nullopt);
+}
+
+TEST(Crc32cTest, MalformedCrc32cMemberIsAnIntegrityFailure) {
+    for (std::string_view value : {"crc32c=:4waSgw=:", "crc32c=:4wa!gw==:", "crc32c=4waSgw==", "crc32c",
+                                   "crc32c=:4waSgw==:x", "sha-256=:abc=:, crc32c=:4waSgwAA==:"}) {
+        auto digest = httpcpp::parse_crc32c_digest(value);
+        ASSERT_FALSE(digest.has_value()) << value;
+        ASSERT_EQ(std::get<httpcpp::HttpClientError>(digest.error()), httpcpp::HttpClientError::IntegrityFailure);
+    }
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, IntegrityPolicyVerifiesDigestAcrossChunks) {
+    const std::string headers =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Digest: crc32c=:+jGMoQ==:\r\n"
+        "Content-Length: 12\r\n"
+        "\r\n"
+        "Hello";
+
+    this->StartServer([&headers](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, headers.c_str(), headers.length());
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        write(client_fd, " Client", 7);
+    });
+
+    httpcpp::Http1Protocol<typename TestFixture::TransportType, httpcpp::HeadersPolicy::Full, httpcpp::StatusPolicy::Full,
+                           httpcpp::ValidationPolicy::Lenient, httpcpp::IntegrityPolicy::Crc32c> protocol;
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)protocol.connect("127.0.0.1", this->port_);
+    } else {
+        (void)protocol.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = protocol.perform_request_unsafe(req);
+
+    ASSERT_TRUE(result.has_value());
+    std::string body_str(reinterpret_cast<const char*>(result->body.data()), result->body.size());
+    ASSERT_EQ(body_str, "Hello Client");
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, IntegrityPolicyRejectsDigestMismatch) {
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Digest: crc32c=:+jGMoQ==:\r\n"
+        "Content-Length: 12\r\n"
+        "\r\n"
+        "Hello Clienz";
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    httpcpp::Http1Protocol<typename TestFixture::TransportType, httpcpp::HeadersPolicy::Full, httpcpp::StatusPolicy::Full,
+                           httpcpp::ValidationPolicy::Lenient, httpcpp::IntegrityPolicy::Crc32c> protocol;
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)protocol.connect("127.0.0.1", this->port_);
+    } else {
+        (void)protocol.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = protocol.perform_request_unsafe(req);
+
+    ASSERT_FALSE(result.has_value());
+    auto* err_ptr = std::get_if<httpcpp::HttpClientError>(&result.error());
+    ASSERT_NE(err_ptr, nullptr);
+    ASSERT_EQ(*err_ptr, httpcpp::HttpClientError::IntegrityFailure);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, IntegrityPolicyRejectsMalformedDigest) {
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Digest: crc32c=:+jGMoQ=:\r\n"
+        "Content-Length: 12\r\n"
+        "\r\n"
+        "Hello Client";
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    httpcpp::Http1Protocol<typename TestFixture::TransportType, httpcpp::HeadersPolicy::Full, httpcpp::StatusPolicy::Full,
+                           httpcpp::ValidationPolicy::Lenient, httpcpp::IntegrityPolicy::Crc32c> protocol;
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)protocol.connect("127.0.0.1", this->port_);
+    } else {
+        (void)protocol.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = protocol.perform_request_unsafe(req);
+
+    ASSERT_FALSE(result.has_value());
+    auto* err_ptr = std::get_if<httpcpp::HttpClientError>(&result.error());
+    ASSERT_NE(err_ptr, nullptr);
+    ASSERT_EQ(*err_ptr, httpcpp::HttpClientError::IntegrityFailure);
+}
+
+TEST(StreamCopyTest, MatchesSourceForUnalignedBoundsAndTails) {
+    std::vector<std::byte> source(httpcpp::NON_TEMPORAL_COPY_THRESHOLD + 100);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<std::byte>(i * 31);
+    }
+    for (size_t offset : {0u, 1u, 7u, 15u}) {
+        for (size_t len : {0u, 5u, 63u, 64u, 1000u, 262150u}) {
+            std::vector<std::byte> dest(len + 32, std::byte{0xAA});
+            httpcpp::copy_bytes(dest.data() + offset, source.data() + 3, len);
+            ASSERT_TRUE(std::equal(source.begin() + 3, source.begin() + 3 + len, dest.begin() + offset));
+            ASSERT_EQ(dest[offset + len], std::byte{0xAA});
+        }
+    }
+}
+
+// SafeHttpResponse::body is not a std::vector<std::byte>; this is the documented way across.
+TEST(StreamCopyTest, SafeBodyCopiesOutToAPlainVector) {
+    static_assert(std::is_same_v<decltype(httpcpp::SafeHttpResponse::body), httpcpp::ByteBuffer>);
+    const std::vector<std::byte> expected = {std::byte{'o'}, std::byte{'k'}};
+    httpcpp::SafeHttpResponse response{};
+    response.body.resize(expected.size());
+    httpcpp::copy_bytes(response.body.data(), expected.data(), expected.size());
+
+    const std::vector<std::byte> plain(response.body.begin(), response.body.end());
+    ASSERT_EQ(plain, expected);
+    ASSERT_TRUE(std::ranges::equal(response.body, expected));
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, SpillPolicyMapsLargeBodyOutsideReceiveBuffer) {
+    std::string body(200 * 1024, '\0');
+    for (size_t i = 0; i < body.size(); ++i) {
+        body[i] = static_cast<char>('a' + i % 26);
+    }
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        "\r\n" + body;
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    this->protocol_.set_spill_policy({.threshold = 64 * 1024});
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)this->protocol_.connect("127.0.0.1", this->port_);
+    } else {
+        (void)this->protocol_.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = this->protocol_.perform_request_unsafe(req);
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->content_length, body.size());
+    ASSERT_EQ(result->headers[0].first, "Content-Length");
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(result->body.data()), result->body.size()), body);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(result->body.data()) % 4096, 0u);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, SpillPolicyHandlesBodyUntilCloseAndSafeCopies) {
+    const std::string body(100 * 1024, 'z');
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Connection: close\r\n"
+        "\r\n" + body;
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    this->protocol_.set_spill_policy({.threshold = 4096});
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)this->protocol_.connect("127.0.0.1", this->port_);
+    } else {
+        (void)this->protocol_.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = this->protocol_.perform_request_safe(req);
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->headers[0].second, "close");
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(result->body.data()), result->body.size()), body);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, SpillPolicyBoundsMemoryForUnsafeResponsesOnly) {
+    std::string body(4 * 1024 * 1024, '\0');
+    for (size_t i = 0; i < body.size(); ++i) {
+        body[i] = static_cast<char>('a' + i % 26);
+    }
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        "\r\n" + body;
+
+    this->StartServer([&canned_response](int client_fd) {
+        for (int i = 0; i < 2; ++i) {
+            char buffer[1024];
+            read(client_fd, buffer, sizeof(buffer));
+            write(client_fd, canned_response.c_str(), canned_response.length());
+        }
+    });
+
+    this->protocol_.set_spill_policy({.threshold = 64 * 1024});
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)this->protocol_.connect("127.0.0.1", this->port_);
+    } else {
+        (void)this->protocol_.connect(this->socket_path_.c_str(), 0);
+    }
+
+    // The unsafe body stays in the mapping; the receive buffer never grows past the spill window.
+    httpcpp::HttpRequest req{};
+    auto unsafe = this->protocol_.perform_request_unsafe(req);
+    ASSERT_TRUE(unsafe.has_value());
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(unsafe->body.data()), unsafe->body.size()), body);
+    ASSERT_LE(this->protocol_.get_internal_buffer_capacity_for_test(), 256u * 1024);
+
+    // The safe body is an owned copy of the mapping, so it is in memory after all.
+    auto safe = this->protocol_.perform_request_safe(req);
+    ASSERT_TRUE(safe.has_value());
+    ASSERT_EQ(safe->body.size(), body.size());
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(safe->body.data()), safe->body.size()), body);
+    ASSERT_LE(this->protocol_.get_internal_buffer_capacity_for_test(), 256u * 1024);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, SpillPolicyKeepsSmallBodiesInMemory) {
+    const std::string canned_response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 5\r\n"
+        "\r\n"
+        "Hello";
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    this->protocol_.set_spill_policy({.threshold = 4096});
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        (void)this->protocol_.connect("127.0.0.1", this->port_);
+    } else {
+        (void)this->protocol_.connect(this->socket_path_.c_str(), 0);
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = this->protocol_.perform_request_unsafe(req);
+
+    ASSERT_TRUE(result.has_value());
+    const auto* buffer_start = this->protocol_.get_internal_buffer_ptr_for_test();
+    ASSERT_EQ(result->body.data(), buffer_start + canned_response.size() - 5);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, StreamedBodyIsSentChunked) {
+    std::promise<void> server_read_promise;
+    auto server_read_future = server_read_promise.get_future();
+
+    this->StartServer([this, &server_read_promise](int client_fd) {
+        char buffer[1024];
+        while (!this->captured_request_.ends_with("0\r\n\r\n")) {
+            ssize_t bytes_read = read(client_fd, buffer, sizeof(buffer));
+            if (bytes_read <= 0) break;
+            this->captured_request_.append(buffer, bytes_read);
+        }
+        server_read_promise.set_value();
+        const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+        write(client_fd, response.c_str(), response.length());
+    });
+
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        ASSERT_TRUE(this->protocol_.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(this->protocol_.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    // Three chunks, the second gathered from several buffers, one of them empty.
+    const std::string large(300, 'x');
+    const std::vector<std::vector<std::string_view>> chunks = {{"hello"}, {"big:", "", large}, {"end"}};
+    size_t calls = 0;
+    std::vector<std::span<const std::byte>> parts;
+    auto producer = [&]() -> std::expected<std::span<const std::span<const std::byte>>, httpcpp::Error> {
+        parts.clear();
+        if (calls < chunks.size()) {
+            for (std::string_view part : chunks[calls]) {
+                parts.push_back(std::as_bytes(std::span(part)));
+            }
+        }
+        ++calls;
+        return std::span<const std::span<const std::byte>>(parts);
+    };
+
+    httpcpp::HttpRequest req{};
+    req.method = httpcpp::HttpMethod::Post;
+    req.path = "/upload";
+    auto result = this->protocol_.perform_request_stream_unsafe(req, producer);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->status_code, 200);
+    ASSERT_EQ(calls, 4u);
+
+    server_read_future.wait();
+    const std::string expected_request =
+        "POST /upload HTTP/1.1\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n"
+        "5\r\nhello\r\n"
+        "130\r\nbig:" + large + "\r\n"
+        "3\r\nend\r\n"
+        "0\r\n\r\n";
+    ASSERT_EQ(this->captured_request_, expected_request);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, StreamedBodyProducerErrorClosesConnection) {
+    this->StartServer([](int client_fd) {
+        char buffer[1024];
+        while (read(client_fd, buffer, sizeof(buffer)) > 0) {
+        }
+    });
+
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        ASSERT_TRUE(this->protocol_.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(this->protocol_.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    const std::string data = "partial";
+    const std::span<const std::byte> part = std::as_bytes(std::span(data));
+    bool produced = false;
+    auto producer = [&]() -> std::expected<std::span<const std::span<const std::byte>>, httpcpp::Error> {
+        if (produced) {
+            return std::unexpected(httpcpp::Error{httpcpp::HttpClientError::SpillFailure});
+        }
+        produced = true;
+        return std::span<const std::span<const std::byte>>(&part, 1);
+    };
+
+    httpcpp::HttpRequest req{};
+    req.method = httpcpp::HttpMethod::Post;
+    auto result = this->protocol_.perform_request_stream_unsafe(req, producer);
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(std::get<httpcpp::HttpClientError>(result.error()), httpcpp::HttpClientError::SpillFailure);
+
+    // The half-sent request must not be followed by another one on the same connection.
+    httpcpp::HttpRequest next{};
+    ASSERT_FALSE(this->protocol_.perform_request_unsafe(next).has_value());
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, WriterBodyGetsBackpatchedContentLength) {
+    const std::string payload(100000, 'w');
+    const std::string expected_request =
+        "POST /json HTTP/1.1\r\n"
+        "Host: example.com\r\n"
+        "Content-Length: 100012\r\n"
+        "\r\n"
+        "{\"data\": \"" + payload + "\"}";
+
+    this->StartServer([this, &expected_request](int client_fd) {
+        char buffer[4096];
+        while (this->captured_request_.size() < expected_request.size()) {
+            ssize_t bytes_read = read(client_fd, buffer, sizeof(buffer));
+            if (bytes_read <= 0) break;
+            this->captured_request_.append(buffer, bytes_read);
+        }
+        const std::string response = "HTTP/1.1 201 Created\r\nContent-Length: 0\r\n\r\n";
+        write(client_fd, response.c_str(), response.length());
+    });
+
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        ASSERT_TRUE(this->protocol_.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(this->protocol_.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    // Generated in place: a prepared region partly committed, regrown past the initial buffer.
+    auto writer = [&payload](httpcpp::RequestBodyBuffer& body) -> std::expected<void, httpcpp::Error> {
+        body.append("{\"data\": ");
+        auto region = body.prepare(payload.size() + 64);
+        region[0] = std::byte{'"'};
+        std::memcpy(region.data() + 1, payload.data(), payload.size());
+        body.commit(payload.size() + 1);
+        body.append("\"}");
+        return {};
+    };
+
+    httpcpp::HttpRequest req{};
+    req.method = httpcpp::HttpMethod::Post;
+    req.path = "/json";
+    req.headers.emplace_back("Host", "example.com");
+    auto result = this->protocol_.perform_request_writer_unsafe(req, writer);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->status_code, 201);
+    ASSERT_TRUE(this->captured_request_ == expected_request);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, WriterErrorSendsNothing) {
+    this->StartServer([this](int client_fd) {
+        char buffer[1024];
+        ssize_t bytes_read = read(client_fd, buffer, sizeof(buffer));
+        if (bytes_read > 0) {
+            this->captured_request_.assign(buffer, bytes_read);
+        }
+        const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+        write(client_fd, response.c_str(), response.length());
+    });
+
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        ASSERT_TRUE(this->protocol_.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(this->protocol_.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    auto failing = [](httpcpp::RequestBodyBuffer& body) -> std::expected<void, httpcpp::Error> {
+        body.append("half a document");
+        return std::unexpected(httpcpp::Error{httpcpp::HttpClientError::InvalidRequest});
+    };
+    httpcpp::HttpRequest req{};
+    req.method = httpcpp::HttpMethod::Post;
+    req.path = "/json";
+    ASSERT_FALSE(this->protocol_.perform_request_writer_unsafe(req, failing).has_value());
+
+    // The connection is untouched; an empty body still gets its length.
+    auto empty = [](httpcpp::RequestBodyBuffer&) -> std::expected<void, httpcpp::Error> { return {}; };
+    ASSERT_TRUE(this->protocol_.perform_request_writer_unsafe(req, empty).has_value());
+    ASSERT_EQ(this->captured_request_, "POST /json HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+}
+
+// The node holding the page at `address`, or -1 where the kernel cannot say.
+static int NodeOfPage(const void* address) {
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, address, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        return -1;
+    }
+    return node;
+}
+
+TEST(NumaTest, BindsWorkerToNodeAndRejectsUnknownNodes) {
+    const int nodes = httpcpp::numa::node_count();
+    ASSERT_GE(nodes, 1);
+    ASSERT_GE(httpcpp::numa::current_node(), 0);
+    ASSERT_LT(httpcpp::numa::current_node(), nodes);
+
+    // A worker thread of its own, so the test runner keeps its affinity.
+    std::thread worker([nodes] {
+        const int last = nodes - 1;
+        ASSERT_TRUE(httpcpp::numa::bind_current_thread(last).has_value());
+        ASSERT_EQ(httpcpp::numa::current_node(), last);
+
+        for (int node : {-1, nodes}) {
+            auto result = httpcpp::numa::bind_current_thread(node);
+            ASSERT_FALSE(result.has_value());
+            ASSERT_EQ(std::get<httpcpp::HttpClientError>(result.error()), httpcpp::HttpClientError::InvalidRequest);
+        }
+    });
+    worker.join();
+}
+
+TEST(NumaTest, NodeAllocatorPlacesPagesOnNode) {
+    const int node = httpcpp::numa::node_count() - 1;
+    std::vector<std::byte, httpcpp::numa::NodeAllocator<std::byte>> placed{httpcpp::numa::NodeAllocator<std::byte>(node)};
+    placed.resize(1 << 20);
+    const int actual = NodeOfPage(placed.data() + placed.size() / 2);
+    if (actual != -1) {
+        ASSERT_EQ(actual, node);
+    }
+
+    // Small allocations and the default node stay on the ordinary heap.
+    std::vector<std::byte, httpcpp::numa::NodeAllocator<std::byte>> small{httpcpp::numa::NodeAllocator<std::byte>(node)};
+    small.resize(16);
+    ASSERT_EQ(small.get_allocator().node(), node);
+    ASSERT_NE(small.get_allocator(), httpcpp::numa::NodeAllocator<std::byte>());
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, NumaNodePlacesReceiveBuffer) {
+    const std::string body(100000, 'n');
+    const std::string canned_response = "HTTP/1.1 200 OK\r\nContent-Length: 100000\r\n\r\n" + body;
+
+    this->StartServer([&canned_response](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+    });
+
+    auto rejected = this->protocol_.set_numa_node(httpcpp::numa::node_count());
+    ASSERT_FALSE(rejected.has_value());
+    ASSERT_EQ(this->protocol_.numa_node(), -1);
+
+    const int node = httpcpp::numa::current_node();
+    ASSERT_TRUE(this->protocol_.set_numa_node(node).has_value());
+    ASSERT_EQ(this->protocol_.numa_node(), node);
+    this->protocol_.reserve_buffer(256 * 1024);
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        ASSERT_TRUE(this->protocol_.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(this->protocol_.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    httpcpp::HttpRequest req{};
+    auto result = this->protocol_.perform_request_unsafe(req);
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(result->body.data()), result->body.size()), body);
+    const int actual = NodeOfPage(result->body.data());
+    if (actual != -1) {
+        ASSERT_EQ(actual, node);
+    }
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, ReconnectPolicyReplacesConnectionClosedWhileIdle) {
+    const std::string canned_response = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+    std::atomic<int> served{0};
+
+    // One response per connection, then the server hangs up as an idle-timeout would.
+    this->StartServer([&canned_response, &served](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+        shutdown(client_fd, SHUT_RDWR);
+        served.fetch_add(1);
+    }, 2);
+
+    this->protocol_.set_reconnect_policy({.check_before_use = true});
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        ASSERT_TRUE(this->protocol_.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(this->protocol_.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    httpcpp::HttpRequest req{};
+    ASSERT_TRUE(this->protocol_.perform_request_unsafe(req).has_value());
+    while (served.load() < 1) {
+        std::this_thread::yield();
+    }
+
+    auto result = this->protocol_.perform_request_unsafe(req);
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(result->body.data()), result->body.size()), "ok");
+    ASSERT_EQ(this->protocol_.reconnect_count(), 1u);
+}
+
+TYPED_TEST(Http1ProtocolIntegrationTest, ReconnectPolicyRetriesOnlyIdempotentRequests) {
+    const std::string canned_response = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+    std::atomic<int> served{0};
+
+    this->StartServer([&canned_response, &served](int client_fd) {
+        char buffer[1024];
+        read(client_fd, buffer, sizeof(buffer));
+        write(client_fd, canned_response.c_str(), canned_response.length());
+        shutdown(client_fd, SHUT_RDWR);
+        served.fetch_add(1);
+    }, 2);
+
+    this->protocol_.set_reconnect_policy({.retry_idempotent = true});
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, httpcpp::TcpTransport>) {
+        ASSERT_TRUE(this->protocol_.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(this->protocol_.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    httpcpp::HttpRequest get{};
+    ASSERT_TRUE(this->protocol_.perform_request_unsafe(get).has_value());
+    while (served.load() < 1) {
+        std::this_thread::yield();
+    }
+
+    // The GET hits the closed connection and is sent again on a new one.
+    auto result = this->protocol_.perform_request_unsafe(get);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(this->protocol_.reconnect_count(), 1u);
+    while (served.load() < 2) {
+        std::this_thread::yield();
+    }
+
+    httpcpp::HttpRequest post{};
+    post.method = httpcpp::HttpMethod::Post;
+    post.headers = {{"Content-Length", "1"}};
+    const std::byte body[] = {std::byte{'x'}};
+    post.body = body;
+
+    ASSERT_FALSE(this->protocol_.perform_request_unsafe(post).has_value());
+    ASSERT_EQ(this->protocol_.reconnect_count(), 1u);
+}
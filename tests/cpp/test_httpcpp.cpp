@@ -1,10 +1,18 @@
 #include <gtest/gtest.h>
 #include <httpcpp/httpcpp.hpp>
+#include <httpcpp/balanced_client.hpp>
+#include <httpcpp/coalescing_client.hpp>
+#include <httpcpp/priority_client.hpp>
+#include <httpcpp/batching_client.hpp>
 
 #include <thread>
+#include <chrono>
+#include <mutex>
 #include <atomic>
 #include <functional>
 #include <vector>
+#include <map>
+#include <set>
 #include <string>
 #include <random>
 #include <iomanip>
@@ -15,6 +23,7 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
 
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <netinet/in.h>
@@ -336,6 +345,24 @@ TYPED_TEST(HttpClientIntegrationTest, PostRequestWithoutBodyReturnsError) {
     ASSERT_EQ(std::get<HttpClientError>(result_unsafe.error()), HttpClientError::InvalidRequest);
 }
 
+TYPED_TEST(HttpClientIntegrationTest, PostGatherRejectsContentLengthMismatch) {
+    HttpClient<Http1Protocol<typename TestFixture::TransportType>> client;
+
+    const std::string first = "hello, ";
+    const std::string second = "world";
+    const std::span<const std::byte> parts[] = {std::as_bytes(std::span(first)), std::as_bytes(std::span(second))};
+
+    for (const char* content_length : {"11", "13", "12x", ""}) {
+        HttpRequest request{};
+        request.path = "/test";
+        request.headers.emplace_back("Content-Length", content_length);
+
+        auto result = client.post_gather_safe(request, parts);
+        ASSERT_FALSE(result.has_value()) << content_length;
+        ASSERT_EQ(std::get<HttpClientError>(result.error()), HttpClientError::InvalidRequest);
+    }
+}
+
 TYPED_TEST(HttpClientIntegrationTest, PostRequestWithoutContentLengthReturnsError) {
     HttpClient<Http1Protocol<typename TestFixture::TransportType>> client;
 
@@ -360,6 +387,180 @@ TYPED_TEST(HttpClientIntegrationTest, PostRequestWithoutContentLengthReturnsErro
 }
 
 
+TYPED_TEST(HttpClientIntegrationTest, PostStreamUploadsGeneratedBodyChunked) {
+    constexpr size_t CHUNK_SIZE = 64 * 1024;
+    constexpr size_t CHUNKS = 64;
+
+    std::string received_body;
+    std::string received_encoding;
+    this->StartServer([&](int client_fd) {
+        namespace beast = boost::beast;
+        namespace http = beast::http;
+        namespace asio = boost::asio;
+
+        asio::io_context ioc;
+        using socket_t = typename std::conditional_t<
+            std::is_same_v<typename TestFixture::TransportType, TcpTransport>,
+            asio::ip::tcp::socket,
+            asio::local::stream_protocol::socket
+        >;
+        socket_t stream(ioc);
+        if constexpr (std::is_same_v<typename TestFixture::TransportType, TcpTransport>) {
+            stream.assign(asio::ip::tcp::v4(), client_fd);
+        } else {
+            stream.assign(asio::local::stream_protocol(), client_fd);
+        }
+
+        boost::system::error_code ec;
+        beast::flat_buffer buffer;
+        http::request_parser<http::string_body> parser;
+        parser.body_limit(CHUNK_SIZE * CHUNKS);
+        http::read(stream, buffer, parser, ec);
+        ASSERT_FALSE(ec) << ec.message();
+        received_body = parser.get().body();
+        received_encoding = std::string(parser.get()[http::field::transfer_encoding]);
+
+        http::response<http::string_body> res{http::status::ok, 11};
+        res.body() = std::to_string(received_body.size());
+        res.prepare_payload();
+        http::write(stream, res, ec);
+        stream.release();
+    });
+
+    HttpClient<Http1Protocol<typename TestFixture::TransportType>> client;
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, TcpTransport>) {
+        ASSERT_TRUE(client.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(client.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    // One reused buffer regenerated per chunk; the whole body never exists at once.
+    std::string generated;
+    std::string expected;
+    std::span<const std::byte> part;
+    size_t produced = 0;
+    auto producer = [&]() -> std::expected<std::span<const std::span<const std::byte>>, Error> {
+        if (produced == CHUNKS) {
+            return std::span<const std::span<const std::byte>>{};
+        }
+        generated.assign(CHUNK_SIZE, static_cast<char>('a' + produced % 26));
+        expected += generated;
+        ++produced;
+        part = std::as_bytes(std::span(generated));
+        return std::span<const std::span<const std::byte>>(&part, 1);
+    };
+
+    HttpRequest request{};
+    request.path = "/upload";
+    auto result = client.post_stream_safe(request, producer);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->status_code, 200);
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(result->body.data()), result->body.size()),
+              std::to_string(CHUNK_SIZE * CHUNKS));
+    this->StopServer();
+    ASSERT_EQ(received_encoding, "chunked");
+    ASSERT_TRUE(received_body == expected);
+}
+
+TYPED_TEST(HttpClientIntegrationTest, PostStreamRejectsBodyFramingHeaders) {
+    HttpClient<Http1Protocol<typename TestFixture::TransportType>> client;
+    auto producer = []() -> std::expected<std::span<const std::span<const std::byte>>, Error> {
+        return std::span<const std::span<const std::byte>>{};
+    };
+
+    HttpRequest with_length{};
+    with_length.headers.emplace_back("content-length", "10");
+    auto result = client.post_stream_safe(with_length, producer);
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(std::get<HttpClientError>(result.error()), HttpClientError::InvalidRequest);
+
+    HttpRequest with_encoding{};
+    with_encoding.headers.emplace_back("Transfer-Encoding", "chunked");
+    ASSERT_FALSE(client.post_stream_unsafe(with_encoding, producer).has_value());
+
+    const std::string body = "inline";
+    HttpRequest with_body{};
+    with_body.body = std::as_bytes(std::span(body));
+    ASSERT_FALSE(client.post_stream_safe(with_body, producer).has_value());
+}
+
+TYPED_TEST(HttpClientIntegrationTest, PostWithWriterSendsGeneratedBody) {
+    std::string received_body;
+    this->StartServer([&](int client_fd) {
+        namespace beast = boost::beast;
+        namespace http = beast::http;
+        namespace asio = boost::asio;
+
+        asio::io_context ioc;
+        using socket_t = typename std::conditional_t<
+            std::is_same_v<typename TestFixture::TransportType, TcpTransport>,
+            asio::ip::tcp::socket,
+            asio::local::stream_protocol::socket
+        >;
+        socket_t stream(ioc);
+        if constexpr (std::is_same_v<typename TestFixture::TransportType, TcpTransport>) {
+            stream.assign(asio::ip::tcp::v4(), client_fd);
+        } else {
+            stream.assign(asio::local::stream_protocol(), client_fd);
+        }
+
+        boost::system::error_code ec;
+        beast::flat_buffer buffer;
+        http::request<http::string_body> req;
+        http::read(stream, buffer, req, ec);
+        ASSERT_FALSE(ec) << ec.message();
+        received_body = req.body();
+
+        http::response<http::string_body> res{http::status::ok, 11};
+        res.body() = std::to_string(req.body().size());
+        res.prepare_payload();
+        http::write(stream, res, ec);
+        stream.release();
+    });
+
+    HttpClient<Http1Protocol<typename TestFixture::TransportType>> client;
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, TcpTransport>) {
+        ASSERT_TRUE(client.connect("127.0.0.1", this->port_).has_value());
+    } else {
+        ASSERT_TRUE(client.connect(this->socket_path_.c_str(), 0).has_value());
+    }
+
+    std::string expected = "[";
+    for (int i = 0; i < 1000; ++i) {
+        expected += (i == 0 ? "" : ",") + std::to_string(i);
+    }
+    expected += "]";
+    auto writer = [](RequestBodyBuffer& body) -> std::expected<void, Error> {
+        body.append("[");
+        for (int i = 0; i < 1000; ++i) {
+            auto region = body.prepare(16);
+            char* out = reinterpret_cast<char*>(region.data());
+            if (i != 0) {
+                *out++ = ',';
+            }
+            auto [end, ec] = std::to_chars(out, out + 15, i);
+            body.commit(static_cast<size_t>(end - reinterpret_cast<char*>(region.data())));
+        }
+        body.append("]");
+        return {};
+    };
+
+    HttpRequest with_length{};
+    with_length.headers.emplace_back("Content-Length", "4");
+    auto rejected = client.post_with_writer(with_length, writer);
+    ASSERT_FALSE(rejected.has_value());
+    ASSERT_EQ(std::get<HttpClientError>(rejected.error()), HttpClientError::InvalidRequest);
+
+    HttpRequest request{};
+    request.path = "/numbers";
+    auto result = client.post_with_writer(request, writer);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(result->body.data()), result->body.size()),
+              std::to_string(expected.size()));
+    this->StopServer();
+    ASSERT_EQ(received_body, expected);
+}
+
 
 namespace {
     // Helper function for checksum calculation
@@ -521,4 +722,599 @@ TYPED_TEST(HttpClientIntegrationTest, MultiRequestChecksumVerification) {
     run_client_loop(&HttpClient<Http1Protocol<typename TestFixture::TransportType>>::post_unsafe);
 
     ASSERT_TRUE(client.disconnect().has_value());
-}
\ No newline at end of file
+}
+
+TYPED_TEST(HttpClientIntegrationTest, WarmUpConnectsPresizesAndRunsThrowawayRequests) {
+    const std::string canned_response = "HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\nwarm";
+    std::vector<std::string> paths;
+
+    this->StartServer([&canned_response, &paths](int client_fd) {
+        std::vector<char> buffer(1024, 0);
+        for (int i = 0; i < 3; ++i) {
+            ssize_t bytes_read = read(client_fd, buffer.data(), buffer.size() - 1);
+            if (bytes_read <= 0) {
+                return;
+            }
+            std::string request(buffer.data(), bytes_read);
+            paths.push_back(request.substr(4, request.find(' ', 4) - 4));
+            write(client_fd, canned_response.c_str(), canned_response.length());
+        }
+    });
+
+    HttpClient<Http1Protocol<typename TestFixture::TransportType>> client;
+
+    HttpRequest warm_request{};
+    warm_request.path = "/warm";
+    const WarmUpOptions options{.buffer_size = 256 * 1024, .request = &warm_request, .requests = 2};
+    if constexpr (std::is_same_v<typename TestFixture::TransportType, TcpTransport>) {
+        ASSERT_TRUE(client.warm_up("127.0.0.1", this->port_, options).has_value());
+    } else {
+        ASSERT_TRUE(client.warm_up(this->socket_path_.c_str(), 0, options).has_value());
+    }
+    const auto* buffer_after_warm_up = client.protocol().get_internal_buffer_ptr_for_test();
+
+    HttpRequest request{};
+    request.path = "/real";
+    auto result = client.get_unsafe(request);
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->status_code, 200);
+    // The pre-sized buffer was neither reallocated by the warm-up requests nor by this one.
+    ASSERT_EQ(client.protocol().get_internal_buffer_ptr_for_test(), buffer_after_warm_up);
+    ASSERT_EQ(paths, (std::vector<std::string>{"/warm", "/warm", "/real"}));
+
+    (void)client.disconnect();
+}
+
+// A loopback replica for the multi-connection client tests: serves every connection it accepts
+// on its own thread, answers every request after `delay` and records the request paths, bodies
+// and the number of connections.
+class BalancerReplica {
+public:
+    explicit BalancerReplica(std::chrono::microseconds delay) : delay_(delay) {
+        listener_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listener_fd_, (struct sockaddr*)&addr, sizeof(addr));
+        listen(listener_fd_, 8);
+        socklen_t len = sizeof(addr);
+        getsockname(listener_fd_, (struct sockaddr*)&addr, &len);
+        port_ = ntohs(addr.sin_port);
+        accept_thread_ = std::thread([this] { AcceptLoop(); });
+    }
+
+    ~BalancerReplica() {
+        shutdown(listener_fd_, SHUT_RDWR);
+        accept_thread_.join();
+        {
+            std::lock_guard lock(mutex_);
+            for (int fd : client_fds_) {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        for (auto& thread : session_threads_) {
+            thread.join();
+        }
+        for (int fd : client_fds_) {
+            close(fd);
+        }
+        close(listener_fd_);
+    }
+
+    uint16_t port() const { return port_; }
+
+    std::vector<std::string> paths() {
+        std::lock_guard lock(mutex_);
+        return paths_;
+    }
+
+    std::vector<std::string> bodies() {
+        std::lock_guard lock(mutex_);
+        return bodies_;
+    }
+
+    // Host header of each request, or "" when it had none.
+    std::vector<std::string> hosts() {
+        std::lock_guard lock(mutex_);
+        return hosts_;
+    }
+
+    size_t connections() {
+        std::lock_guard lock(mutex_);
+        return client_fds_.size();
+    }
+
+private:
+    void AcceptLoop() {
+        while (true) {
+            int fd = accept(listener_fd_, nullptr, nullptr);
+            if (fd < 0) return;
+            std::lock_guard lock(mutex_);
+            client_fds_.push_back(fd);
+            session_threads_.emplace_back([this, fd] { Serve(fd); });
+        }
+    }
+
+    void Serve(int fd) {
+        const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+        std::string pending;
+        std::vector<char> buffer(64 * 1024);
+        while (true) {
+            const size_t head_end = pending.find("\r\n\r\n");
+            if (head_end == std::string::npos) {
+                ssize_t bytes_read = read(fd, buffer.data(), buffer.size());
+                if (bytes_read <= 0) break;
+                pending.append(buffer.data(), bytes_read);
+                continue;
+            }
+            size_t content_length = 0;
+            if (size_t cl = pending.find("Content-Length: "); cl != std::string::npos && cl < head_end) {
+                content_length = std::stoul(pending.substr(cl + 16));
+            }
+            const size_t request_size = head_end + 4 + content_length;
+            while (pending.size() < request_size) {
+                ssize_t bytes_read = read(fd, buffer.data(), buffer.size());
+                if (bytes_read <= 0) return;
+                pending.append(buffer.data(), bytes_read);
+            }
+            {
+                const size_t path_start = pending.find(' ') + 1;
+                std::lock_guard lock(mutex_);
+                paths_.push_back(pending.substr(path_start, pending.find(' ', path_start) - path_start));
+                bodies_.push_back(pending.substr(head_end + 4, content_length));
+                const size_t host = pending.find("\r\nHost: ");
+                hosts_.push_back(host < head_end ? pending.substr(host + 8, pending.find("\r\n", host + 2) - host - 8) : "");
+            }
+            pending.erase(0, request_size);
+            std::this_thread::sleep_for(delay_);
+            write(fd, response.data(), response.size());
+        }
+    }
+
+    std::chrono::microseconds delay_;
+    int listener_fd_ = -1;
+    uint16_t port_ = 0;
+    std::mutex mutex_;
+    std::vector<int> client_fds_;
+    std::vector<std::string> paths_;
+    std::vector<std::string> bodies_;
+    std::vector<std::string> hosts_;
+    std::vector<std::thread> session_threads_;
+    std::thread accept_thread_;
+};
+
+TEST(BalancedHttpClientTest, PowerOfTwoChoicesAvoidsSlowReplica) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica fast_a(std::chrono::microseconds(0));
+    BalancerReplica fast_b(std::chrono::microseconds(0));
+    BalancerReplica slow(std::chrono::milliseconds(20));
+    const std::vector<Endpoint> endpoints = {
+        {"127.0.0.1", fast_a.port()}, {"127.0.0.1", fast_b.port()}, {"127.0.0.1", slow.port()}};
+
+    BalancedHttpClient<Http1Protocol<TcpTransport>> client;
+    ASSERT_TRUE(client.connect(endpoints).has_value());
+
+    for (int i = 0; i < 30; ++i) {
+        const std::string path = "/" + std::to_string(i);
+        HttpRequest request{};
+        request.path = path;
+        auto result = client.get_safe(request);
+        ASSERT_TRUE(result.has_value());
+        ASSERT_EQ(result->status_code, 200);
+    }
+
+    // Once its latency is measured, the slow replica loses every comparison against a fast one.
+    const auto stats = client.endpoint_stats();
+    ASSERT_EQ(stats.size(), 3u);
+    ASSERT_EQ(stats[0].requests + stats[1].requests + stats[2].requests, 30u);
+    ASSERT_LE(stats[2].requests, 2u);
+    ASSERT_GT(stats[2].ewma_latency_ns, stats[0].ewma_latency_ns);
+    ASSERT_GT(stats[2].ewma_latency_ns, stats[1].ewma_latency_ns);
+
+    ASSERT_TRUE(client.disconnect().has_value());
+}
+
+TEST(BalancedHttpClientTest, ConsistentHashKeepsPathOnOneReplica) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica a(std::chrono::microseconds(0));
+    BalancerReplica b(std::chrono::microseconds(0));
+    BalancerReplica c(std::chrono::microseconds(0));
+    const std::vector<Endpoint> endpoints = {
+        {"127.0.0.1", a.port()}, {"127.0.0.1", b.port()}, {"127.0.0.1", c.port()}};
+
+    BalancedHttpClient<Http1Protocol<TcpTransport>> client(BalancePolicy::ConsistentHash);
+    ASSERT_TRUE(client.connect(endpoints).has_value());
+
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 20; ++i) {
+            const std::string path = "/item/" + std::to_string(i);
+            HttpRequest request{};
+            request.path = path;
+            ASSERT_TRUE(client.get_safe(request).has_value());
+        }
+    }
+    ASSERT_TRUE(client.disconnect().has_value());
+
+    std::map<std::string, int> owners;
+    int replicas_used = 0;
+    BalancerReplica* replicas[] = {&a, &b, &c};
+    for (int r = 0; r < 3; ++r) {
+        const auto paths = replicas[r]->paths();
+        replicas_used += paths.empty() ? 0 : 1;
+        for (const auto& path : paths) {
+            auto [it, inserted] = owners.emplace(path, r);
+            ASSERT_EQ(it->second, r) << path << " was sent to two replicas";
+        }
+    }
+    ASSERT_EQ(owners.size(), 20u);
+    ASSERT_GE(replicas_used, 2);
+}
+
+TEST(BalancedHttpClientTest, ConnectWithoutEndpointsFails) {
+    BalancedHttpClient<Http1Protocol<TcpTransport>> client;
+    auto result = client.connect({});
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(std::get<HttpClientError>(result.error()), HttpClientError::InvalidRequest);
+
+    HttpRequest request{};
+    ASSERT_FALSE(client.get_safe(request).has_value());
+}
+
+TEST(CoalescingClientTest, ConcurrentIdenticalGetsShareOneRequest) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica replica(std::chrono::milliseconds(100));
+    const std::vector<Endpoint> endpoints = {{"127.0.0.1", replica.port()}};
+    BalancedHttpClient<Http1Protocol<TcpTransport>> upstream;
+    ASSERT_TRUE(upstream.connect(endpoints).has_value());
+    CoalescingClient client(upstream);
+
+    constexpr int num_threads = 8;
+    std::vector<SharedHttpResponse> responses(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&client, &responses, t] {
+            // A header that is not part of the key does not split the flight.
+            const std::string id = std::to_string(t);
+            HttpRequest request{};
+            request.path = "/shared";
+            request.headers = {{"X-Caller", id}};
+            if (auto result = client.get(request)) {
+                responses[t] = *result;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto stats = client.stats();
+    ASSERT_EQ(stats.requests, 8u);
+    ASSERT_EQ(stats.upstream + stats.coalesced, 8u);
+    ASSERT_GE(stats.coalesced, 1u);
+    ASSERT_EQ(replica.paths().size(), stats.upstream);
+    for (const auto& response : responses) {
+        ASSERT_NE(response, nullptr);
+        ASSERT_EQ(response->status_code, 200);
+    }
+    // Coalesced callers hold the very response object their leader received.
+    std::set<const SafeHttpResponse*> distinct;
+    for (const auto& response : responses) {
+        distinct.insert(response.get());
+    }
+    ASSERT_EQ(distinct.size(), stats.upstream);
+
+    ASSERT_TRUE(upstream.disconnect().has_value());
+}
+
+TEST(CoalescingClientTest, KeyHeadersSeparateFlights) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica replica(std::chrono::milliseconds(50));
+    const std::vector<Endpoint> endpoints = {{"127.0.0.1", replica.port()}};
+    BalancedHttpClient<Http1Protocol<TcpTransport>> upstream;
+    ASSERT_TRUE(upstream.connect(endpoints).has_value());
+    CoalescingClient client(upstream, {"accept"});
+
+    auto fetch = [&client](std::string_view accept) {
+        HttpRequest request{};
+        request.path = "/shared";
+        request.headers = {{"Accept", accept}};
+        ASSERT_TRUE(client.get(request).has_value());
+    };
+    std::thread json(fetch, "application/json");
+    std::thread text(fetch, "text/plain");
+    json.join();
+    text.join();
+
+    ASSERT_EQ(client.stats().upstream, 2u);
+    ASSERT_EQ(client.stats().coalesced, 0u);
+
+    HttpRequest with_body{};
+    const std::byte payload[1] = {std::byte{'x'}};
+    with_body.body = payload;
+    ASSERT_FALSE(client.get(with_body).has_value());
+
+    ASSERT_TRUE(upstream.disconnect().has_value());
+}
+
+// A bare HttpClient has the right get_safe() but carries one request at a time.
+static_assert(ConcurrentGetClient<BalancedHttpClient<Http1Protocol<TcpTransport>>>);
+static_assert(!ConcurrentGetClient<HttpClient<Http1Protocol<TcpTransport>>>);
+
+namespace {
+
+    // Throws from its first get_safe() and answers every later one.
+    class ThrowOnceClient {
+    public:
+        static constexpr bool concurrent_get_safe = true;
+
+        auto get_safe(HttpRequest&) -> std::expected<SafeHttpResponse, Error> {
+            if (calls_++ == 0) {
+                throw std::bad_alloc();
+            }
+            SafeHttpResponse response{};
+            response.status_code = 200;
+            return response;
+        }
+
+    private:
+        std::atomic<int> calls_{0};
+    };
+
+} // namespace
+
+TEST(CoalescingClientTest, ThrowingUpstreamDoesNotLeaveADeadFlight) {
+    ThrowOnceClient upstream;
+    CoalescingClient client(upstream);
+
+    HttpRequest request{};
+    request.path = "/shared";
+    ASSERT_THROW((void)client.get(request), std::bad_alloc);
+
+    auto result = client.get(request);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ((*result)->status_code, 200);
+    ASSERT_EQ(client.stats().upstream, 2u);
+    ASSERT_EQ(client.stats().coalesced, 0u);
+}
+
+TEST(LatencyHistogramTest, PercentilesAreWithinOneBucket) {
+    LatencyHistogram histogram;
+    ASSERT_EQ(histogram.percentile(0.5), 0u);
+    for (uint64_t ns = 1; ns <= 1000; ++ns) {
+        histogram.record(ns * 1000);
+    }
+
+    ASSERT_EQ(histogram.count(), 1000u);
+    ASSERT_EQ(histogram.max(), 1000000u);
+    for (double p : {0.5, 0.9, 0.99}) {
+        const auto exact = static_cast<uint64_t>(p * 1000) * 1000;
+        ASSERT_GE(histogram.percentile(p), exact);
+        ASSERT_LE(histogram.percentile(p), exact + exact / 8);
+    }
+    ASSERT_EQ(histogram.percentile(1.0), 1000000u);
+}
+
+TEST(PriorityHttpClientTest, BulkRequestsUseTheirOwnLane) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica replica(std::chrono::microseconds(0));
+    PriorityHttpClient<Http1Protocol<TcpTransport>> client({.interactive_connections = 2, .bulk_threshold = 1024});
+    ASSERT_TRUE(client.connect("127.0.0.1", replica.port()).has_value());
+
+    const std::vector<std::byte> large(4096, std::byte{'x'});
+    const std::string large_length = std::to_string(large.size());
+    HttpRequest upload{};
+    upload.path = "/upload";
+    upload.body = large;
+    upload.headers = {{"Content-Length", large_length}};
+    ASSERT_EQ(client.classify(upload), Priority::Bulk);
+    ASSERT_TRUE(client.post_safe(upload).has_value());
+
+    HttpRequest small{};
+    small.path = "/small";
+    ASSERT_EQ(client.classify(small), Priority::Interactive);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(client.get_safe(small).has_value());
+    }
+    // An explicit priority overrides the size-based choice.
+    ASSERT_TRUE(client.get_safe(small, Priority::Bulk).has_value());
+
+    ASSERT_EQ(replica.connections(), 3u);
+    ASSERT_EQ(client.lane_stats(Priority::Interactive).requests, 3u);
+    ASSERT_EQ(client.lane_stats(Priority::Bulk).requests, 2u);
+    const auto interactive = client.lane_stats(Priority::Interactive);
+    ASSERT_GT(interactive.p50_ns, 0u);
+    ASSERT_LE(interactive.p50_ns, interactive.p99_ns);
+    ASSERT_LE(interactive.p99_ns, interactive.max_ns);
+
+    ASSERT_TRUE(client.disconnect().has_value());
+}
+
+TEST(PriorityHttpClientTest, BulkLaneIsPaced) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica replica(std::chrono::microseconds(0));
+    // 64 KiB at 1 MiB/s: every bulk upload costs the next one ~62 ms.
+    PriorityHttpClient<Http1Protocol<TcpTransport>> client({.bulk_bytes_per_second = 1024 * 1024});
+    ASSERT_TRUE(client.connect("127.0.0.1", replica.port()).has_value());
+
+    const std::vector<std::byte> large(64 * 1024, std::byte{'x'});
+    const std::string large_length = std::to_string(large.size());
+    HttpRequest upload{};
+    upload.path = "/upload";
+    upload.body = large;
+    upload.headers = {{"Content-Length", large_length}};
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(client.post_safe(upload).has_value());
+    }
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(120));
+
+    // The interactive lane is never paced.
+    HttpRequest small{};
+    small.path = "/small";
+    const auto small_start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(client.get_safe(small).has_value());
+    ASSERT_LT(std::chrono::steady_clock::now() - small_start, std::chrono::milliseconds(50));
+
+    ASSERT_TRUE(client.disconnect().has_value());
+}
+
+TEST(PriorityHttpClientTest, ConcurrentBulkRequestsShareThePace) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica replica(std::chrono::microseconds(0));
+    constexpr int uploads = 4;
+    // 64 KiB at 1 MiB/s on as many connections as uploads: the last may start ~187 ms in.
+    PriorityHttpClient<Http1Protocol<TcpTransport>> client({.bulk_connections = uploads, .bulk_bytes_per_second = 1024 * 1024});
+    ASSERT_TRUE(client.connect("127.0.0.1", replica.port()).has_value());
+
+    const std::vector<std::byte> large(64 * 1024, std::byte{'x'});
+    const std::string large_length = std::to_string(large.size());
+
+    std::atomic<int> succeeded{0};
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < uploads; ++t) {
+        threads.emplace_back([&] {
+            HttpRequest upload{};
+            upload.path = "/upload";
+            upload.body = large;
+            upload.headers = {{"Content-Length", large_length}};
+            if (client.post_safe(upload).has_value()) {
+                succeeded.fetch_add(1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(succeeded.load(), uploads);
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(180));
+
+    ASSERT_TRUE(client.disconnect().has_value());
+}
+
+TEST(BatchingClientTest, SmallBodiesShareOneLengthPrefixedRequest) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica replica(std::chrono::microseconds(0));
+    BatchingClient<Http1Protocol<TcpTransport>> client({.path = "/events", .max_delay = std::chrono::milliseconds(50)});
+    ASSERT_TRUE(client.connect("127.0.0.1", replica.port()).has_value());
+
+    const std::string events[] = {"a", "bb", "ccc"};
+    std::vector<std::future<std::expected<BatchedResponse, Error>>> futures;
+    for (const auto& event : events) {
+        futures.push_back(client.submit(std::as_bytes(std::span(event))));
+    }
+
+    std::vector<BatchedResponse> responses;
+    for (auto& future : futures) {
+        auto result = future.get();
+        ASSERT_TRUE(result.has_value());
+        responses.push_back(*result);
+    }
+    for (size_t i = 0; i < responses.size(); ++i) {
+        ASSERT_EQ(responses[i].index, i);
+        ASSERT_EQ(responses[i].batch_size, 3u);
+        ASSERT_EQ(responses[i].response, responses[0].response);
+        ASSERT_EQ(responses[i].response->status_code, 200);
+    }
+
+    ASSERT_EQ(replica.paths(), (std::vector<std::string>{"/events"}));
+    ASSERT_EQ(replica.bodies(), (std::vector<std::string>{std::string("\0\0\0\1a\0\0\0\2bb\0\0\0\3ccc", 18)}));
+    ASSERT_EQ(client.stats().submitted, 3u);
+    ASSERT_EQ(client.stats().batches, 1u);
+
+    ASSERT_TRUE(client.disconnect().has_value());
+}
+
+TEST(BatchingClientTest, RejectsBodiesTooLongForTheLengthPrefix) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica replica(std::chrono::microseconds(0));
+    BatchingClient<Http1Protocol<TcpTransport>> client({.path = "/events"});
+    ASSERT_TRUE(client.connect("127.0.0.1", replica.port()).has_value());
+
+    // Address space for the body, never touched: it is rejected before anything reads it.
+    const size_t size = size_t{std::numeric_limits<uint32_t>::max()} + 1;
+    void* reserved = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    ASSERT_NE(reserved, MAP_FAILED);
+    auto result = client.submit(std::span(static_cast<const std::byte*>(reserved), size)).get();
+    munmap(reserved, size);
+
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(std::get<HttpClientError>(result.error()), HttpClientError::InvalidRequest);
+    ASSERT_EQ(client.stats().submitted, 0u);
+    ASSERT_TRUE(client.disconnect().has_value());
+    ASSERT_TRUE(replica.paths().empty());
+}
+
+TEST(BatchingClientTest, NdjsonBatchesAreCappedAndFlushedOnDisconnect) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica replica(std::chrono::microseconds(0));
+    BatchingClient<Http1Protocol<TcpTransport>> client(
+        {.framing = BatchFraming::Ndjson, .max_items = 2, .max_delay = std::chrono::seconds(10)});
+    ASSERT_TRUE(client.connect("127.0.0.1", replica.port()).has_value());
+
+    const std::string events[] = {R"({"n":1})", R"({"n":2})", R"({"n":3})"};
+    std::vector<std::future<std::expected<BatchedResponse, Error>>> futures;
+    for (const auto& event : events) {
+        futures.push_back(client.submit(std::as_bytes(std::span(event))));
+    }
+    // A full batch goes out without waiting for the delay.
+    ASSERT_TRUE(futures[0].get().has_value());
+
+    const std::string multi_line = "{}\n{}";
+    ASSERT_FALSE(client.submit(std::as_bytes(std::span(multi_line))).get().has_value());
+
+    // The third body is still pending; disconnecting sends it instead of dropping it.
+    ASSERT_TRUE(client.disconnect().has_value());
+    auto last = futures[2].get();
+    ASSERT_TRUE(last.has_value());
+    ASSERT_EQ(last->batch_size, 1u);
+
+    ASSERT_EQ(replica.bodies(), (std::vector<std::string>{"{\"n\":1}\n{\"n\":2}\n", "{\"n\":3}\n"}));
+    ASSERT_EQ(client.stats().batches, 2u);
+}
+
+TEST(HttpClientUrlTest, ReusesConnectionWhileAuthorityMatches) {
+    signal(SIGPIPE, SIG_IGN);
+    BalancerReplica first(std::chrono::microseconds(0));
+    BalancerReplica second(std::chrono::microseconds(0));
+    const std::string first_base = "http://127.0.0.1:" + std::to_string(first.port());
+    const std::string second_base = "http://127.0.0.1:" + std::to_string(second.port());
+
+    HttpClient<Http1Protocol<TcpTransport>> client;
+    auto response = client.get(first_base + "/a");
+    ASSERT_TRUE(response.has_value());
+    ASSERT_EQ(response->status_code, 200);
+    ASSERT_TRUE(client.get(first_base + "/b?x=1#ignored").has_value());
+
+    const std::string body = "payload";
+    const std::string body_length = std::to_string(body.size());
+    HttpRequest post{};
+    post.body = std::as_bytes(std::span(body));
+    post.headers = {{"Content-Length", body_length}};
+    ASSERT_TRUE(client.post(second_base + "/c", post).has_value());
+    // The request is left untouched, so reusing it with another URL sends that URL's Host.
+    ASSERT_TRUE(post.path.empty());
+    ASSERT_EQ(post.headers.size(), 1u);
+    ASSERT_TRUE(client.post(first_base + "/d", post).has_value());
+
+    const std::string first_host = "127.0.0.1:" + std::to_string(first.port());
+    const std::string second_host = "127.0.0.1:" + std::to_string(second.port());
+    ASSERT_EQ(first.paths(), (std::vector<std::string>{"/a", "/b?x=1", "/d"}));
+    ASSERT_EQ(first.hosts(), (std::vector<std::string>{first_host, first_host, first_host}));
+    ASSERT_EQ(first.connections(), 2u);
+    ASSERT_EQ(second.paths(), (std::vector<std::string>{"/c"}));
+    ASSERT_EQ(second.hosts(), (std::vector<std::string>{second_host}));
+    ASSERT_EQ(second.bodies(), (std::vector<std::string>{"payload"}));
+
+    auto bad = client.get("not a url");
+    ASSERT_FALSE(bad.has_value());
+    ASSERT_EQ(std::get<HttpClientError>(bad.error()), HttpClientError::UrlParseFailure);
+    auto scheme_only = client.get("http");
+    ASSERT_FALSE(scheme_only.has_value());
+    ASSERT_EQ(std::get<HttpClientError>(scheme_only.error()), HttpClientError::UrlParseFailure);
+    ASSERT_FALSE(client.get("https://127.0.0.1/").has_value());
+
+    ASSERT_TRUE(client.disconnect().has_value());
+}
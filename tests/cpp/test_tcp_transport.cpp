@@ -160,6 +160,50 @@ TEST_F(TcpTransportTest, ReadSucceeds) {
     ASSERT_EQ(received_message, message_from_server);
 }
 
+TEST_F(TcpTransportTest, ReadExactWaitsForWholeBuffer) {
+    StartServer([](int client_fd){
+        write(client_fd, "hello ", 6);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        write(client_fd, "from server", 11);
+    });
+
+    ASSERT_TRUE(transport_.connect("127.0.0.1", port_).has_value());
+
+    std::vector<std::byte> read_buffer(17);
+    auto read_result = transport_.read_exact(read_buffer);
+
+    ASSERT_TRUE(read_result.has_value());
+    ASSERT_EQ(*read_result, read_buffer.size());
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(read_buffer.data()), read_buffer.size()), "hello from server");
+}
+
+TEST_F(TcpTransportTest, WriteVectoredSendsEveryBuffer) {
+    server_read_promise_ = std::promise<void>();
+    auto server_read_future = server_read_promise_.get_future();
+
+    StartServer([this](int client_fd){
+        std::vector<char> buffer(1024, 0);
+        ssize_t bytes_read;
+        while (captured_message_.size() < 17 && (bytes_read = read(client_fd, buffer.data(), buffer.size())) > 0) {
+            captured_message_.append(buffer.data(), bytes_read);
+        }
+        server_read_promise_.set_value();
+    });
+
+    ASSERT_TRUE(transport_.connect("127.0.0.1", port_).has_value());
+
+    const std::string first = "hello ", empty, second = "from ", third = "client";
+    const std::span<const std::byte> parts[] = {
+        std::as_bytes(std::span(first)), std::as_bytes(std::span(empty)),
+        std::as_bytes(std::span(second)), std::as_bytes(std::span(third))};
+    auto write_result = transport_.write_vectored(parts);
+
+    ASSERT_TRUE(write_result.has_value());
+    ASSERT_EQ(*write_result, 17u);
+    server_read_future.wait();
+    ASSERT_EQ(captured_message_, "hello from client");
+}
+
 TEST_F(TcpTransportTest, CloseSucceeds) {
     StartServer([](int client_fd){
         (void)client_fd;
@@ -259,4 +303,35 @@ TEST_F(TcpTransportTest, ReadFailsOnPeerShutdown) {
 
     ASSERT_FALSE(read_result.has_value());
     ASSERT_EQ(read_result.error(), httpcpp::TransportError::ConnectionClosed);
-}
\ No newline at end of file
+}
+
+TEST_F(TcpTransportTest, FastOpenConnectDeliversFirstWrite) {
+    server_read_promise_ = std::promise<void>();
+    auto server_read_future = server_read_promise_.get_future();
+
+    StartServer([this](int client_fd){
+        std::vector<char> buffer(1024, 0);
+        ssize_t bytes_read = read(client_fd, buffer.data(), buffer.size() - 1);
+        if (bytes_read > 0) {
+            captured_message_.assign(buffer.data(), bytes_read);
+        }
+        server_read_promise_.set_value();
+    });
+
+    // Works whether or not the kernel or the listener support Fast Open; only the SYN differs.
+    transport_.set_fast_open(true);
+    auto connect_result = transport_.connect("127.0.0.1", port_);
+    ASSERT_TRUE(connect_result.has_value());
+
+    const std::string message_to_send = "GET / HTTP/1.1\r\n\r\n";
+    std::span<const std::byte> write_buffer(
+        reinterpret_cast<const std::byte*>(message_to_send.data()),
+        message_to_send.size()
+    );
+    auto write_result = transport_.write(write_buffer);
+    ASSERT_TRUE(write_result.has_value());
+
+    server_read_future.wait();
+
+    ASSERT_EQ(captured_message_, message_to_send);
+}
@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+#include <httpcpp/httpcpp.hpp>
+#include <httpcpp/tcp_transport.hpp>
+#include <httpcpp/tls_transport.hpp>
+
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using TlsTcpTransport = httpcpp::TlsTransport<httpcpp::TcpTransport>;
+
+static_assert(httpcpp::SecureTransport<TlsTcpTransport>);
+static_assert(httpcpp::VectoredWriteTransport<TlsTcpTransport>);
+
+// A TLS server on the loopback interface with a freshly generated self-signed certificate for
+// 127.0.0.1 and localhost. Connections are accepted one after another and handed, once the
+// handshake is done, to the test's server logic.
+class TlsTransportTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        key_ = EVP_EC_gen("P-256");
+        cert_ = X509_new();
+        X509_set_version(cert_, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(cert_), 1);
+        X509_gmtime_adj(X509_getm_notBefore(cert_), 0);
+        X509_gmtime_adj(X509_getm_notAfter(cert_), 3600);
+        X509_set_pubkey(cert_, key_);
+        X509_NAME* name = X509_get_subject_name(cert_);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+        X509_set_issuer_name(cert_, name);
+        X509V3_CTX v3;
+        X509V3_set_ctx_nodb(&v3);
+        X509V3_set_ctx(&v3, cert_, cert_, nullptr, nullptr, 0);
+        X509_EXTENSION* san = X509V3_EXT_conf_nid(nullptr, &v3, NID_subject_alt_name, "IP:127.0.0.1,DNS:localhost");
+        X509_add_ext(cert_, san, -1);
+        X509_EXTENSION_free(san);
+        X509_sign(cert_, key_, EVP_sha256());
+
+        ca_file_ = (std::filesystem::temp_directory_path() / ("httpcpp_tls_test_" + std::to_string(getpid()) + ".pem")).string();
+        FILE* file = std::fopen(ca_file_.c_str(), "w");
+        PEM_write_X509(file, cert_);
+        std::fclose(file);
+    }
+
+    static void TearDownTestSuite() {
+        std::remove(ca_file_.c_str());
+        X509_free(cert_);
+        EVP_PKEY_free(key_);
+    }
+
+    void SetUp() override {
+        signal(SIGPIPE, SIG_IGN);
+        auto context = httpcpp::TlsContext::create({.ca_file = ca_file_});
+        ASSERT_TRUE(context.has_value());
+        context_ = *context;
+    }
+
+    void TearDown() override {
+        StopServer();
+    }
+
+    void StartServer(std::function<void(SSL*)> server_logic, int connections = 1) {
+        server_logic_ = std::move(server_logic);
+        server_ctx_ = SSL_CTX_new(TLS_server_method());
+        ASSERT_EQ(SSL_CTX_use_certificate(server_ctx_, cert_), 1);
+        ASSERT_EQ(SSL_CTX_use_PrivateKey(server_ctx_, key_), 1);
+
+        listener_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_NE(listener_fd_, -1);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ASSERT_EQ(bind(listener_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+        socklen_t len = sizeof(addr);
+        ASSERT_EQ(getsockname(listener_fd_, reinterpret_cast<sockaddr*>(&addr), &len), 0);
+        port_ = ntohs(addr.sin_port);
+        ASSERT_EQ(listen(listener_fd_, connections), 0);
+
+        server_thread_ = std::thread([this, connections] {
+            for (int i = 0; i < connections; ++i) {
+                const int fd = accept(listener_fd_, nullptr, nullptr);
+                if (fd < 0) {
+                    return;
+                }
+                SSL* ssl = SSL_new(server_ctx_);
+                SSL_set_fd(ssl, fd);
+                if (SSL_accept(ssl) == 1) {
+                    server_logic_(ssl);
+                    SSL_shutdown(ssl);
+                }
+                SSL_free(ssl);
+                close(fd);
+            }
+        });
+    }
+
+    void StopServer() {
+        if (listener_fd_ != -1) {
+            shutdown(listener_fd_, SHUT_RDWR);
+        }
+        if (server_thread_.joinable()) {
+            server_thread_.join();
+        }
+        if (listener_fd_ != -1) {
+            close(listener_fd_);
+            listener_fd_ = -1;
+        }
+        SSL_CTX_free(server_ctx_);
+        server_ctx_ = nullptr;
+    }
+
+    // Reads until `size` bytes have arrived or the client is gone.
+    static auto ReadString(SSL* ssl, size_t size) -> std::string {
+        std::string received(size, '\0');
+        size_t total = 0;
+        size_t n = 0;
+        while (total < size && SSL_read_ex(ssl, received.data() + total, size - total, &n) == 1) {
+            total += n;
+        }
+        received.resize(total);
+        return received;
+    }
+
+    static auto Bytes(std::string_view text) -> std::span<const std::byte> {
+        return std::as_bytes(std::span(text));
+    }
+
+    auto RoundTrip(TlsTcpTransport& transport, std::string_view message) -> std::string {
+        EXPECT_TRUE(transport.write(Bytes(message)).has_value());
+        std::vector<std::byte> buffer(message.size());
+        size_t total = 0;
+        while (total < buffer.size()) {
+            auto n = transport.read(std::span(buffer).subspan(total));
+            if (!n) {
+                break;
+            }
+            total += *n;
+        }
+        return std::string(reinterpret_cast<const char*>(buffer.data()), total);
+    }
+
+    static inline EVP_PKEY* key_ = nullptr;
+    static inline X509* cert_ = nullptr;
+    static inline std::string ca_file_;
+
+    std::shared_ptr<httpcpp::TlsContext> context_;
+    SSL_CTX* server_ctx_ = nullptr;
+    int listener_fd_ = -1;
+    uint16_t port_ = 0;
+    std::thread server_thread_;
+    std::function<void(SSL*)> server_logic_;
+};
+
+static void Echo(SSL* ssl, size_t size) {
+    size_t n = 0;
+    std::string received(size, '\0');
+    size_t total = 0;
+    while (total < size && SSL_read_ex(ssl, received.data() + total, size - total, &n) == 1) {
+        total += n;
+    }
+    SSL_write_ex(ssl, received.data(), total, &n);
+}
+
+TEST_F(TlsTransportTest, RoundTripsOverVerifiedConnection) {
+    StartServer([](SSL* ssl) { Echo(ssl, 5); });
+
+    TlsTcpTransport transport;
+    transport.set_context(context_);
+    ASSERT_TRUE(transport.connect("127.0.0.1", port_).has_value());
+    ASSERT_EQ(RoundTrip(transport, "hello"), "hello");
+    ASSERT_FALSE(transport.session_reused());
+    ASSERT_TRUE(transport.close().has_value());
+}
+
+TEST_F(TlsTransportTest, ResumesSessionOnReconnect) {
+    StartServer([](SSL* ssl) { Echo(ssl, 5); }, 2);
+
+    TlsTcpTransport transport;
+    transport.set_context(context_);
+    ASSERT_TRUE(transport.connect("127.0.0.1", port_).has_value());
+    // The server's ticket arrives after the handshake and is picked up by the first read.
+    ASSERT_EQ(RoundTrip(transport, "first"), "first");
+    ASSERT_FALSE(transport.session_reused());
+    ASSERT_TRUE(transport.close().has_value());
+
+    ASSERT_TRUE(transport.connect("127.0.0.1", port_).has_value());
+    ASSERT_TRUE(transport.session_reused());
+    ASSERT_EQ(RoundTrip(transport, "again"), "again");
+}
+
+TEST_F(TlsTransportTest, RejectsUntrustedCertificate) {
+    StartServer([](SSL*) {});
+
+    auto system_store = httpcpp::TlsContext::create();
+    ASSERT_TRUE(system_store.has_value());
+    TlsTcpTransport transport;
+    transport.set_context(*system_store);
+    auto result = transport.connect("127.0.0.1", port_);
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(result.error(), httpcpp::TransportError::TlsHandshakeFailure);
+}
+
+TEST_F(TlsTransportTest, WriteVectoredSendsEveryBuffer) {
+    // Small parts share records; the large one exceeds a record and goes out on its own.
+    const std::string head = "head:", empty, large(40000, 'x'), tail = ":tail";
+    const size_t total = head.size() + large.size() + tail.size();
+    std::string captured;
+    StartServer([&](SSL* ssl) { captured = ReadString(ssl, total); });
+
+    TlsTcpTransport transport;
+    transport.set_context(context_);
+    ASSERT_TRUE(transport.connect("127.0.0.1", port_).has_value());
+    const std::span<const std::byte> parts[] = {Bytes(head), Bytes(empty), Bytes(large), Bytes(tail)};
+    auto written = transport.write_vectored(parts);
+    ASSERT_TRUE(written.has_value());
+    ASSERT_EQ(*written, total);
+    ASSERT_TRUE(transport.close().has_value());
+
+    StopServer();
+    ASSERT_EQ(captured, head + large + tail);
+}
+
+TEST_F(TlsTransportTest, HttpClientFetchesHttpsUrl) {
+    StartServer([](SSL* ssl) {
+        std::string request;
+        char c;
+        size_t n = 0;
+        while (!request.ends_with("\r\n\r\n") && SSL_read_ex(ssl, &c, 1, &n) == 1) {
+            request += c;
+        }
+        const std::string response = request.starts_with("GET /secure?x=1 HTTP/1.1\r\n")
+            ? "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok"
+            : "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n";
+        SSL_write_ex(ssl, response.data(), response.size(), &n);
+    });
+
+    httpcpp::HttpClient<httpcpp::Http1Protocol<TlsTcpTransport>> client;
+    client.protocol().transport().set_context(context_);
+    ASSERT_FALSE(client.get("http://127.0.0.1:" + std::to_string(port_) + "/secure").has_value());
+
+    auto response = client.get("https://127.0.0.1:" + std::to_string(port_) + "/secure?x=1");
+    ASSERT_TRUE(response.has_value());
+    ASSERT_EQ(response->status_code, 200);
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(response->body.data()), response->body.size()), "ok");
+}